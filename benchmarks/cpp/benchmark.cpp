@@ -0,0 +1,96 @@
+/*
+ * Copyright 2019 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <new>
+
+namespace {
+
+size_t g_allocations = 0;
+size_t g_allocated_bytes = 0;
+
+}  // namespace
+
+// Count every allocation made through the global operator new. The array and
+// sized/nothrow variants all forward to these by default.
+void *operator new(size_t size) {
+  g_allocations++;
+  g_allocated_bytes += size;
+  if (auto p = malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) FLATBUFFERS_NOEXCEPT { free(p); }
+
+namespace flatbenchmarks {
+
+volatile uint64_t benchmark_sink = 0;
+
+std::vector<Benchmark> &Benchmarks() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+AllocationCounters GetAllocationCounters() {
+  AllocationCounters counters = { g_allocations, g_allocated_bytes };
+  return counters;
+}
+
+int RunBenchmarks(const std::string &filter, double min_time_seconds) {
+  typedef std::chrono::steady_clock clock;
+  printf("%-44s %12s %14s %12s %12s\n", "benchmark", "iterations", "ns/op",
+         "bytes/op", "allocs/op");
+  int num_run = 0;
+  for (auto it = Benchmarks().begin(); it != Benchmarks().end(); ++it) {
+    if (!filter.empty() && it->name.find(filter) == std::string::npos) {
+      continue;
+    }
+    size_t iterations = 1;
+    for (;;) {
+      auto before = GetAllocationCounters();
+      auto start = clock::now();
+      it->run(iterations);
+      auto elapsed = std::chrono::duration<double>(clock::now() - start);
+      auto after = GetAllocationCounters();
+      // Grow towards the minimum time, but at most 10x per step, since the
+      // first few runs are typically dominated by warmup.
+      if (elapsed.count() < min_time_seconds && iterations < (1ULL << 40)) {
+        auto estimate = elapsed.count() > 0
+                            ? min_time_seconds * 1.2 / elapsed.count() *
+                                  static_cast<double>(iterations)
+                            : static_cast<double>(iterations) * 10;
+        auto next = static_cast<size_t>(estimate);
+        iterations = (std::max)(iterations + 1,
+                                (std::min)(next, iterations * 10));
+        continue;
+      }
+      auto n = static_cast<double>(iterations);
+      printf("%-44s %12zu %14.1f %12.1f %12.2f\n", it->name.c_str(),
+             iterations, elapsed.count() * 1e9 / n,
+             static_cast<double>(after.bytes - before.bytes) / n,
+             static_cast<double>(after.allocations - before.allocations) / n);
+      fflush(stdout);
+      break;
+    }
+    num_run++;
+  }
+  return num_run;
+}
+
+}  // namespace flatbenchmarks
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2019 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_BENCHMARK_H_
+#define FLATBUFFERS_BENCHMARK_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "flatbuffers/base.h"
+
+// A minimal, dependency free benchmark harness for the C++ runtime.
+// Each benchmark is a function that performs its operation `iterations` times.
+// The harness grows the iteration count until a run takes at least the
+// minimum time, and reports the time, heap bytes and heap allocations per
+// operation of that final run. Allocations are counted by replacing the
+// global operator new (see benchmark.cpp), so allocations that bypass it
+// (e.g. malloc) are not counted.
+
+namespace flatbenchmarks {
+
+typedef std::function<void(size_t iterations)> BenchmarkFunction;
+
+struct Benchmark {
+  std::string name;
+  BenchmarkFunction run;
+};
+
+// Global list of benchmarks, in registration order.
+std::vector<Benchmark> &Benchmarks();
+
+inline void Register(const std::string &name, const BenchmarkFunction &run) {
+  Benchmark benchmark = { name, run };
+  Benchmarks().push_back(benchmark);
+}
+
+// Heap usage since the start of the process.
+struct AllocationCounters {
+  size_t allocations;
+  size_t bytes;
+};
+AllocationCounters GetAllocationCounters();
+
+// Keeps the compiler from optimizing away a computed value.
+extern volatile uint64_t benchmark_sink;
+template<typename T> inline void DoNotOptimize(T value) {
+  benchmark_sink = benchmark_sink + static_cast<uint64_t>(value);
+}
+template<typename T> inline void DoNotOptimize(T *value) {
+  benchmark_sink =
+      benchmark_sink + static_cast<uint64_t>(reinterpret_cast<size_t>(value));
+}
+
+// Runs all benchmarks whose name contains `filter` (all if empty), printing
+// one line per benchmark. Returns the number of benchmarks run.
+int RunBenchmarks(const std::string &filter, double min_time_seconds);
+
+}  // namespace flatbenchmarks
+
+#endif  // FLATBUFFERS_BENCHMARK_H_
@@ -0,0 +1,940 @@
+/*
+ * Copyright 2019 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmarks for the C++ runtime, built on the test schemas.
+// Run from the root of the repository, so the schemas in tests/ can be found:
+//   flatbenchmarks [--min_time=<seconds>] [name filter]
+// Build with optimization (e.g. -DCMAKE_BUILD_TYPE=Release) for meaningful
+// numbers.
+
+#include "benchmark.h"
+
+#include <thread>
+
+#include "flatbuffers/arena.h"
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/flexbuffers.h"
+#include "flatbuffers/idl.h"
+#include "flatbuffers/json_printer.h"
+#include "flatbuffers/reflection.h"
+#include "flatbuffers/registry.h"
+#include "flatbuffers/util.h"
+
+#include "arrays_test_generated.h"
+#include "monster_test_generated.h"
+#include "native_arena_test_generated.h"
+
+using namespace MyGame::Example;
+using flatbenchmarks::DoNotOptimize;
+using flatbenchmarks::Register;
+
+namespace {
+
+const std::string test_data_path = "tests/";
+const std::string include_test_path =
+    flatbuffers::ConCatPathFileName(test_data_path, "include_test");
+
+// Builds a Monster with every kind of field set: scalars, structs, strings,
+// vectors of scalars/structs/strings/tables, a union, a nested FlatBuffer and
+// a FlexBuffer.
+flatbuffers::Offset<Monster> BuildMonster(
+    flatbuffers::FlatBufferBuilder &fbb, const std::vector<uint8_t> &nested,
+    const std::vector<uint8_t> &flex) {
+  auto name = fbb.CreateString("MyMonster");
+  uint8_t inv_data[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  auto inventory = fbb.CreateVector(inv_data, 10);
+  Test tests[] = { Test(10, 20), Test(30, 40) };
+  auto test4 = fbb.CreateVectorOfStructs(tests, 2);
+  flatbuffers::Offset<Monster> mlocs[3];
+  static const char *names[] = { "Barney", "Fred", "Wilma" };
+  for (int i = 0; i < 3; i++) {
+    mlocs[i] = CreateMonster(fbb, nullptr, 0, static_cast<int16_t>(i * 100),
+                             fbb.CreateString(names[i]));
+  }
+  auto tables = fbb.CreateVector(mlocs, 3);
+  std::vector<std::string> strings;
+  strings.push_back("bob");
+  strings.push_back("fred");
+  strings.push_back("jane");
+  strings.push_back("mary");
+  auto vecofstrings = fbb.CreateVectorOfStrings(strings);
+  Ability abilities[] = { Ability(1, 10), Ability(2, 20), Ability(3, 30) };
+  auto vecofstructs = fbb.CreateVectorOfStructs(abilities, 3);
+  int64_t longs[] = { 1, 100, 10000, 1000000, 100000000 };
+  auto vecoflongs = fbb.CreateVector(longs, 5);
+  double doubles[] = { -1.7976931348623157e+308, 0, 1.7976931348623157e+308 };
+  auto vecofdoubles = fbb.CreateVector(doubles, 3);
+  fbb.ForceVectorAlignment(
+      nested.size(), sizeof(uint8_t),
+      flatbuffers::AlignOf<flatbuffers::largest_scalar_t>());
+  auto nested_vec = fbb.CreateVector(nested);
+  auto flex_vec = fbb.CreateVector(flex);
+  Vec3 pos(1, 2, 3, 0, Color_Red, Test(10, 20));
+  return CreateMonster(fbb, &pos, 150, 80, name, inventory, Color_Blue,
+                       Any_Monster, mlocs[1].Union(), test4, vecofstrings,
+                       tables, 0, nested_vec, 0, true, 0, 0, 0, 0, 0, 0, 0, 0,
+                       0, 3.14159f, 3.0f, 0.0f, 0, vecofstructs, flex_vec,
+                       test4, vecoflongs, vecofdoubles);
+}
+
+std::vector<uint8_t> BuildMonsterBuffer() {
+  flatbuffers::FlatBufferBuilder nested_fbb;
+  FinishMonsterBuffer(nested_fbb,
+                      CreateMonster(nested_fbb, nullptr, 0, 0,
+                                    nested_fbb.CreateString("Nested")));
+  std::vector<uint8_t> nested(
+      nested_fbb.GetBufferPointer(),
+      nested_fbb.GetBufferPointer() + nested_fbb.GetSize());
+  flexbuffers::Builder flex_builder;
+  flex_builder.Map([&]() {
+    flex_builder.Int("id", 1234);
+    flex_builder.String("name", "flex");
+  });
+  flex_builder.Finish();
+  flatbuffers::FlatBufferBuilder fbb;
+  FinishMonsterBuffer(fbb, BuildMonster(fbb, nested, flex_builder.GetBuffer()));
+  return std::vector<uint8_t>(fbb.GetBufferPointer(),
+                              fbb.GetBufferPointer() + fbb.GetSize());
+}
+
+uint64_t ReadMonster(const Monster *monster) {
+  uint64_t sum = 0;
+  auto pos = monster->pos();
+  sum += static_cast<uint64_t>(pos->x() + pos->y() + pos->z() + pos->test1());
+  sum += pos->test2() + pos->test3().a() + pos->test3().b();
+  sum += monster->mana() + monster->hp() + monster->color();
+  sum += monster->name()->size();
+  for (auto it = monster->inventory()->begin();
+       it != monster->inventory()->end(); ++it) {
+    sum += *it;
+  }
+  if (monster->test_type() == Any_Monster) {
+    sum += monster->test_as_Monster()->name()->size();
+  }
+  for (auto it = monster->test4()->begin(); it != monster->test4()->end();
+       ++it) {
+    sum += it->a() + it->b();
+  }
+  for (auto it = monster->testarrayofstring()->begin();
+       it != monster->testarrayofstring()->end(); ++it) {
+    sum += it->size();
+  }
+  for (auto it = monster->testarrayoftables()->begin();
+       it != monster->testarrayoftables()->end(); ++it) {
+    sum += it->hp() + it->name()->size();
+  }
+  for (auto it = monster->testarrayofsortedstruct()->begin();
+       it != monster->testarrayofsortedstruct()->end(); ++it) {
+    sum += it->id() + it->distance();
+  }
+  for (auto it = monster->vector_of_longs()->begin();
+       it != monster->vector_of_longs()->end(); ++it) {
+    sum += static_cast<uint64_t>(*it);
+  }
+  for (auto it = monster->vector_of_doubles()->begin();
+       it != monster->vector_of_doubles()->end(); ++it) {
+    sum += *it > 0;
+  }
+  sum += monster->testnestedflatbuffer_nested_root()->name()->size();
+  sum += static_cast<uint64_t>(
+      monster->flex_flexbuffer_root().AsMap()["id"].AsInt64());
+  sum += monster->testbool();
+  sum += static_cast<uint64_t>(monster->testf() + monster->testf2() +
+                               monster->testf3());
+  return sum;
+}
+
+// Builds a buffer of `num_tables` tables, cycling through `num_layouts`
+// distinct vtables, to measure vtable deduplication.
+void BuildManyLayouts(flatbuffers::FlatBufferBuilder &fbb, int num_tables,
+                      int num_layouts) {
+  std::vector<flatbuffers::Offset<void>> tables;
+  tables.reserve(static_cast<size_t>(num_tables));
+  for (int i = 0; i < num_tables; i++) {
+    auto layout = (i % num_layouts) + 1;
+    auto start = fbb.StartTable();
+    for (flatbuffers::voffset_t field = 0; field < 16; field++) {
+      if (layout & (1 << field)) {
+        fbb.AddElement<uint8_t>(flatbuffers::FieldIndexToOffset(field), 1, 0);
+      }
+    }
+    tables.push_back(fbb.EndTable(start));
+  }
+  fbb.Finish(fbb.CreateVector(tables));
+}
+
+bool LoadParser(flatbuffers::Parser &parser, const std::string &schema_file) {
+  std::string schema;
+  if (!flatbuffers::LoadFile((test_data_path + schema_file).c_str(), false,
+                             &schema)) {
+    return false;
+  }
+  const char *include_directories[] = { test_data_path.c_str(),
+                                        include_test_path.c_str(), nullptr };
+  return parser.Parse(schema.c_str(), include_directories);
+}
+
+void RegisterBuilderBenchmarks(const std::vector<uint8_t> &monster) {
+  auto nested = std::make_shared<std::vector<uint8_t>>(monster);
+  auto flex = std::make_shared<std::vector<uint8_t>>();
+  {
+    flexbuffers::Builder flex_builder;
+    flex_builder.Map([&]() { flex_builder.Int("id", 1234); });
+    flex_builder.Finish();
+    *flex = flex_builder.GetBuffer();
+  }
+
+  Register("Build/Monster", [=](size_t iterations) {
+    flatbuffers::FlatBufferBuilder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      FinishMonsterBuffer(fbb, BuildMonster(fbb, *nested, *flex));
+      DoNotOptimize(fbb.GetSize());
+    }
+  });
+
+  Register("Build/MonsterNewBuilder", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::FlatBufferBuilder fbb;
+      FinishMonsterBuffer(fbb, BuildMonster(fbb, *nested, *flex));
+      DoNotOptimize(fbb.GetSize());
+    }
+  });
+
+  // Same, but releasing each buffer back into a thread local arena.
+  Register("Build/MonsterArena", [=](size_t iterations) {
+    auto &arena = flatbuffers::ArenaAllocator::ThreadLocal();
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::FlatBufferBuilder fbb(arena.GetSizeHint(), &arena);
+      FinishMonsterBuffer(fbb, BuildMonster(fbb, *nested, *flex));
+      DoNotOptimize(fbb.Release().size());
+    }
+  });
+
+  Register("Build/ArrayTable", [](size_t iterations) {
+    flatbuffers::FlatBufferBuilder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      ArrayStruct array_struct(1.5f, 2);
+      for (int j = 0; j < array_struct.b()->size(); j++) {
+        array_struct.mutable_b()->Mutate(j, j);
+      }
+      FinishArrayTableBuffer(fbb, CreateArrayTable(fbb, &array_struct));
+      DoNotOptimize(fbb.GetSize());
+    }
+  });
+
+  Register("Build/SharedStrings", [](size_t iterations) {
+    std::vector<std::string> strings;
+    for (int i = 0; i < 1000; i++) {
+      strings.push_back("tag" + flatbuffers::NumToString(i % 100));
+    }
+    flatbuffers::FlatBufferBuilder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      for (auto it = strings.begin(); it != strings.end(); ++it) {
+        DoNotOptimize(fbb.CreateSharedString(*it).o);
+      }
+    }
+  });
+
+  // A 1MB blob copied into the buffer vs. referenced by a segment, ready to be
+  // written out with writev().
+  auto blob = std::make_shared<std::vector<uint8_t>>(1 << 20, 42);
+  for (int external = 0; external < 2; external++) {
+    Register(std::string("Build/Blob/") + (external ? "external" : "copied"),
+             [=](size_t iterations) {
+               flatbuffers::FlatBufferBuilder fbb;
+               std::vector<flatbuffers::BufferSegment> segments;
+               for (size_t i = 0; i < iterations; i++) {
+                 fbb.Clear();
+                 auto vec = external ? fbb.CreateExternalVector(
+                                           blob->data(), blob->size())
+                                     : fbb.CreateVector(*blob);
+                 fbb.Finish(vec);
+                 fbb.GetBufferSegments(&segments);
+                 DoNotOptimize(segments.size());
+               }
+             });
+  }
+
+  // Vtable deduplication with a linear scan vs. the hash index, for a
+  // growing number of distinct table layouts, to show the crossover point.
+  static const int layouts[] = { 4, 16, 64, 256, 1024, 4096 };
+  for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++) {
+    for (int indexed = 0; indexed < 2; indexed++) {
+      auto num_layouts = layouts[l];
+      Register(std::string("Build/Vtables/") + (indexed ? "index" : "scan") +
+                   "/layouts:" + flatbuffers::NumToString(num_layouts),
+               [=](size_t iterations) {
+                 flatbuffers::FlatBufferBuilder fbb;
+                 fbb.IndexVtables(indexed != 0);
+                 for (size_t i = 0; i < iterations; i++) {
+                   fbb.Clear();
+                   BuildManyLayouts(fbb, 4096, num_layouts);
+                   DoNotOptimize(fbb.GetSize());
+                 }
+               });
+    }
+  }
+}
+
+void RegisterReaderBenchmarks(const std::vector<uint8_t> &monster) {
+  auto buf = std::make_shared<std::vector<uint8_t>>(monster);
+
+  Register("Verify/Monster", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::Verifier verifier(buf->data(), buf->size());
+      DoNotOptimize(VerifyMonsterBuffer(verifier));
+    }
+  });
+
+  Register("Verify/ArrayTable", [](size_t iterations) {
+    flatbuffers::FlatBufferBuilder fbb;
+    ArrayStruct array_struct(1.5f, 2);
+    FinishArrayTableBuffer(fbb, CreateArrayTable(fbb, &array_struct));
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+      DoNotOptimize(VerifyArrayTableBuffer(verifier));
+    }
+  });
+
+  Register("Verify/VectorOfStrings", [](size_t iterations) {
+    flatbuffers::FlatBufferBuilder fbb;
+    std::vector<std::string> strings;
+    for (int i = 0; i < 10000; i++) {
+      strings.push_back("string" + flatbuffers::NumToString(i));
+    }
+    auto name = fbb.CreateString("strings");
+    auto vec = fbb.CreateVectorOfStrings(strings);
+    MonsterBuilder mb(fbb);
+    mb.add_name(name);
+    mb.add_testarrayofstring(vec);
+    FinishMonsterBuffer(fbb, mb.Finish());
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+      DoNotOptimize(VerifyMonsterBuffer(verifier));
+    }
+  });
+
+  // A large vector of tables verified serially vs. split across 4 threads.
+  auto tables = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  {
+    auto &fbb = *tables;
+    std::vector<flatbuffers::Offset<Monster>> monsters;
+    for (int i = 0; i < 100000; i++) {
+      auto name = fbb.CreateString(flatbuffers::NumToString(i));
+      auto inventory = fbb.CreateVector(std::vector<uint8_t>(i % 16, 1));
+      monsters.push_back(CreateMonster(fbb, 0, 0, 0, name, inventory));
+    }
+    auto name = fbb.CreateString("tables");
+    auto vec = fbb.CreateVector(monsters);
+    MonsterBuilder mb(fbb);
+    mb.add_name(name);
+    mb.add_testarrayoftables(vec);
+    FinishMonsterBuffer(fbb, mb.Finish());
+  }
+  for (int parallel = 0; parallel < 2; parallel++) {
+    Register(std::string("Verify/VectorOfTables/") +
+                 (parallel ? "parallel" : "serial"),
+             [=](size_t iterations) {
+               auto parallel_for = [](size_t num_tasks,
+                                      const std::function<void(size_t)> &task) {
+                 const size_t num_threads = 4;
+                 std::vector<std::thread> threads;
+                 for (size_t t = 0; t < num_threads; t++) {
+                   threads.push_back(std::thread([=, &task]() {
+                     for (auto i = t; i < num_tasks; i += num_threads) task(i);
+                   }));
+                 }
+                 for (auto it = threads.begin(); it != threads.end(); ++it) {
+                   it->join();
+                 }
+               };
+               for (size_t i = 0; i < iterations; i++) {
+                 flatbuffers::Verifier verifier(tables->GetBufferPointer(),
+                                                tables->GetSize());
+                 if (parallel) verifier.SetParallelFor(parallel_for, 10000);
+                 DoNotOptimize(VerifyMonsterBuffer(verifier));
+               }
+             });
+  }
+
+  // Verifying just the tables that are read, here one out of 100000.
+  Register("Verify/VectorOfTables/lazy", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::Verifier verifier(tables->GetBufferPointer(),
+                                     tables->GetSize());
+      verifier.SetLazy(true);
+      auto ok = VerifyMonsterBuffer(verifier);
+      auto root = GetMonster(tables->GetBufferPointer());
+      DoNotOptimize(ok && verifier.Verified(
+                              root->testarrayoftables()->Get(i % 100000)));
+    }
+  });
+
+  Register("Read/MonsterAllFields", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(ReadMonster(GetMonster(buf->data())));
+    }
+  });
+
+  Register("ObjectAPI/UnPack", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::unique_ptr<MonsterT> monster_t(
+          GetMonster(buf->data())->UnPack());
+      DoNotOptimize(monster_t.get());
+    }
+  });
+
+  Register("ObjectAPI/UnPackTo/Reuse", [=](size_t iterations) {
+    MonsterT monster_t;
+    for (size_t i = 0; i < iterations; i++) {
+      GetMonster(buf->data())->UnPackTo(&monster_t);
+      DoNotOptimize(&monster_t);
+    }
+  });
+
+  // A Monster with large vectors of scalars and structs.
+  auto large = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  {
+    std::vector<double> doubles(100000);
+    std::vector<Test> tests(100000);
+    for (size_t i = 0; i < doubles.size(); i++) {
+      doubles[i] = static_cast<double>(i) * 0.5;
+      tests[i] = Test(static_cast<int16_t>(i), static_cast<int8_t>(i));
+    }
+    auto name = large->CreateString("large");
+    auto vecofdoubles = large->CreateVector(doubles);
+    auto test4 = large->CreateVectorOfStructs(tests);
+    MonsterBuilder mb(*large);
+    mb.add_name(name);
+    mb.add_vector_of_doubles(vecofdoubles);
+    mb.add_test4(test4);
+    FinishMonsterBuffer(*large, mb.Finish());
+  }
+
+  Register("ObjectAPI/UnPack/LargeVectors", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::unique_ptr<MonsterT> monster_t(
+          GetMonster(large->GetBufferPointer())->UnPack());
+      DoNotOptimize(monster_t.get());
+    }
+  });
+
+  // A tree of many small tables, unpacked on the heap vs. into an arena.
+  auto tree = std::make_shared<flatbuffers::FlatBufferBuilder>();
+  {
+    using namespace NativeArenaTest;
+    NodeT root;
+    root.name = "root";
+    for (int i = 0; i < 100; i++) {
+      root.children.emplace_back(new NodeT());
+      auto &child = *root.children.back();
+      child.name = "a child with a name too long to be stored inline";
+      child.tags.assign(4, "tag");
+      child.position.reset(new Point(1, 2));
+      for (int j = 0; j < 5; j++) {
+        child.leaves.emplace_back(new LeafT());
+        child.leaves.back()->name = "leaf";
+        child.leaves.back()->values.assign(8, j);
+      }
+      child.payload.Set(LeafT());
+    }
+    tree->Finish(Node::Pack(*tree, &root));
+  }
+
+  Register("ObjectAPI/UnPack/Tree", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::unique_ptr<NativeArenaTest::NodeT> node_t(
+          NativeArenaTest::UnPackNode(tree->GetBufferPointer()));
+      DoNotOptimize(node_t.get());
+    }
+  });
+
+  Register("ObjectAPI/UnPack/Tree/Arena", [=](size_t iterations) {
+    flatbuffers::NativeArena arena;
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(
+          NativeArenaTest::UnPackNode(tree->GetBufferPointer(), arena));
+      arena.Reset();
+    }
+  });
+
+  Register("ObjectAPI/Pack", [=](size_t iterations) {
+    flatbuffers::unique_ptr<MonsterT> monster_t(
+        GetMonster(buf->data())->UnPack());
+    flatbuffers::FlatBufferBuilder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      FinishMonsterBuffer(fbb, Monster::Pack(fbb, monster_t.get()));
+      DoNotOptimize(fbb.GetSize());
+    }
+  });
+
+  // Packing into a fresh builder each time, growing it as needed vs.
+  // reserving the size bound up front.
+  Register("ObjectAPI/PackNewBuilder", [=](size_t iterations) {
+    flatbuffers::unique_ptr<MonsterT> monster_t(
+        GetMonster(buf->data())->UnPack());
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::FlatBufferBuilder fbb(64);
+      FinishMonsterBuffer(fbb, Monster::Pack(fbb, monster_t.get()));
+      DoNotOptimize(fbb.GetSize());
+    }
+  });
+
+  Register("ObjectAPI/PackReserved", [=](size_t iterations) {
+    flatbuffers::unique_ptr<MonsterT> monster_t(
+        GetMonster(buf->data())->UnPack());
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::FlatBufferBuilder fbb(64);
+      fbb.Reserve(monster_t->SerializedSizeBound());
+      FinishMonsterBuffer(fbb, Monster::Pack(fbb, monster_t.get()));
+      DoNotOptimize(fbb.GetSize());
+    }
+  });
+}
+
+void RegisterFlexBuffersBenchmarks() {
+  auto keys = std::make_shared<std::vector<std::string>>();
+  for (int i = 0; i < 128; i++) {
+    keys->push_back("key" + flatbuffers::NumToString(i));
+  }
+  auto buf = std::make_shared<std::vector<uint8_t>>();
+  {
+    flexbuffers::Builder fbb;
+    fbb.Map([&]() {
+      for (size_t i = 0; i < keys->size(); i++) {
+        fbb.Int((*keys)[i].c_str(), static_cast<int64_t>(i));
+      }
+    });
+    fbb.Finish();
+    *buf = fbb.GetBuffer();
+  }
+
+  Register("FlexBuffers/BuildMap", [=](size_t iterations) {
+    flexbuffers::Builder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      fbb.Map([&]() {
+        for (size_t k = 0; k < keys->size(); k++) {
+          fbb.Int((*keys)[k].c_str(), static_cast<int64_t>(k));
+        }
+      });
+      fbb.Finish();
+      DoNotOptimize(fbb.GetSize());
+    }
+  });
+
+  // Keys written in order, as from a std::map, don't need sorting.
+  auto sorted_keys = std::make_shared<std::vector<std::string>>(*keys);
+  std::sort(sorted_keys->begin(), sorted_keys->end());
+
+  Register("FlexBuffers/BuildMap/Sorted", [=](size_t iterations) {
+    flexbuffers::Builder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      fbb.Map([&]() {
+        for (size_t k = 0; k < sorted_keys->size(); k++) {
+          fbb.Int((*sorted_keys)[k].c_str(), static_cast<int64_t>(k));
+        }
+      });
+      fbb.Finish();
+      DoNotOptimize(fbb.GetSize());
+    }
+  });
+
+  Register("FlexBuffers/MapLookup", [=](size_t iterations) {
+    auto map = flexbuffers::GetRoot(*buf).AsMap();
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(map[(*keys)[i % keys->size()].c_str()].AsInt64());
+    }
+  });
+
+  // A map with hundreds of keys, with and without a hashed key index.
+  auto big_keys = std::make_shared<std::vector<std::string>>();
+  auto big_hashes = std::make_shared<std::vector<uint32_t>>();
+  for (int i = 0; i < 512; i++) {
+    big_keys->push_back("setting_" + flatbuffers::NumToString(i * 7919));
+    big_hashes->push_back(flexbuffers::HashKey(big_keys->back().c_str()));
+  }
+  std::shared_ptr<std::vector<uint8_t>> big_bufs[2];
+  for (int indexed = 0; indexed < 2; indexed++) {
+    flexbuffers::Builder fbb(
+        256, indexed ? flexbuffers::BUILDER_FLAG_INDEX_MAPS
+                     : flexbuffers::BUILDER_FLAG_NONE);
+    fbb.Map([&]() {
+      for (size_t i = 0; i < big_keys->size(); i++) {
+        fbb.Int((*big_keys)[i].c_str(), static_cast<int64_t>(i));
+      }
+    });
+    fbb.Finish();
+    big_bufs[indexed] =
+        std::make_shared<std::vector<uint8_t>>(fbb.GetBuffer());
+  }
+  auto big_buf = big_bufs[0];
+  auto indexed_buf = big_bufs[1];
+
+  Register("FlexBuffers/MapLookup/512", [=](size_t iterations) {
+    auto map = flexbuffers::GetRoot(*big_buf).AsMap();
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(map[(*big_keys)[i % big_keys->size()].c_str()].AsInt64());
+    }
+  });
+
+  Register("FlexBuffers/MapLookup/512/KeyIndex", [=](size_t iterations) {
+    auto map = flexbuffers::GetRoot(*indexed_buf).AsMap();
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(map[(*big_keys)[i % big_keys->size()].c_str()].AsInt64());
+    }
+  });
+
+  Register("FlexBuffers/MapLookup/512/KeyIndex/Hashed", [=](size_t iterations) {
+    auto map = flexbuffers::GetRoot(*indexed_buf).AsMap();
+    for (size_t i = 0; i < iterations; i++) {
+      auto k = i % big_keys->size();
+      DoNotOptimize(
+          map.Find((*big_keys)[k].c_str(), (*big_hashes)[k]).AsInt64());
+    }
+  });
+
+  // Verifying a document, compared to converting all of it to text.
+  auto doc = std::make_shared<std::vector<uint8_t>>();
+  {
+    flexbuffers::Builder fbb;
+    fbb.Vector([&]() {
+      for (int i = 0; i < 100; i++) {
+        fbb.Map([&]() {
+          fbb.String("name", "item" + flatbuffers::NumToString(i));
+          fbb.Int("id", i);
+          fbb.Double("weight", i * 0.5);
+          int dims[] = { i, i + 1, i + 2 };
+          fbb.Vector("dims", dims, 3);
+          fbb.Vector("tags", [&]() {
+            fbb += "a";
+            fbb += i;
+          });
+        });
+      }
+    });
+    fbb.Finish();
+    *doc = fbb.GetBuffer();
+  }
+
+  Register("FlexBuffers/Verify", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(flexbuffers::VerifyBuffer(*doc));
+    }
+  });
+
+  Register("FlexBuffers/ToString", [=](size_t iterations) {
+    std::string text;
+    for (size_t i = 0; i < iterations; i++) {
+      text.clear();
+      flexbuffers::GetRoot(*doc).ToString(true, false, text);
+      DoNotOptimize(text.size());
+    }
+  });
+}
+
+void RegisterTextBenchmarks(const std::vector<uint8_t> &monster) {
+  auto parser = std::make_shared<flatbuffers::Parser>();
+  auto json = std::make_shared<std::string>();
+  if (!LoadParser(*parser, "monster_test.fbs") ||
+      !flatbuffers::LoadFile((test_data_path + "monsterdata_test.json").c_str(),
+                             false, json.get())) {
+    printf("Could not load %s, skipping text benchmarks (run from the root of "
+           "the repository)\n", (test_data_path + "monster_test.fbs").c_str());
+    return;
+  }
+  auto buf = std::make_shared<std::vector<uint8_t>>(monster);
+
+  Register("Text/ParseSchema", [](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      flatbuffers::Parser schema_parser;
+      DoNotOptimize(LoadParser(schema_parser, "monster_test.fbs"));
+    }
+  });
+
+  Register("Text/ParseJson", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(parser->Parse(json->c_str()));
+    }
+  });
+
+  // Numeric heavy JSON: many tables with just scalar fields set.
+  auto scalars_json = std::make_shared<std::string>("{ name: \"scalars\", "
+                                                    "testarrayoftables: [");
+  for (int i = 0; i < 1000; i++) {
+    *scalars_json += "{ name: \"\", hp: " + flatbuffers::NumToString(i) +
+                     ", mana: " + flatbuffers::NumToString(i * 3) +
+                     ", testf: " + flatbuffers::NumToString(i * 0.25) +
+                     ", testhashu64_fnv1: " +
+                     flatbuffers::NumToString(i * 1000003ULL) +
+                     ", testbool: true, pos: { x: 1.5, y: " +
+                     flatbuffers::NumToString(i) +
+                     ", z: -3, test1: 0.5, test2: Blue, test3: { a: " +
+                     flatbuffers::NumToString(i % 100) + ", b: 1 } } },";
+  }
+  *scalars_json += "] }";
+
+  Register("Text/ParseJson/Scalars", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(parser->Parse(scalars_json->c_str()));
+    }
+  });
+
+  // A table as wide as some real world schemas, to measure field lookup.
+  auto wide_parser = std::make_shared<flatbuffers::Parser>();
+  std::string wide_schema = "enum Flag:uint (bit_flags) {";
+  for (int i = 0; i < 32; i++) {
+    wide_schema += " flag_value_" + flatbuffers::NumToString(i) + ",";
+  }
+  wide_schema += " }\ntable Wide {";
+  for (int i = 0; i < 250; i++) {
+    wide_schema += " wide_field_" + flatbuffers::NumToString(i) + ":int;";
+  }
+  wide_schema += " flags:Flag; }\nroot_type Wide;";
+  auto wide_json = std::make_shared<std::string>("{");
+  for (int i = 0; i < 250; i += 2) {
+    *wide_json += " wide_field_" + flatbuffers::NumToString(i) + ": " +
+                  flatbuffers::NumToString(i) + ",";
+  }
+  *wide_json += " flags: \"flag_value_3 flag_value_17 flag_value_30\" }";
+  if (wide_parser->Parse(wide_schema.c_str())) {
+    Register("Text/ParseJson/WideTable", [=](size_t iterations) {
+      for (size_t i = 0; i < iterations; i++) {
+        DoNotOptimize(wide_parser->Parse(wide_json->c_str()));
+      }
+    });
+  }
+
+  Register("Text/GenerateText", [=](size_t iterations) {
+    std::string text;
+    for (size_t i = 0; i < iterations; i++) {
+      text.clear();
+      DoNotOptimize(GenerateText(*parser, buf->data(), &text));
+    }
+  });
+
+  // Numeric heavy output, from the scalars JSON above.
+  auto scalars_buf = std::make_shared<std::vector<uint8_t>>();
+  if (parser->Parse(scalars_json->c_str())) {
+    scalars_buf->assign(
+        parser->builder_.GetBufferPointer(),
+        parser->builder_.GetBufferPointer() + parser->builder_.GetSize());
+  }
+
+  Register("Text/GenerateText/Scalars", [=](size_t iterations) {
+    std::string text;
+    for (size_t i = 0; i < iterations; i++) {
+      text.clear();
+      DoNotOptimize(GenerateText(*parser, scalars_buf->data(), &text));
+    }
+  });
+
+  // The same text, from a printer compiled out of the binary schema.
+  auto printer = std::make_shared<flatbuffers::JsonPrinter>();
+  parser->opts.binary_schema_builtins = true;
+  parser->Serialize();
+  parser->opts.binary_schema_builtins = false;
+  if (printer->Compile(parser->builder_.GetBufferPointer(),
+                       parser->builder_.GetSize(), parser->opts)) {
+    Register("Text/JsonPrinter", [=](size_t iterations) {
+      std::string text;
+      for (size_t i = 0; i < iterations; i++) {
+        text.clear();
+        DoNotOptimize(printer->Print(buf->data(), &text));
+      }
+    });
+
+    Register("Text/JsonPrinter/Scalars", [=](size_t iterations) {
+      std::string text;
+      for (size_t i = 0; i < iterations; i++) {
+        text.clear();
+        DoNotOptimize(printer->Print(scalars_buf->data(), &text));
+      }
+    });
+  }
+
+  Register("Text/JsonRoundTrip", [=](size_t iterations) {
+    std::string text;
+    for (size_t i = 0; i < iterations; i++) {
+      text.clear();
+      parser->Parse(json->c_str());
+      DoNotOptimize(
+          GenerateText(*parser, parser->builder_.GetBufferPointer(), &text));
+    }
+  });
+
+  // The registry parses its schema on first use only.
+  auto registry = std::make_shared<flatbuffers::Registry>();
+  registry->AddIncludeDirectory(test_data_path.c_str());
+  registry->AddIncludeDirectory(include_test_path.c_str());
+  registry->Register(MonsterIdentifier(),
+                     (test_data_path + "monster_test.fbs").c_str());
+
+  Register("Text/Registry/FlatBufferToText", [=](size_t iterations) {
+    std::string text;
+    for (size_t i = 0; i < iterations; i++) {
+      text.clear();
+      DoNotOptimize(registry->FlatBufferToText(buf->data(), buf->size(), &text));
+    }
+  });
+
+  Register("Text/Registry/TextToFlatBuffer", [=](size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+      DoNotOptimize(
+          registry->TextToFlatBuffer(json->c_str(), MonsterIdentifier()).size());
+    }
+  });
+}
+
+void RegisterReflectionBenchmarks(const std::vector<uint8_t> &monster) {
+  auto bfbs = std::make_shared<std::string>();
+  if (!flatbuffers::LoadFile((test_data_path + "monster_test.bfbs").c_str(),
+                             true, bfbs.get())) {
+    printf("Could not load %s, skipping reflection benchmarks (run from the "
+           "root of the repository)\n",
+           (test_data_path + "monster_test.bfbs").c_str());
+    return;
+  }
+  // A Monster with 100 sub-monsters, all of which get renamed.
+  static const flatbuffers::uoffset_t kNumTables = 100;
+  auto buf = std::make_shared<std::vector<uint8_t>>();
+  auto new_names = std::make_shared<std::vector<std::string>>();
+  {
+    flatbuffers::FlatBufferBuilder fbb;
+    std::vector<flatbuffers::Offset<Monster>> tables;
+    for (flatbuffers::uoffset_t i = 0; i < kNumTables; i++) {
+      auto name = "monster " + flatbuffers::NumToString(i);
+      tables.push_back(
+          CreateMonster(fbb, nullptr, 0, 0, fbb.CreateString(name)));
+      new_names->push_back("renamed " + name);
+    }
+    auto vec = fbb.CreateVector(tables);
+    FinishMonsterBuffer(fbb, CreateMonster(fbb, nullptr, 0, 0,
+                                           fbb.CreateString("root"), 0,
+                                           Color_Blue, Any_NONE, 0, 0, 0,
+                                           vec));
+    buf->assign(fbb.GetBufferPointer(),
+                fbb.GetBufferPointer() + fbb.GetSize());
+  }
+
+  auto monster_buf = std::make_shared<std::vector<uint8_t>>(monster);
+
+  Register("Reflection/CopyTable", [=](size_t iterations) {
+    auto &schema = *reflection::GetSchema(bfbs->c_str());
+    flatbuffers::FlatBufferBuilder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      fbb.Finish(flatbuffers::CopyTable(
+          fbb, schema, *schema.root_table(),
+          *flatbuffers::GetAnyRoot(monster_buf->data())));
+      DoNotOptimize(fbb.GetBufferPointer());
+    }
+  });
+
+  Register("Reflection/CopyTable/TableCopier", [=](size_t iterations) {
+    auto &schema = *reflection::GetSchema(bfbs->c_str());
+    flatbuffers::TableCopier copier(schema);
+    flatbuffers::FlatBufferBuilder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      fbb.Finish(copier.CopyTable(
+          fbb, *schema.root_table(),
+          *flatbuffers::GetAnyRoot(monster_buf->data())));
+      DoNotOptimize(fbb.GetBufferPointer());
+    }
+  });
+
+  Register("Reflection/CopyTable/Tree", [=](size_t iterations) {
+    auto &schema = *reflection::GetSchema(bfbs->c_str());
+    flatbuffers::FlatBufferBuilder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      fbb.Finish(flatbuffers::CopyTable(fbb, schema, *schema.root_table(),
+                                        *flatbuffers::GetAnyRoot(buf->data())));
+      DoNotOptimize(fbb.GetBufferPointer());
+    }
+  });
+
+  Register("Reflection/CopyTable/Tree/TableCopier", [=](size_t iterations) {
+    auto &schema = *reflection::GetSchema(bfbs->c_str());
+    flatbuffers::TableCopier copier(schema);
+    flatbuffers::FlatBufferBuilder fbb;
+    for (size_t i = 0; i < iterations; i++) {
+      fbb.Clear();
+      fbb.Finish(copier.CopyTable(fbb, *schema.root_table(),
+                                  *flatbuffers::GetAnyRoot(buf->data())));
+      DoNotOptimize(fbb.GetBufferPointer());
+    }
+  });
+
+  Register("Reflection/SetString/Sequential", [=](size_t iterations) {
+    auto &schema = *reflection::GetSchema(bfbs->c_str());
+    std::vector<uint8_t> edited;
+    for (size_t i = 0; i < iterations; i++) {
+      edited = *buf;
+      for (flatbuffers::uoffset_t j = 0; j < kNumTables; j++) {
+        auto tables = GetMonster(edited.data())->testarrayoftables();
+        flatbuffers::SetString(schema, (*new_names)[j], tables->Get(j)->name(),
+                               &edited);
+      }
+      DoNotOptimize(edited.data());
+    }
+  });
+
+  Register("Reflection/SetString/Batched", [=](size_t iterations) {
+    auto &schema = *reflection::GetSchema(bfbs->c_str());
+    std::vector<uint8_t> edited;
+    for (size_t i = 0; i < iterations; i++) {
+      edited = *buf;
+      flatbuffers::ResizeBatch batch(schema, &edited);
+      auto tables = GetMonster(edited.data())->testarrayoftables();
+      for (flatbuffers::uoffset_t j = 0; j < kNumTables; j++) {
+        batch.SetString(tables->Get(j)->name(), (*new_names)[j]);
+      }
+      batch.Apply();
+      DoNotOptimize(edited.data());
+    }
+  });
+}
+
+}  // namespace
+
+int main(int argc, const char *argv[]) {
+  double min_time = 0.5;
+  std::string filter;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg.find("--min_time=") == 0) {
+      min_time = atof(arg.c_str() + strlen("--min_time="));
+    } else {
+      filter = arg;
+    }
+  }
+
+  auto monster = BuildMonsterBuffer();
+  RegisterBuilderBenchmarks(monster);
+  RegisterReaderBenchmarks(monster);
+  RegisterFlexBuffersBenchmarks();
+  RegisterTextBenchmarks(monster);
+  RegisterReflectionBenchmarks(monster);
+
+  return flatbenchmarks::RunBenchmarks(filter, min_time) ? 0 : 1;
+}
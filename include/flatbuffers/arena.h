@@ -0,0 +1,445 @@
+/*
+ * Copyright 2019 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_ARENA_H_
+#define FLATBUFFERS_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "flatbuffers/flatbuffers.h"
+
+namespace flatbuffers {
+
+// ArenaAllocator is an `Allocator` that keeps the memory of deallocated
+// buffers around, and hands it out again to later allocations of a similar
+// size, so that building many buffers in a row does not go through the heap.
+//
+// Memory is handed out in slabs whose size is a power of 2 (the smallest one
+// that fits the request), and deallocated slabs are cached in a free list per
+// size, up to `max_cached_bytes` in total.
+//
+// Deallocation typically happens when a `DetachedBuffer` built with this
+// allocator is destroyed, which returns its slab to the arena. That may happen
+// on a different thread than the one using the arena: such slabs are put on a
+// separate, locked list, which the owning thread picks up on its next
+// allocation. All other operations must happen on the owning thread (the one
+// that constructed the arena, or took it from `ArenaAllocator::ThreadLocal`).
+// An arena you construct yourself must outlive all buffers allocated from it.
+//
+// Example:
+//   auto &arena = flatbuffers::ArenaAllocator::ThreadLocal();
+//   flatbuffers::FlatBufferBuilder fbb(arena.GetSizeHint(), &arena);
+//   ...
+//   auto buf = fbb.Release();  // Returns its slab to `arena` when destroyed.
+class ArenaAllocator : public Allocator {
+ public:
+  explicit ArenaAllocator(size_t max_cached_bytes = 16 * 1024 * 1024)
+      : max_cached_bytes_(max_cached_bytes),
+        cached_bytes_(0),
+        size_hint_(0),
+        owner_(std::this_thread::get_id()),
+        has_remote_frees_(false) {}
+
+  ~ArenaAllocator() {
+    DrainRemoteFrees();
+    Trim();
+  }
+
+  uint8_t *allocate(size_t size) FLATBUFFERS_OVERRIDE {
+    if (has_remote_frees_.load(std::memory_order_relaxed)) DrainRemoteFrees();
+    size_hint_ = (std::max)(size_hint_, size);
+    auto size_class = SizeClass(size);
+    auto &free_list = free_lists_[size_class];
+    if (free_list.empty()) return new uint8_t[SlabSize(size_class)];
+    auto slab = free_list.back();
+    free_list.pop_back();
+    cached_bytes_ -= SlabSize(size_class);
+    return slab;
+  }
+
+  void deallocate(uint8_t *p, size_t size) FLATBUFFERS_OVERRIDE {
+    if (std::this_thread::get_id() != owner_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(remote_frees_mutex_);
+      Slab slab = { p, size };
+      remote_frees_.push_back(slab);
+      has_remote_frees_.store(true, std::memory_order_relaxed);
+      return;
+    }
+    Cache(p, size);
+  }
+
+  /// @brief The size of the slab that fits the largest allocation since the
+  /// last `ResetSizeHint()`. Using this as the `initial_size` of the next
+  /// `FlatBufferBuilder` avoids having to grow (and copy) its buffer if the
+  /// next buffer is of a similar size as the previous ones.
+  size_t GetSizeHint() const { return SlabSize(SizeClass(size_hint_)); }
+
+  void ResetSizeHint() { size_hint_ = 0; }
+
+  /// @brief The number of bytes held in slabs available for reuse.
+  size_t GetCachedBytes() const { return cached_bytes_; }
+
+  /// @brief Return all cached slabs to the heap.
+  void Trim() {
+    for (size_t size_class = 0; size_class < kNumSizeClasses; size_class++) {
+      auto &free_list = free_lists_[size_class];
+      for (auto it = free_list.begin(); it != free_list.end(); ++it) {
+        delete[] *it;
+      }
+      free_list.clear();
+    }
+    cached_bytes_ = 0;
+  }
+
+  /// @brief The arena of the calling thread.
+  /// Arenas are taken from a process wide pool, and returned to it when
+  /// their thread exits, so buffers may safely outlive the thread that built
+  /// them: a thread started later will pick up the arena and its remaining
+  /// slabs. Pooled arenas are never destroyed.
+  static ArenaAllocator &ThreadLocal() {
+    static thread_local PooledArena arena;
+    return *arena.get();
+  }
+
+ private:
+  // You shouldn't really be copying instances of this class.
+  FLATBUFFERS_DELETE_FUNC(ArenaAllocator(const ArenaAllocator &))
+  FLATBUFFERS_DELETE_FUNC(ArenaAllocator &operator=(const ArenaAllocator &))
+
+  struct Slab {
+    uint8_t *p;
+    size_t size;
+  };
+
+  // Smallest slab is 2^kMinSizeLog2 bytes, the largest as big as a FlatBuffer
+  // can get.
+  static const size_t kMinSizeLog2 = 10;
+  static const size_t kNumSizeClasses = 32 - kMinSizeLog2;
+
+  static size_t SizeClass(size_t size) {
+    size_t size_class = 0;
+    while (SlabSize(size_class) < size) size_class++;
+    FLATBUFFERS_ASSERT(size_class < kNumSizeClasses);
+    return size_class;
+  }
+
+  static size_t SlabSize(size_t size_class) {
+    return static_cast<size_t>(1) << (size_class + kMinSizeLog2);
+  }
+
+  void Cache(uint8_t *p, size_t size) {
+    auto size_class = SizeClass(size);
+    if (cached_bytes_ + SlabSize(size_class) > max_cached_bytes_) {
+      delete[] p;
+      return;
+    }
+    free_lists_[size_class].push_back(p);
+    cached_bytes_ += SlabSize(size_class);
+  }
+
+  void DrainRemoteFrees() {
+    std::vector<Slab> slabs;
+    {
+      std::lock_guard<std::mutex> lock(remote_frees_mutex_);
+      slabs.swap(remote_frees_);
+      has_remote_frees_.store(false, std::memory_order_relaxed);
+    }
+    for (auto it = slabs.begin(); it != slabs.end(); ++it) {
+      Cache(it->p, it->size);
+    }
+  }
+
+  // Global pool of arenas not currently owned by a thread.
+  static std::vector<ArenaAllocator *> &Pool(std::unique_lock<std::mutex> &) {
+    static std::vector<ArenaAllocator *> *pool =
+        new std::vector<ArenaAllocator *>();
+    return *pool;
+  }
+
+  static std::mutex &PoolMutex() {
+    static std::mutex *mutex = new std::mutex();
+    return *mutex;
+  }
+
+  // Takes an arena from the pool for the calling thread on first use, and
+  // puts it back when the thread exits.
+  class PooledArena {
+   public:
+    PooledArena() : arena_(nullptr) {}
+
+    ~PooledArena() {
+      if (!arena_) return;
+      std::unique_lock<std::mutex> lock(PoolMutex());
+      // The id of this thread may be reused by a new one, which must not
+      // take the arena for its own while it is in the pool: frees from any
+      // thread go to the remote list until the arena is adopted again.
+      arena_->owner_.store(std::thread::id());
+      Pool(lock).push_back(arena_);
+    }
+
+    ArenaAllocator *get() {
+      if (arena_) return arena_;
+      {
+        std::unique_lock<std::mutex> lock(PoolMutex());
+        auto &pool = Pool(lock);
+        if (!pool.empty()) {
+          arena_ = pool.back();
+          pool.pop_back();
+        }
+      }
+      if (arena_) {
+        arena_->owner_.store(std::this_thread::get_id());
+        arena_->DrainRemoteFrees();
+      } else {
+        arena_ = new ArenaAllocator();
+      }
+      return arena_;
+    }
+
+   private:
+    ArenaAllocator *arena_;
+  };
+
+  size_t max_cached_bytes_;
+  size_t cached_bytes_;
+  size_t size_hint_;
+  std::vector<uint8_t *> free_lists_[kNumSizeClasses];
+
+  std::atomic<std::thread::id> owner_;
+  std::atomic<bool> has_remote_frees_;
+  std::mutex remote_frees_mutex_;
+  std::vector<Slab> remote_frees_;
+};
+
+// NativeArena is a monotonic allocator for object API trees (the `FooT` types
+// generated with `--gen-object-api`). Allocation just bumps a pointer in the
+// current block, deallocation does nothing, and all memory is returned at once
+// by `Reset()` or the destructor, so an unpacked tree of any depth is freed
+// without visiting it.
+//
+// Code generated with `--cpp-object-api-allocator` allocates native tables,
+// strings and vectors from the arena made current with a `NativeArena::Scope`
+// (on the calling thread), which the generated `UnPack(arena)` overloads do
+// for you. Objects allocated outside of any scope use the heap as usual.
+//
+// Example:
+//   flatbuffers::NativeArena arena;
+//   MonsterT *monster = UnPackMonster(buf, arena);  // Owned by `arena`.
+//   ...
+//   arena.Reset();  // Frees `monster` and everything it points to.
+//
+// Destructors of objects in the arena don't run unless you `delete` them,
+// which is allowed but only frees memory they hold outside of the arena.
+class NativeArena {
+ public:
+  explicit NativeArena(size_t initial_block_size = 4096)
+      : blocks_(nullptr),
+        cur_(nullptr),
+        end_(nullptr),
+        next_block_size_(initial_block_size),
+        bytes_used_(0) {}
+
+  ~NativeArena() { FreeBlocks(nullptr); }
+
+  /// @brief Allocate `size` bytes aligned to `align` (a power of 2 no larger
+  /// than `kMaxAlign`). The memory stays valid until the next `Reset()`.
+  void *Allocate(size_t size, size_t align = kMaxAlign) {
+    FLATBUFFERS_ASSERT(align && !(align & (align - 1)) && align <= kMaxAlign);
+    auto padding = PaddingBytes(reinterpret_cast<size_t>(cur_), align);
+    if (padding + size > static_cast<size_t>(end_ - cur_)) {
+      NewBlock(size);  // Blocks start at kMaxAlign.
+      padding = 0;
+    }
+    auto p = cur_ + padding;
+    cur_ = p + size;
+    bytes_used_ += size;
+    return p;
+  }
+
+  /// @brief Free everything allocated from this arena. The largest block is
+  /// kept for reuse, so unpacking similar trees over and over does not touch
+  /// the heap after the first time.
+  void Reset() {
+    if (!blocks_) return;
+    auto largest = blocks_;
+    for (auto block = blocks_->next; block; block = block->next) {
+      if (block->size > largest->size) largest = block;
+    }
+    FreeBlocks(largest);
+    largest->next = nullptr;
+    blocks_ = largest;
+    cur_ = BlockData(largest);
+    end_ = cur_ + largest->size;
+    bytes_used_ = 0;
+  }
+
+  /// @brief The number of bytes allocated since the last `Reset()`.
+  size_t GetBytesUsed() const { return bytes_used_; }
+
+  /// @brief Makes an arena the one the calling thread allocates native
+  /// objects from, for the lifetime of the scope. Scopes may be nested.
+  class Scope {
+   public:
+    explicit Scope(NativeArena &arena) : prev_(CurrentRef()) {
+      CurrentRef() = &arena;
+    }
+    ~Scope() { CurrentRef() = prev_; }
+
+   private:
+    FLATBUFFERS_DELETE_FUNC(Scope(const Scope &))
+    FLATBUFFERS_DELETE_FUNC(Scope &operator=(const Scope &))
+
+    NativeArena *prev_;
+  };
+
+  /// @brief The arena of the innermost `Scope` on this thread, or nullptr.
+  static NativeArena *Current() { return CurrentRef(); }
+
+  /// @brief Backs the `operator new` of generated native objects: allocates
+  /// from the current arena if there is one, from the heap otherwise.
+  static void *NewObject(size_t size) {
+    auto arena = Current();
+    auto header = static_cast<NativeArena **>(
+        arena ? arena->Allocate(kMaxAlign + size)
+              : ::operator new(kMaxAlign + size));
+    *header = arena;
+    return reinterpret_cast<uint8_t *>(header) + kMaxAlign;
+  }
+
+  /// @brief Backs the `operator delete` of generated native objects: a no-op
+  /// for objects that live in an arena.
+  static void DeleteObject(void *p) {
+    if (!p) return;
+    auto header = reinterpret_cast<NativeArena **>(static_cast<uint8_t *>(p) -
+                                                   kMaxAlign);
+    if (!*header) ::operator delete(header);
+  }
+
+  // Alignment of all allocations that don't ask for less. Native objects are
+  // preceded by a header of this size that records where they came from.
+  static const size_t kMaxAlign = 16;
+
+ private:
+  FLATBUFFERS_DELETE_FUNC(NativeArena(const NativeArena &))
+  FLATBUFFERS_DELETE_FUNC(NativeArena &operator=(const NativeArena &))
+
+  struct Block {
+    Block *next;
+    size_t size;
+  };
+
+  static const size_t kBlockHeaderSize =
+      (sizeof(Block) + kMaxAlign - 1) & ~(kMaxAlign - 1);
+  static const size_t kMaxBlockSize = 16 * 1024 * 1024;
+
+  static uint8_t *BlockData(Block *block) {
+    return reinterpret_cast<uint8_t *>(block) + kBlockHeaderSize;
+  }
+
+  static NativeArena *&CurrentRef() {
+    static thread_local NativeArena *current = nullptr;
+    return current;
+  }
+
+  void NewBlock(size_t min_size) {
+    auto size = (std::max)(next_block_size_, min_size);
+    next_block_size_ = size < kMaxBlockSize / 2 ? size * 2 : kMaxBlockSize;
+    auto block =
+        static_cast<Block *>(::operator new(kBlockHeaderSize + size));
+    block->next = blocks_;
+    block->size = size;
+    blocks_ = block;
+    cur_ = BlockData(block);
+    end_ = cur_ + size;
+  }
+
+  // Frees all blocks except `keep`.
+  void FreeBlocks(Block *keep) {
+    for (auto block = blocks_; block;) {
+      auto next = block->next;
+      if (block != keep) ::operator delete(block);
+      block = next;
+    }
+    blocks_ = nullptr;
+  }
+
+  Block *blocks_;
+  uint8_t *cur_;
+  uint8_t *end_;
+  size_t next_block_size_;
+  size_t bytes_used_;
+};
+
+// NativeAllocator is the standard library allocator used by the strings and
+// vectors of native objects generated with `--cpp-object-api-allocator`.
+// A default constructed one allocates from `NativeArena::Current()` (or the
+// heap if there is none), and containers keep using the allocator they were
+// constructed with. Copies of a container take the current arena at the time
+// of the copy, not that of the original.
+template<typename T> class NativeAllocator {
+ public:
+  typedef T value_type;
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::false_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+  template<typename U> struct rebind { typedef NativeAllocator<U> other; };
+
+  NativeAllocator() : arena_(NativeArena::Current()) {}
+  explicit NativeAllocator(NativeArena *arena) : arena_(arena) {}
+  template<typename U>
+  NativeAllocator(const NativeAllocator<U> &other) : arena_(other.arena()) {}
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(arena_ ? arena_->Allocate(n * sizeof(T))
+                                   : ::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, size_t) {
+    if (!arena_) ::operator delete(p);
+  }
+
+  NativeAllocator select_on_container_copy_construction() const {
+    return NativeAllocator();
+  }
+
+  NativeArena *arena() const { return arena_; }
+
+ private:
+  NativeArena *arena_;
+};
+
+template<typename T, typename U>
+bool operator==(const NativeAllocator<T> &a, const NativeAllocator<U> &b) {
+  return a.arena() == b.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const NativeAllocator<T> &a, const NativeAllocator<U> &b) {
+  return a.arena() != b.arena();
+}
+
+// The string type of native objects generated with
+// `--cpp-object-api-allocator`.
+typedef std::basic_string<char, std::char_traits<char>, NativeAllocator<char>>
+    native_string;
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_ARENA_H_
@@ -966,6 +966,130 @@ class vector_downward {
   }
 };
 
+// FNV-1a hash of a range of bytes, used to index serialized data for
+// deduplication (see offset_hash_index below).
+inline uint32_t HashBytes(const uint8_t *bytes, size_t len) {
+  uint32_t hash = 0x811c9dc5;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= bytes[i];
+    hash *= 0x01000193;
+  }
+  return hash;
+}
+
+// An open-addressing hash table of (hash, offset) pairs, stored in a single
+// flat array obtained from an `Allocator`. Offsets are relative to the end of
+// a `vector_downward`, so they stay valid when the buffer grows. An offset of 0
+// marks an empty slot. clear() keeps the storage around for reuse.
+class offset_hash_index {
+ public:
+  explicit offset_hash_index(Allocator *allocator = nullptr)
+      : allocator_(allocator), slots_(nullptr), capacity_(0), size_(0) {}
+
+  ~offset_hash_index() { reset(); }
+
+  // Forget all entries, keeping the allocated slots.
+  void clear() {
+    if (size_) memset(slots_, 0, capacity_ * sizeof(Slot));
+    size_ = 0;
+  }
+
+  // Forget all entries and release the allocated slots.
+  void reset() {
+    if (slots_) {
+      Deallocate(allocator_, reinterpret_cast<uint8_t *>(slots_),
+                 capacity_ * sizeof(Slot));
+    }
+    slots_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+
+  // Moves the allocated slots (and entries) to memory from `allocator`.
+  void set_allocator(Allocator *allocator) {
+    if (allocator == allocator_) return;
+    if (!slots_) {
+      allocator_ = allocator;
+      return;
+    }
+    auto bytes = capacity_ * sizeof(Slot);
+    auto slots = reinterpret_cast<Slot *>(Allocate(allocator, bytes));
+    memcpy(slots, slots_, bytes);
+    Deallocate(allocator_, reinterpret_cast<uint8_t *>(slots_), bytes);
+    allocator_ = allocator;
+    slots_ = slots;
+  }
+
+  // Returns the offset of an entry with this hash for which `equal(offset)`
+  // returns true, or 0 if there is none.
+  template<typename F> uoffset_t find(uint32_t hash, const F &equal) const {
+    if (!size_) return 0;
+    for (size_t i = hash & (capacity_ - 1);; i = (i + 1) & (capacity_ - 1)) {
+      const Slot &slot = slots_[i];
+      if (!slot.off) return 0;
+      if (slot.hash == hash && equal(slot.off)) return slot.off;
+    }
+  }
+
+  // Adds an entry, which should not already be present.
+  void insert(uint32_t hash, uoffset_t off) {
+    FLATBUFFERS_ASSERT(off);
+    // Keep the load factor at or below 1/2 so probe sequences stay short.
+    if ((size_ + 1) * 2 > capacity_) grow();
+    insert_slot(hash, off);
+    size_++;
+  }
+
+  void swap(offset_hash_index &other) {
+    using std::swap;
+    swap(allocator_, other.allocator_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+  }
+
+ private:
+  // You shouldn't really be copying instances of this class.
+  FLATBUFFERS_DELETE_FUNC(offset_hash_index(const offset_hash_index &))
+  FLATBUFFERS_DELETE_FUNC(
+      offset_hash_index &operator=(const offset_hash_index &))
+
+  struct Slot {
+    uint32_t hash;
+    uoffset_t off;
+  };
+
+  Allocator *allocator_;
+  Slot *slots_;
+  size_t capacity_;  // Always 0 or a power of 2.
+  size_t size_;
+
+  void insert_slot(uint32_t hash, uoffset_t off) {
+    auto i = hash & (capacity_ - 1);
+    while (slots_[i].off) i = (i + 1) & (capacity_ - 1);
+    slots_[i].hash = hash;
+    slots_[i].off = off;
+  }
+
+  void grow() {
+    auto old_slots = slots_;
+    auto old_capacity = capacity_;
+    capacity_ = old_capacity ? old_capacity * 2 : 64;
+    slots_ = reinterpret_cast<Slot *>(
+        Allocate(allocator_, capacity_ * sizeof(Slot)));
+    memset(slots_, 0, capacity_ * sizeof(Slot));
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old_slots[i].off) insert_slot(old_slots[i].hash, old_slots[i].off);
+    }
+    if (old_slots) {
+      Deallocate(allocator_, reinterpret_cast<uint8_t *>(old_slots),
+                 old_capacity * sizeof(Slot));
+    }
+  }
+};
+
 // Converts a Field ID to a virtual table offset.
 inline voffset_t FieldIndexToOffset(voffset_t field_id) {
   // Should correspond to what EndTable() below builds up.
@@ -987,8 +1111,51 @@ template<typename T, typename Alloc> T *data(std::vector<T, Alloc> &v) {
   return v.empty() ? reinterpret_cast<T*>(&t) : &v.front();
 }
 
+// Copy the elements of a vector of scalars to a native vector, as in the
+// generated UnPack() functions. U is T, or an enum whose values are stored
+// as T. Where their wire format is the native one, i.e. on little endian
+// hosts, and for enums of the same size as T, this copies them in bulk.
+template<typename T, typename U, typename Alloc>
+void UnPackVector(const Vector<T> *vec, std::vector<U, Alloc> *dest) {
+  auto size = vec->size();
+  dest->resize(size);
+  if (IsConstTrue(is_enum<U>::value && sizeof(U) == sizeof(T) &&
+                  (FLATBUFFERS_LITTLEENDIAN || sizeof(T) == 1))) {
+    memcpy(data(*dest), vec->Data(), size * sizeof(T));
+  } else {
+    for (uoffset_t i = 0; i < size; i++) {
+      (*dest)[i] = static_cast<U>(vec->Get(i));
+    }
+  }
+}
+
+template<typename T, typename Alloc>
+void UnPackVector(const Vector<T> *vec, std::vector<T, Alloc> *dest) {
+  if (IsConstTrue(FLATBUFFERS_LITTLEENDIAN || sizeof(T) == 1)) {
+    dest->assign(vec->data(), vec->data() + vec->size());
+  } else {
+    dest->resize(vec->size());
+    for (uoffset_t i = 0; i < vec->size(); i++) (*dest)[i] = vec->Get(i);
+  }
+}
+
+// Structs are stored the same way on all hosts.
+template<typename T, typename Alloc>
+void UnPackVector(const Vector<const T *> *vec, std::vector<T, Alloc> *dest) {
+  auto structs = reinterpret_cast<const T *>(vec->Data());
+  dest->assign(structs, structs + vec->size());
+}
+
 /// @endcond
 
+/// @brief A contiguous range of bytes of a finished buffer, as returned by
+/// `FlatBufferBuilder::GetBufferSegments()`. Has the same layout as POSIX
+/// `struct iovec`, so a list of segments can be passed to `writev()`.
+struct BufferSegment {
+  const uint8_t *data;
+  size_t size;
+};
+
 /// @addtogroup flatbuffers_cpp_api
 /// @{
 /// @class FlatBufferBuilder
@@ -1024,7 +1191,7 @@ class FlatBufferBuilder {
         minalign_(1),
         force_defaults_(false),
         dedup_vtables_(true),
-        string_pool(nullptr) {
+        index_vtables_(false) {
     EndianCheck();
   }
 
@@ -1043,7 +1210,7 @@ class FlatBufferBuilder {
       minalign_(1),
       force_defaults_(false),
       dedup_vtables_(true),
-      string_pool(nullptr) {
+      index_vtables_(false) {
     EndianCheck();
     // Default construct and swap idiom.
     // Lack of delegating constructors in vs2010 makes it more verbose than needed.
@@ -1075,11 +1242,10 @@ class FlatBufferBuilder {
     swap(minalign_, other.minalign_);
     swap(force_defaults_, other.force_defaults_);
     swap(dedup_vtables_, other.dedup_vtables_);
-    swap(string_pool, other.string_pool);
-  }
-
-  ~FlatBufferBuilder() {
-    if (string_pool) delete string_pool;
+    swap(index_vtables_, other.index_vtables_);
+    vtable_index_.swap(other.vtable_index_);
+    string_pool.swap(other.string_pool);
+    external_data_.swap(other.external_data_);
   }
 
   void Reset() {
@@ -1095,7 +1261,9 @@ class FlatBufferBuilder {
     nested = false;
     finished = false;
     minalign_ = 1;
-    if (string_pool) string_pool->clear();
+    vtable_index_.clear();
+    string_pool.clear();
+    external_data_.clear();
   }
 
   /// @brief The current size of the serialized buffer, counting from the end.
@@ -1175,6 +1343,72 @@ class FlatBufferBuilder {
   /// @param[in] bool dedup When set to `true`, dedup vtables.
   void DedupVtables(bool dedup) { dedup_vtables_ = dedup; }
 
+  /// @brief By default vtables are deduped by comparing against every vtable
+  /// written so far, which is fastest when there are only a few distinct table
+  /// layouts. Buffers with many distinct layouts should use a hash index
+  /// instead, which makes finding a duplicate constant time.
+  /// @param[in] bool index When set to `true`, look up vtables in a hash index.
+  void IndexVtables(bool index) {
+    index_vtables_ = index;
+    vtable_index_.clear();
+    // Index the vtables that have been written already, if any.
+    if (!index || !buf_.capacity()) return;
+    for (auto it = buf_.scratch_data();
+         it < buf_.scratch_end() - num_field_loc * sizeof(FieldLoc);
+         it += sizeof(uoffset_t)) {
+      auto vt_offset = *reinterpret_cast<uoffset_t *>(it);
+      auto vt = buf_.data_at(vt_offset);
+      vtable_index_.insert(HashBytes(vt, ReadScalar<voffset_t>(vt)),
+                           vt_offset);
+    }
+  }
+
+  /// @brief Set the `Allocator` used for the lookup tables behind
+  /// `IndexVtables` and `CreateSharedString`. These tables keep their memory
+  /// across `Clear()` and `Reset()`, so `allocator` must outlive the builder.
+  /// @param[in] allocator The `Allocator` to use. If null will use
+  /// `DefaultAllocator`.
+  void SetIndexAllocator(Allocator *allocator) {
+    vtable_index_.set_allocator(allocator);
+    string_pool.set_allocator(allocator);
+  }
+
+  /// @brief Grow the buffer once, so that `size` more bytes of data, plus
+  /// what `Finish()` adds, fit without the buffer having to grow (and copy its
+  /// contents) again. Pass the `SerializedSizeBound()` of an object API object
+  /// to pack it without any reallocation:
+  ///   fbb.Reserve(monster.SerializedSizeBound());
+  ///   fbb.Finish(CreateMonster(fbb, &monster));
+  /// @param[in] size The number of bytes to reserve.
+  void Reserve(size_t size) { buf_.ensure_space(size + kFinishSizeBound); }
+
+  /// @cond FLATBUFFERS_INTERNAL
+  // Upper bounds on the buffer space the different parts of a FlatBuffer take
+  // up, including alignment padding and scratch space. These are used by the
+  // generated `SerializedSizeBound()` functions.
+
+  // A table, given the bound on its inline field data. Besides the vtable
+  // and the offset to it, this counts the scratch space EndTable() uses.
+  static size_t TableSizeBound(size_t num_fields, size_t inline_size) {
+    return sizeof(soffset_t) + sizeof(uoffset_t) - 1 +
+           (num_fields + 2) * sizeof(voffset_t) +
+           num_fields * sizeof(FieldLoc) + sizeof(uoffset_t) + inline_size;
+  }
+
+  static size_t StringSizeBound(size_t len) {
+    return 2 * sizeof(uoffset_t) + len;
+  }
+
+  static size_t VectorSizeBound(size_t len, size_t elem_size,
+                                size_t alignment) {
+    return 2 * sizeof(uoffset_t) + alignment + len * elem_size;
+  }
+
+  // The root offset, file identifier, size prefix, and alignment padding.
+  static const size_t kFinishSizeBound =
+      3 * sizeof(uoffset_t) + FLATBUFFERS_MAX_ALIGNMENT;
+  /// @endcond
+
   /// @cond FLATBUFFERS_INTERNAL
   void Pad(size_t num_bytes) { buf_.fill(num_bytes); }
 
@@ -1319,9 +1553,17 @@ class FlatBufferBuilder {
     auto vt1 = reinterpret_cast<voffset_t *>(buf_.data());
     auto vt1_size = ReadScalar<voffset_t>(vt1);
     auto vt_use = GetSize();
+    uint32_t vt1_hash = 0;
     // See if we already have generated a vtable with this exact same
     // layout before. If so, make it point to the old one, remove this one.
-    if (dedup_vtables_) {
+    if (dedup_vtables_ && index_vtables_) {
+      vt1_hash = HashBytes(reinterpret_cast<const uint8_t *>(vt1), vt1_size);
+      auto vt2_offset = vtable_index_.find(vt1_hash, VtableEquals(buf_, vt1));
+      if (vt2_offset) {
+        vt_use = vt2_offset;
+        buf_.pop(GetSize() - vtableoffsetloc);
+      }
+    } else if (dedup_vtables_) {
       for (auto it = buf_.scratch_data(); it < buf_.scratch_end();
            it += sizeof(uoffset_t)) {
         auto vt_offset_ptr = reinterpret_cast<uoffset_t *>(it);
@@ -1334,7 +1576,12 @@ class FlatBufferBuilder {
       }
     }
     // If this is a new vtable, remember it.
-    if (vt_use == GetSize()) { buf_.scratch_push_small(vt_use); }
+    if (vt_use == GetSize()) {
+      buf_.scratch_push_small(vt_use);
+      if (dedup_vtables_ && index_vtables_) {
+        vtable_index_.insert(vt1_hash, vt_use);
+      }
+    }
     // Fill the vtable offset we created above.
     // The offset points from the beginning of the object to where the
     // vtable is stored.
@@ -1449,21 +1696,14 @@ class FlatBufferBuilder {
   /// @param[in] len The number of bytes that should be stored from `str`.
   /// @return Returns the offset in the buffer where the string starts.
   Offset<String> CreateSharedString(const char *str, size_t len) {
-    if (!string_pool)
-      string_pool = new StringOffsetMap(StringOffsetCompare(buf_));
-    auto size_before_string = buf_.size();
-    // Must first serialize the string, since the set is all offsets into
-    // buffer.
-    auto off = CreateString(str, len);
-    auto it = string_pool->find(off);
+    NotNested();
+    auto hash = HashBytes(reinterpret_cast<const uint8_t *>(str), len);
+    auto existing = string_pool.find(hash, StringEquals(buf_, str, len));
     // If it exists we reuse existing serialized data!
-    if (it != string_pool->end()) {
-      // We can remove the string we serialized.
-      buf_.pop(buf_.size() - size_before_string);
-      return *it;
-    }
+    if (existing) return Offset<String>(existing);
     // Record this string for future use.
-    string_pool->insert(off);
+    auto off = CreateString(str, len);
+    string_pool.insert(hash, off.o);
     return off;
   }
 
@@ -1565,7 +1805,8 @@ class FlatBufferBuilder {
   /// buffer as a `vector`.
   /// @return Returns a typed `Offset` into the serialized data indicating
   /// where the vector is stored.
-  template<typename T> Offset<Vector<T>> CreateVector(const std::vector<T> &v) {
+  template<typename T, typename Alloc>
+  Offset<Vector<T>> CreateVector(const std::vector<T, Alloc> &v) {
     return CreateVector(data(v), v.size());
   }
 
@@ -1720,9 +1961,9 @@ class FlatBufferBuilder {
   /// serialize into the buffer as a `vector`.
   /// @return Returns a typed `Offset` into the serialized data indicating
   /// where the vector is stored.
-  template<typename T, typename S>
+  template<typename T, typename S, typename Alloc>
   Offset<Vector<const T *>> CreateVectorOfNativeStructs(
-      const std::vector<S> &v) {
+      const std::vector<S, Alloc> &v) {
     return CreateVectorOfNativeStructs<T, S>(data(v), v.size());
   }
 
@@ -1878,6 +2119,60 @@ class FlatBufferBuilder {
                                      reinterpret_cast<uint8_t **>(buf));
   }
 
+  /// @brief Specialized version of `CreateVector` for large blobs of bytes,
+  /// that avoids copying them into the buffer. Space for the bytes is
+  /// reserved in the buffer but never written: the finished buffer is only
+  /// complete when written out through `GetBufferSegments()`, which refers to
+  /// `data` directly. `GetBufferPointer()` and `Release()` return the buffer
+  /// with the space left uninitialized.
+  /// @param[in] data The bytes of the `vector`, which must stay valid until
+  /// the segments of the finished buffer have been written.
+  /// @param[in] len The number of bytes.
+  /// @param[in] alignment The alignment the bytes need in the buffer, for
+  /// example the `GetBufferMinAlignment()` of a nested FlatBuffer.
+  /// @return Returns a typed `Offset` into the serialized data indicating
+  /// where the vector is stored.
+  Offset<Vector<uint8_t>> CreateExternalVector(const uint8_t *data, size_t len,
+                                               size_t alignment = 1) {
+    NotNested();
+    ForceVectorAlignment(len, sizeof(uint8_t), alignment);
+    uint8_t *buf;
+    auto vec = CreateUninitializedVector(len, sizeof(uint8_t), &buf);
+    ExternalData external = { vec - static_cast<uoffset_t>(sizeof(uoffset_t)),
+                              data, len };
+    external_data_.push_back(external);
+    return Offset<Vector<uint8_t>>(vec);
+  }
+
+  /// @brief Get the finished buffer as a list of segments, which together
+  /// make up the buffer in order. These are the parts of the buffer in
+  /// between vectors created with `CreateExternalVector()`, interleaved with
+  /// the data of those vectors.
+  /// @param[out] segments The segments of the buffer. Only valid as long as
+  /// the builder and the external data are.
+  void GetBufferSegments(std::vector<BufferSegment> *segments) const {
+    Finished();
+    segments->clear();
+    auto start = buf_.data();
+    // Later vectors are closer to the start of the buffer.
+    for (auto it = external_data_.rbegin(); it != external_data_.rend();
+         ++it) {
+      auto hole = buf_.data_at(it->offset);
+      if (hole > start) {
+        BufferSegment segment = { start, static_cast<size_t>(hole - start) };
+        segments->push_back(segment);
+      }
+      if (it->size) {
+        BufferSegment segment = { it->data, it->size };
+        segments->push_back(segment);
+      }
+      start = hole + it->size;
+    }
+    BufferSegment segment = { start, static_cast<size_t>(
+                                         buf_.data() + buf_.size() - start) };
+    segments->push_back(segment);
+  }
+
 
   // @brief Create a vector of scalar type T given as input a vector of scalar
   // type U, useful with e.g. pre "enum class" enums, or any existing scalar
@@ -1886,6 +2181,11 @@ class FlatBufferBuilder {
   Offset<Vector<T>> CreateVectorScalarCast(const U *v, size_t len) {
     AssertScalarT<T>();
     AssertScalarT<U>();
+    // Enums of the same size as T already are in the wire format.
+    if (IsConstTrue(is_enum<U>::value && sizeof(U) == sizeof(T) &&
+                    (FLATBUFFERS_LITTLEENDIAN || sizeof(T) == 1))) {
+      return CreateVector(reinterpret_cast<const T *>(v), len);
+    }
     StartVector(len, sizeof(T));
     for (auto i = len; i > 0;) { PushElement(static_cast<T>(v[--i])); }
     return Offset<Vector<T>>(EndVector(len));
@@ -1936,6 +2236,7 @@ protected:
   void Finish(uoffset_t root, const char *file_identifier, bool size_prefix) {
     NotNested();
     buf_.clear_scratch();
+    vtable_index_.clear();
     // This will cause the whole buffer to be aligned.
     PreAlign((size_prefix ? sizeof(uoffset_t) : 0) + sizeof(uoffset_t) +
                  (file_identifier ? kFileIdentifierLength : 0),
@@ -1976,20 +2277,45 @@ protected:
 
   bool dedup_vtables_;
 
-  struct StringOffsetCompare {
-    StringOffsetCompare(const vector_downward &buf) : buf_(&buf) {}
-    bool operator()(const Offset<String> &a, const Offset<String> &b) const {
-      auto stra = reinterpret_cast<const String *>(buf_->data_at(a.o));
-      auto strb = reinterpret_cast<const String *>(buf_->data_at(b.o));
-      return StringLessThan(stra->data(), stra->size(),
-                            strb->data(), strb->size());
+  // Look up vtables in vtable_index_ rather than scanning the scratch pad.
+  bool index_vtables_;
+
+  // Hash index over the same vtables as the ones listed in the scratch pad.
+  offset_hash_index vtable_index_;
+
+  struct VtableEquals {
+    VtableEquals(const vector_downward &buf, const voffset_t *vt)
+        : buf_(&buf), vt_(vt) {}
+    bool operator()(uoffset_t vt_offset) const {
+      auto vt2 = reinterpret_cast<const voffset_t *>(buf_->data_at(vt_offset));
+      return *vt2 == *vt_ && 0 == memcmp(vt2, vt_, *vt_);
+    }
+    const vector_downward *buf_;
+    const voffset_t *vt_;
+  };
+
+  struct StringEquals {
+    StringEquals(const vector_downward &buf, const char *str, size_t len)
+        : buf_(&buf), str_(str), len_(len) {}
+    bool operator()(uoffset_t str_offset) const {
+      auto str = reinterpret_cast<const String *>(buf_->data_at(str_offset));
+      return str->size() == len_ && 0 == memcmp(str->data(), str_, len_);
     }
     const vector_downward *buf_;
+    const char *str_;
+    size_t len_;
   };
 
-  // For use with CreateSharedString. Instantiated on first use only.
-  typedef std::set<Offset<String>, StringOffsetCompare> StringOffsetMap;
-  StringOffsetMap *string_pool;
+  // For use with CreateSharedString. Allocates on first use only.
+  offset_hash_index string_pool;
+
+  // Vectors created with CreateExternalVector(), in order of creation.
+  struct ExternalData {
+    uoffset_t offset;  // Of the start of the vector data, from the end.
+    const uint8_t *data;
+    size_t size;
+  };
+  std::vector<ExternalData> external_data_;
 
  private:
   // Allocates space for a vector of structures.
@@ -2057,6 +2383,23 @@ inline bool BufferHasIdentifier(const void *buf, const char *identifier, bool si
                  FlatBufferBuilder::kFileIdentifierLength) == 0;
 }
 
+/// @brief Function type for running tasks in parallel, used by the `Verifier`
+/// to verify large vectors of tables (see `Verifier::SetParallelFor`). It must
+/// call `task(context, i)` (or `task(i)`) once for each i in
+/// [0, num_tasks), for example on a thread pool, and return when all of them
+/// have completed.
+// clang-format off
+#ifdef FLATBUFFERS_CPP98_STL
+  typedef void (*parallel_task_t)(void *context, size_t i);
+  typedef void (*parallel_for_function_t)(size_t num_tasks,
+                                          parallel_task_t task, void *context);
+#else
+  typedef std::function<void (size_t num_tasks,
+                              const std::function<void (size_t i)> &task)>
+          parallel_for_function_t;
+#endif
+// clang-format on
+
 // Helper class to verify the integrity of a FlatBuffer
 class Verifier FLATBUFFERS_FINAL_CLASS {
  public:
@@ -2069,11 +2412,144 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
         num_tables_(0),
         max_tables_(_max_tables),
         upper_bound_(0),
-        check_alignment_(_check_alignment)
+        check_alignment_(_check_alignment),
+        parallel_for_(),
+        min_parallel_tables_(0),
+        lazy_(false)
+        // clang-format off
+        #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+          , error_rule_(nullptr),
+          error_offset_(0)
+        #endif
+  // clang-format on
   {
     FLATBUFFERS_ASSERT(size_ < FLATBUFFERS_MAX_BUFFER_SIZE);
   }
 
+  /// @brief Verify vectors of at least `2 * min_tables` tables in parallel.
+  /// Such vectors are split into chunks of at least `min_tables` tables,
+  /// each verified by its own copy of this verifier, as tasks run by
+  /// `parallel_for`. The verdict, and the limits on the number of tables and
+  /// depth, are the same as when verifying serially. Vectors nested inside
+  /// a chunk are verified serially, so `parallel_for` is never called from
+  /// within one of its own tasks.
+  /// @param[in] parallel_for The function running the tasks.
+  /// @param[in] min_tables The minimum number of tables per task.
+  void SetParallelFor(parallel_for_function_t parallel_for,
+                      uoffset_t min_tables = 1024) {
+    parallel_for_ = parallel_for;
+    min_parallel_tables_ = (std::max)(min_tables, static_cast<uoffset_t>(1));
+  }
+
+  /// @brief Verify tables lazily, only when they are accessed.
+  /// In this mode, verifying a buffer only verifies the fields of its root
+  /// table: strings and vectors of scalars or structs it refers to are
+  /// verified, but tables (and vectors of them, and unions) only get their
+  /// offsets checked. Each such table must be passed through `Verified()`
+  /// before it is read, which verifies it the same way the first time, and
+  /// remembers it was verified in a bitmap of one bit per 4 bytes of buffer.
+  /// The cost of verification is then proportional to the part of the buffer
+  /// that is actually read.
+  void SetLazy(bool lazy) {
+    lazy_ = lazy;
+    verified_tables_.clear();
+    if (lazy_) verified_tables_.resize((size_ >> TableShift()) / 8 + 1, 0);
+  }
+
+  /// @brief Returns `table` if it is null or verifies, nullptr otherwise.
+  /// Only use on tables accessed through a table that was itself verified,
+  /// i.e. the root of a buffer verified in lazy mode, or anything returned by
+  /// this function. Tables are verified at most once.
+  template<typename T> const T *Verified(const T *table) {
+    FLATBUFFERS_ASSERT(lazy_);
+    if (!table) return nullptr;
+    auto tableo =
+        static_cast<size_t>(reinterpret_cast<const uint8_t *>(table) - buf_);
+    // Not a table of this buffer at all, which is a bug in the caller rather
+    // than a verification failure.
+    if (tableo >= size_) return nullptr;
+    // Only aligned offsets index the bitmap, as the bits they shift out would
+    // otherwise alias another table.
+    auto in_bitmap = !(tableo & ((static_cast<size_t>(1) << TableShift()) - 1));
+    auto bit = tableo >> TableShift();
+    auto mask = static_cast<uint8_t>(1 << (bit & 7));
+    if (in_bitmap && (verified_tables_[bit >> 3] & mask)) return table;
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+      // Report the path from this table, not from the last one that failed.
+      error_rule_ = nullptr;
+      error_offset_ = 0;
+      path_.clear();
+    #endif
+    // clang-format on
+    if (!Verify<soffset_t>(tableo)) return nullptr;
+    auto depth = depth_;
+    auto ok = table->Verify(*this);
+    // The depth isn't restored when bailing out of a table.
+    depth_ = depth;
+    if (!ok) return nullptr;
+    if (in_bitmap) verified_tables_[bit >> 3] |= mask;
+    return table;
+  }
+
+  // clang-format off
+  #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+    // Where a table is when verification fails, and which of its fields
+    // was being verified.
+    struct PathElement {
+      uoffset_t table;  // Offset of the table in the buffer.
+      voffset_t field;  // Its vtable offset, 0 if not at any field yet.
+    };
+
+    /// @brief After verification failed, describes the rule that was broken,
+    /// e.g. "string not zero terminated". nullptr if there was none (e.g. for
+    /// a union of unknown type), or if verification did not fail.
+    const char *GetErrorRule() const { return error_rule_; }
+
+    /// @brief After verification failed, the offset in the buffer of the
+    /// bytes that broke the rule (where it applies to any).
+    size_t GetErrorOffset() const { return error_offset_; }
+
+    /// @brief After verification failed, the tables that were being
+    /// verified, from the root down. See `VerifierErrorToString()` in
+    /// minireflect.h to turn this into field names.
+    const std::vector<PathElement> &GetErrorPath() const { return path_; }
+  #endif
+  // clang-format on
+
+  // Records why verification failed, only if FLATBUFFERS_VERIFIER_DIAGNOSTICS
+  // is defined. Returns `ok`.
+  bool Report(bool ok, const char *rule, size_t offset) const {
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+      if (!ok && !error_rule_) {
+        error_rule_ = rule;
+        error_offset_ = offset;
+      }
+    #else
+      (void)rule;
+      (void)offset;
+    #endif
+    // clang-format on
+    return ok;
+  }
+
+  bool Check(bool ok, const char *rule, size_t offset) const {
+    return Check(Report(ok, rule, offset));
+  }
+
+  // Records the field of the current table being verified, only if
+  // FLATBUFFERS_VERIFIER_DIAGNOSTICS is defined.
+  void VerifyingField(voffset_t field) const {
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+      if (!path_.empty()) path_.back().field = field;
+    #else
+      (void)field;
+    #endif
+    // clang-format on
+  }
+
   // Central location where any verification failures register.
   bool Check(bool ok) const {
     // clang-format off
@@ -2097,11 +2573,13 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
         upper_bound_ =  upper_bound;
     #endif
     // clang-format on
-    return Check(elem_len < size_ && elem <= size_ - elem_len);
+    return Check(elem_len < size_ && elem <= size_ - elem_len,
+                 "range not inside buffer", elem);
   }
 
   template<typename T> bool VerifyAlignment(size_t elem) const {
-    return (elem & (sizeof(T) - 1)) == 0 || !check_alignment_;
+    return Report((elem & (sizeof(T) - 1)) == 0 || !check_alignment_,
+                  "misaligned", elem);
   }
 
   // Verify a range indicated by sizeof(T).
@@ -2109,6 +2587,11 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     return VerifyAlignment<T>(elem) && Verify(elem, sizeof(T));
   }
 
+  // The offset in the buffer of a pointer into it.
+  size_t GetOffset(const uint8_t *p) const {
+    return static_cast<size_t>(p - buf_);
+  }
+
   // Verify relative to a known-good base pointer.
   bool Verify(const uint8_t *base, voffset_t elem_off, size_t elem_len) const {
     return Verify(static_cast<size_t>(base - buf_) + elem_off, elem_len);
@@ -2121,7 +2604,7 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
 
   // Verify a pointer (may be NULL) of a table type.
   template<typename T> bool VerifyTable(const T *table) {
-    return !table || table->Verify(*this);
+    return !table || lazy_ || table->Verify(*this);
   }
 
   // Verify a pointer (may be NULL) of any vector type.
@@ -2142,7 +2625,8 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
            (VerifyVectorOrString(reinterpret_cast<const uint8_t *>(str),
                                  1, &end) &&
             Verify(end, 1) &&      // Must have terminator
-            Check(buf_[end] == '\0'));  // Terminating byte must be 0.
+            Check(buf_[end] == '\0',  // Terminating byte must be 0.
+                  "string not zero terminated", end));
   }
 
   // Common code between vectors and strings.
@@ -2155,7 +2639,7 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     // must be 0.
     auto size = ReadScalar<uoffset_t>(vec);
     auto max_elems = FLATBUFFERS_MAX_BUFFER_SIZE / elem_size;
-    if (!Check(size < max_elems))
+    if (!Check(size < max_elems, "vector too large", veco))
       return false;  // Protect against byte_size overflowing.
     auto byte_size = sizeof(size) + elem_size * size;
     if (end) *end = veco + byte_size;
@@ -2165,16 +2649,74 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   // Special case for string contents, after the above has been called.
   bool VerifyVectorOfStrings(const Vector<Offset<String>> *vec) const {
     if (vec) {
-      for (uoffset_t i = 0; i < vec->size(); i++) {
+      uoffset_t i = 0;
+      for (; i + kStringBatchSize <= vec->size(); i += kStringBatchSize) {
+        if (VerifyStringBatch(vec->Data() + i * sizeof(uoffset_t))) continue;
+        // Something in this batch is off, find out what exactly.
+        for (auto j = i; j < i + kStringBatchSize; j++) {
+          if (!VerifyString(vec->Get(j))) return false;
+        }
+      }
+      for (; i < vec->size(); i++) {
         if (!VerifyString(vec->Get(i))) return false;
       }
     }
     return true;
   }
 
+  // Verify the strings referred to by a batch of kStringBatchSize offsets in
+  // one go. This does the same checks as VerifyString(), but folded into two
+  // bounds checks per string, and a single check of all terminators and
+  // update of upper_bound_ per batch. Only returns true if VerifyString()
+  // would for all of them; if not, the caller verifies the batch string by
+  // string, so failures go through Check().
+  bool VerifyStringBatch(const uint8_t *elems) const {
+    auto elemo = static_cast<size_t>(elems - buf_);
+    auto align_mask = check_alignment_ ? sizeof(uoffset_t) - 1 : 0;
+    // The offsets are in the buffer, so size_ >= sizeof(uoffset_t).
+    auto max_stro = size_ - sizeof(uoffset_t);
+    size_t bad = 0;
+    size_t upper_bound = 0;
+    for (size_t i = 0; i < kStringBatchSize; i++) {
+      auto o = ReadScalar<uoffset_t>(elems + i * sizeof(uoffset_t));
+      auto stro = elemo + i * sizeof(uoffset_t) + o;
+      // The size field must be in the buffer and aligned.
+      auto bad_stro =
+          (o >= size_) | (stro > max_stro) | ((stro & align_mask) != 0);
+      if (bad_stro) return false;
+      auto len = ReadScalar<uoffset_t>(buf_ + stro);
+      // The string and its terminator must be in the buffer.
+      auto end = stro + sizeof(uoffset_t) + len;
+      auto bad_end = (len >= size_) | (end >= size_);
+      if (bad_end) return false;
+      // Terminating byte must be 0.
+      bad |= buf_[end];
+      upper_bound = (std::max)(upper_bound, end + 1);
+    }
+    if (bad) return false;
+    // clang-format off
+    #ifdef FLATBUFFERS_TRACK_VERIFIER_BUFFER_SIZE
+      if (upper_bound_ < upper_bound)
+        upper_bound_ = upper_bound;
+    #endif
+    // clang-format on
+    (void)upper_bound;
+    return true;
+  }
+
   // Special case for table contents, after the above has been called.
   template<typename T> bool VerifyVectorOfTables(const Vector<Offset<T>> *vec) {
-    if (vec) {
+    if (vec && lazy_) {
+      // The tables are verified by Verified() when accessed, but that relies
+      // on their offsets pointing inside the buffer.
+      auto start = static_cast<size_t>(vec->Data() - buf_);
+      for (uoffset_t i = 0; i < vec->size(); i++) {
+        if (!VerifyOffset(start + i * sizeof(uoffset_t))) return false;
+      }
+    } else if (vec) {
+      if (parallel_for_ && vec->size() / 2 >= min_parallel_tables_) {
+        return VerifyVectorOfTablesInParallel(vec);
+      }
       for (uoffset_t i = 0; i < vec->size(); i++) {
         if (!vec->Get(i)->Verify(*this)) return false;
       }
@@ -2185,13 +2727,21 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   bool VerifyTableStart(const uint8_t *table) {
     // Check the vtable offset.
     auto tableo = static_cast<size_t>(table - buf_);
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+      PathElement elem = { static_cast<uoffset_t>(tableo), 0 };
+      path_.push_back(elem);
+    #endif
+    // clang-format on
     if (!Verify<soffset_t>(tableo)) return false;
     // This offset may be signed, but doing the substraction unsigned always
     // gives the result we want.
     auto vtableo = tableo - static_cast<size_t>(ReadScalar<soffset_t>(table));
     // Check the vtable size field, then check vtable fits in its entirety.
     return VerifyComplexity() && Verify<voffset_t>(vtableo) &&
-           VerifyAlignment<voffset_t>(ReadScalar<voffset_t>(buf_ + vtableo)) &&
+           Report((ReadScalar<voffset_t>(buf_ + vtableo) &
+                   (sizeof(voffset_t) - 1)) == 0 || !check_alignment_,
+                  "vtable size misaligned", vtableo) &&
            Verify(vtableo, ReadScalar<voffset_t>(buf_ + vtableo));
   }
 
@@ -2200,12 +2750,14 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     if (identifier &&
         (size_ < 2 * sizeof(flatbuffers::uoffset_t) ||
          !BufferHasIdentifier(buf_ + start, identifier))) {
-      return false;
+      return Report(false, "buffer identifier mismatch", start);
     }
 
     // Call T::Verify, which must be in the generated code for this type.
     auto o = VerifyOffset(start);
-    return o && reinterpret_cast<const T *>(buf_ + start + o)->Verify(*this)
+    if (!o) return false;
+    auto root = reinterpret_cast<const T *>(buf_ + start + o);
+    return (lazy_ ? Verified(root) != nullptr : root->Verify(*this))
     // clang-format off
     #ifdef FLATBUFFERS_TRACK_VERIFIER_BUFFER_SIZE
            && GetComputedSize()
@@ -2223,7 +2775,8 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
 
   template<typename T> bool VerifySizePrefixedBuffer(const char *identifier) {
     return Verify<uoffset_t>(0U) &&
-           ReadScalar<uoffset_t>(buf_) == size_ - sizeof(uoffset_t) &&
+           Report(ReadScalar<uoffset_t>(buf_) == size_ - sizeof(uoffset_t),
+                  "size prefix mismatch", 0) &&
            VerifyBufferFromStart<T>(identifier, sizeof(uoffset_t));
   }
 
@@ -2231,9 +2784,10 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     if (!Verify<uoffset_t>(start)) return 0;
     auto o = ReadScalar<uoffset_t>(buf_ + start);
     // May not point to itself.
-    if (!Check(o != 0)) return 0;
+    if (!Check(o != 0, "offset is 0", start)) return 0;
     // Can't wrap around / buffers are max 2GB.
-    if (!Check(static_cast<soffset_t>(o) >= 0)) return 0;
+    if (!Check(static_cast<soffset_t>(o) >= 0, "offset out of range", start))
+      return 0;
     // Must be inside the buffer to create a pointer from it (pointer outside
     // buffer is UB).
     if (!Verify(start + o, 1)) return 0;
@@ -2251,12 +2805,20 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   bool VerifyComplexity() {
     depth_++;
     num_tables_++;
-    return Check(depth_ <= max_depth_ && num_tables_ <= max_tables_);
+    return Check(depth_ <= max_depth_ && num_tables_ <= max_tables_,
+                 depth_ > max_depth_ ? "max depth exceeded"
+                                     : "max tables exceeded",
+                 0);
   }
 
   // Called at the end of a table to pop the depth count.
   bool EndTable() {
     depth_--;
+    // clang-format off
+    #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+      path_.pop_back();
+    #endif
+    // clang-format on
     return true;
   }
 
@@ -2286,6 +2848,99 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   uoffset_t max_tables_;
   mutable size_t upper_bound_;
   bool check_alignment_;
+  parallel_for_function_t parallel_for_;
+  uoffset_t min_parallel_tables_;
+  bool lazy_;
+  std::vector<uint8_t> verified_tables_;
+  // clang-format off
+  #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+    mutable const char *error_rule_;
+    mutable size_t error_offset_;
+    mutable std::vector<PathElement> path_;
+  #endif
+  // clang-format on
+
+  static const size_t kStringBatchSize = 16;
+  static const uoffset_t kMaxParallelTasks = 256;
+
+  // Tables start at a 4 byte aligned soffset_t, unless alignment isn't
+  // checked, in which case any byte may be the start of a different table.
+  size_t TableShift() const { return check_alignment_ ? 2 : 0; }
+
+  // A range of a vector of tables, verified as one parallel task.
+  template<typename T> struct TablesTask;
+
+  template<typename T>
+  bool VerifyVectorOfTablesInParallel(const Vector<Offset<T>> *vec) {
+    auto size = vec->size();
+    // Copy the constant, std::min would need its definition to bind to it.
+    auto max_tasks = kMaxParallelTasks;
+    auto num_tasks = (std::min)(size / min_parallel_tables_, max_tasks);
+    std::vector<TablesTask<T>> tasks;
+    tasks.reserve(num_tasks);
+    for (uoffset_t i = 0; i < num_tasks; i++) {
+      tasks.push_back(TablesTask<T>(*this, vec, size / num_tasks * i,
+                                    i + 1 < num_tasks
+                                        ? size / num_tasks * (i + 1)
+                                        : size));
+    }
+    auto context = flatbuffers::data(tasks);
+    // clang-format off
+    #ifdef FLATBUFFERS_CPP98_STL
+      parallel_for_(tasks.size(), &TablesTask<T>::Run, context);
+    #else
+      parallel_for_(tasks.size(),
+                    [context](size_t i) { TablesTask<T>::Run(context, i); });
+    #endif
+    // clang-format on
+    bool ok = true;
+    size_t num_tables = num_tables_;
+    for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+      // clang-format off
+      #ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+        if (ok && !it->ok) {
+          error_rule_ = it->verifier.error_rule_;
+          error_offset_ = it->verifier.error_offset_;
+          path_ = it->verifier.path_;
+        }
+      #endif
+      // clang-format on
+      ok = ok && it->ok;
+      num_tables += it->verifier.num_tables_;
+      upper_bound_ = (std::max)(upper_bound_, it->verifier.upper_bound_);
+    }
+    if (!ok) return false;
+    num_tables_ = static_cast<uoffset_t>(
+        (std::min)(num_tables, static_cast<size_t>(max_tables_) + 1));
+    return Check(num_tables_ <= max_tables_, "max tables exceeded", 0);
+  }
+};
+
+template<typename T> struct Verifier::TablesTask {
+  TablesTask(const Verifier &parent, const Vector<Offset<T>> *_vec,
+             uoffset_t _begin, uoffset_t _end)
+      : verifier(parent), vec(_vec), begin(_begin), end(_end), ok(false) {
+    // Count the tables in this task from 0, and only allow for as many as
+    // the parent has left. The totals are checked by the parent afterwards.
+    verifier.num_tables_ = 0;
+    verifier.max_tables_ = parent.max_tables_ - parent.num_tables_;
+    verifier.upper_bound_ = 0;
+    verifier.parallel_for_ = parallel_for_function_t();
+  }
+
+  static void Run(void *tasks, size_t i) {
+    auto &task = static_cast<TablesTask *>(tasks)[i];
+    task.ok = true;
+    for (auto j = task.begin; task.ok && j < task.end; j++) {
+      task.ok = task.vec->Get(j)->Verify(task.verifier);
+    }
+  }
+
+  Verifier verifier;
+  const Vector<Offset<T>> *vec;
+  uoffset_t begin;
+  uoffset_t end;
+  bool ok;
 };
 
 // Convenient way to bundle a buffer and its length, to pass it around
@@ -2413,6 +3068,7 @@ class Table {
   bool VerifyField(const Verifier &verifier, voffset_t field) const {
     // Calling GetOptionalFieldOffset should be safe now thanks to
     // VerifyTable().
+    verifier.VerifyingField(field);
     auto field_offset = GetOptionalFieldOffset(field);
     // Check the actual field.
     return !field_offset || verifier.Verify<T>(data_, field_offset);
@@ -2421,20 +3077,25 @@ class Table {
   // VerifyField for required fields.
   template<typename T>
   bool VerifyFieldRequired(const Verifier &verifier, voffset_t field) const {
+    verifier.VerifyingField(field);
     auto field_offset = GetOptionalFieldOffset(field);
-    return verifier.Check(field_offset != 0) &&
+    return verifier.Check(field_offset != 0, "required field missing",
+                          verifier.GetOffset(data_)) &&
            verifier.Verify<T>(data_, field_offset);
   }
 
   // Versions for offsets.
   bool VerifyOffset(const Verifier &verifier, voffset_t field) const {
+    verifier.VerifyingField(field);
     auto field_offset = GetOptionalFieldOffset(field);
     return !field_offset || verifier.VerifyOffset(data_, field_offset);
   }
 
   bool VerifyOffsetRequired(const Verifier &verifier, voffset_t field) const {
+    verifier.VerifyingField(field);
     auto field_offset = GetOptionalFieldOffset(field);
-    return verifier.Check(field_offset != 0) &&
+    return verifier.Check(field_offset != 0, "required field missing",
+                          verifier.GetOffset(data_)) &&
            verifier.VerifyOffset(data_, field_offset);
   }
 
@@ -76,13 +76,26 @@ class FlatCompiler {
   std::string GetUsageString(const char *program_name) const;
 
  private:
-  void ParseFile(flatbuffers::Parser &parser, const std::string &filename,
+  bool ParseFile(flatbuffers::Parser &parser, const std::string &filename,
                  const std::string &contents,
                  std::vector<const char *> &include_directories) const;
 
-  void LoadBinarySchema(Parser &parser, const std::string &filename,
+  bool LoadBinarySchema(Parser &parser, const std::string &filename,
                         const std::string &contents);
 
+  bool ParseJsonStreamFile(Parser &parser, const std::string &filename,
+                           const std::string &output_path) const;
+
+  // Returns false if the file had an error.
+  typedef std::function<bool(std::unique_ptr<Parser> &parser,
+                             size_t file_index)>
+      CompileFileFn;
+
+  // Compiles the files in [begin, end) with `jobs` threads, each with a copy
+  // of the schema in `parser`. Returns false if the schema can't be copied.
+  bool CompileInParallel(Parser &parser, size_t begin, size_t end, size_t jobs,
+                         const CompileFileFn &compile_file) const;
+
   void Warn(const std::string &warn, bool show_exe_name = true) const;
 
   void Error(const std::string &err, bool usage = true,
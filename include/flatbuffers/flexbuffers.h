@@ -309,6 +309,27 @@ class FixedTypedVector : public Object {
   uint8_t len_;
 };
 
+// Hash of a key in the hashed key index of a map (32 bit FNV-1a).
+// This is part of the binary format, so it must never change.
+inline uint32_t HashKey(const char *key) {
+  uint32_t hash = 0x811C9DC5;
+  for (auto c = key; *c; ++c) {
+    hash ^= static_cast<unsigned char>(*c);
+    hash *= 0x01000193;
+  }
+  return hash;
+}
+
+// Same, for a key of known length.
+inline uint32_t HashKey(const char *key, size_t len) {
+  uint32_t hash = 0x811C9DC5;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= static_cast<unsigned char>(key[i]);
+    hash *= 0x01000193;
+  }
+  return hash;
+}
+
 class Map : public Vector {
  public:
   Map(const uint8_t *data, uint8_t byte_width) : Vector(data, byte_width) {}
@@ -316,6 +337,11 @@ class Map : public Vector {
   Reference operator[](const char *key) const;
   Reference operator[](const std::string &key) const;
 
+  // Same as operator[], for a key whose `HashKey` is known ahead of time,
+  // e.g. because it is looked up in many maps. Maps without a hashed key
+  // index use a binary search, and ignore the hash.
+  Reference Find(const char *key, uint32_t hash) const;
+
   Vector Values() const { return Vector(data_, byte_width_); }
 
   TypedVector Keys() const {
@@ -327,6 +353,25 @@ class Map : public Vector {
                        FBT_KEY);
   }
 
+  // A map written with BUILDER_FLAG_INDEX_MAPS may have a hashed key index:
+  // an open addressing table of (index of the key + 1), 0 for empty slots,
+  // with a power of 2 number of slots, probed linearly from
+  // `HashKey(key) % size`.
+  // Its presence is flagged by the byte width of its elements in the
+  // second byte of the keys byte width field, which readers that don't know
+  // about the index ignore. The index itself is pointed to by one more
+  // prefixed field, before the offset to the keys.
+  bool HasKeyIndex() const { return KeyIndexWidth() != 0; }
+
+  TypedVector KeyIndex() const {
+    auto width = KeyIndexWidth();
+    if (!width) return TypedVector::EmptyTypedVector();
+    const size_t num_prefixed_fields = 4;
+    return TypedVector(
+        Indirect(data_ - byte_width_ * num_prefixed_fields, byte_width_),
+        width, FBT_UINT);
+  }
+
   static Map EmptyMap() {
     static const uint8_t empty_map[] = {
       0 /*keys_len*/, 0 /*keys_offset*/, 1 /*keys_width*/, 0 /*len*/
@@ -335,6 +380,17 @@ class Map : public Vector {
   }
 
   bool IsTheEmptyMap() const { return data_ == EmptyMap().data_; }
+
+ private:
+  uint8_t KeyIndexWidth() const {
+    if (byte_width_ < 2) return 0;
+    const size_t num_prefixed_fields = 2;
+    return static_cast<uint8_t>(
+        ReadUInt64(data_ - byte_width_ * num_prefixed_fields, byte_width_) >>
+        8);
+  }
+
+  size_t FindKey(const char *key, uint32_t hash) const;
 };
 
 template<typename T>
@@ -786,23 +842,80 @@ template<typename T> int KeyCompare(const void *key, const void *elem) {
   return strcmp(skey, str_elem);
 }
 
-inline Reference Map::operator[](const char *key) const {
+// Binary search of the sorted keys of a map, whose offsets are of type T.
+// Returns `size` if not found.
+template<typename T>
+size_t FindSortedKey(const uint8_t *keys, size_t size, const char *key) {
+  size_t lo = 0;
+  size_t hi = size;
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    auto elem =
+        reinterpret_cast<const char *>(Indirect<T>(keys + mid * sizeof(T)));
+    auto comp = strcmp(key, elem);
+    if (!comp) return mid;
+    if (comp < 0) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return size;
+}
+
+// Lookup through the hashed key index of a map (see Map::KeyIndex()).
+// Returns `size` if not found.
+template<typename T>
+size_t FindHashedKey(const uint8_t *keys, size_t size, const uint8_t *slots,
+                     size_t num_slots, uint8_t slot_width, const char *key,
+                     uint32_t hash) {
+  auto mask = num_slots - 1;
+  auto slot = hash & mask;
+  for (size_t probes = 0; probes < num_slots; probes++) {
+    auto i = ReadUInt64(slots + slot * slot_width, slot_width);
+    if (!i || i > size) return size;
+    auto elem = reinterpret_cast<const char *>(
+        Indirect<T>(keys + (i - 1) * sizeof(T)));
+    if (!strcmp(key, elem)) return static_cast<size_t>(i - 1);
+    slot = (slot + 1) & mask;
+  }
+  return size;
+}
+
+inline size_t Map::FindKey(const char *key, uint32_t hash) const {
   auto keys = Keys();
-  // We can't pass keys.byte_width_ to the comparison function, so we have
-  // to pick the right one ahead of time.
-  int (*comp)(const void *, const void *) = nullptr;
+  auto size = keys.size();
+  auto index = KeyIndex();
+  auto num_slots = index.size();
+  auto hashed = num_slots && !(num_slots & (num_slots - 1));
+  // Pick a lookup specialized for the width of the key offsets.
+  // clang-format off
+  #define FLEXBUFFERS_FIND_KEY(T) \
+    return hashed \
+        ? FindHashedKey<T>(keys.data_, size, index.data_, num_slots, \
+                           index.byte_width_, key, hash) \
+        : FindSortedKey<T>(keys.data_, size, key);
   switch (keys.byte_width_) {
-    case 1: comp = KeyCompare<uint8_t>; break;
-    case 2: comp = KeyCompare<uint16_t>; break;
-    case 4: comp = KeyCompare<uint32_t>; break;
-    case 8: comp = KeyCompare<uint64_t>; break;
-  }
-  auto res = std::bsearch(key, keys.data_, keys.size(), keys.byte_width_, comp);
-  if (!res) return Reference(nullptr, 1, NullPackedType());
-  auto i = (reinterpret_cast<uint8_t *>(res) - keys.data_) / keys.byte_width_;
+    case 1: FLEXBUFFERS_FIND_KEY(uint8_t)
+    case 2: FLEXBUFFERS_FIND_KEY(uint16_t)
+    case 4: FLEXBUFFERS_FIND_KEY(uint32_t)
+    case 8: FLEXBUFFERS_FIND_KEY(uint64_t)
+    default: return size;
+  }
+  #undef FLEXBUFFERS_FIND_KEY
+  // clang-format on
+}
+
+inline Reference Map::Find(const char *key, uint32_t hash) const {
+  auto i = FindKey(key, hash);
+  if (i >= size()) return Reference(nullptr, 1, NullPackedType());
   return (*static_cast<const Vector *>(this))[i];
 }
 
+inline Reference Map::operator[](const char *key) const {
+  return Find(key, HasKeyIndex() ? HashKey(key) : 0);
+}
+
 inline Reference Map::operator[](const std::string &key) const {
   return (*this)[key.c_str()];
 }
@@ -821,6 +934,240 @@ inline Reference GetRoot(const std::vector<uint8_t> &buffer) {
   return GetRoot(flatbuffers::vector_data(buffer), buffer.size());
 }
 
+// Checks that a FlexBuffer from an untrusted source can be accessed safely
+// from GetRoot(): every offset, byte width, size and type it contains must
+// stay inside the buffer, and strings and keys must be terminated.
+// Like flatbuffers::Verifier, it limits the depth of nesting, and the total
+// number of elements visited, which guards against buffers that refer to the
+// same vectors over and over. Values that are stored inline, typed vectors of
+// scalars, strings and keys all cost constant time to verify, so verification
+// costs a fraction of reading the buffer.
+class Verifier FLATBUFFERS_FINAL_CLASS {
+ public:
+  // `max_elements` defaults to the size of the buffer, which any buffer
+  // that doesn't refer to the same vector more than once stays under, as is
+  // the case for buffers from Builder (see SetTrackReuse() for others).
+  Verifier(const uint8_t *buf, size_t buf_len, size_t max_depth = 64,
+           size_t max_elements = 0, bool check_alignment = true)
+      : buf_(buf),
+        size_(buf_len),
+        keys_end_(0),
+        depth_(0),
+        max_depth_(max_depth),
+        num_elements_(0),
+        max_elements_(max_elements ? max_elements : buf_len),
+        check_alignment_(check_alignment) {}
+
+  // Verify vectors and maps that are referred to more than once only the
+  // first time, at the cost of a byte of memory per byte of buffer.
+  // Their elements then count once towards `max_elements`.
+  void SetTrackReuse(bool track) {
+    verified_.clear();
+    if (track) verified_.resize(size_, 0);
+  }
+
+  bool VerifyBuffer() {
+    // See GetRoot().
+    if (size_ < 3) return false;
+    auto byte_width = buf_[size_ - 1];
+    auto packed_type = buf_[size_ - 2];
+    if (!VerifyByteWidth(byte_width) || size_ - 2 < byte_width) return false;
+    auto root = size_ - 2 - byte_width;
+    if (!VerifyAlignment(root, byte_width)) return false;
+    // Reading a key stops at the first 0 byte at or after its start, so keys
+    // starting before the last 0 byte of the buffer are safe.
+    for (keys_end_ = size_; keys_end_ && buf_[keys_end_ - 1]; keys_end_--) {}
+    depth_ = 0;
+    num_elements_ = 0;
+    return VerifyRef(root, byte_width, packed_type);
+  }
+
+ private:
+  static bool VerifyByteWidth(size_t width) {
+    return width == 1 || width == 2 || width == 4 || width == 8;
+  }
+
+  bool VerifyAlignment(size_t elem, size_t width) const {
+    return (elem & (width - 1)) == 0 || !check_alignment_;
+  }
+
+  bool VerifyRange(size_t elem, size_t elem_len) const {
+    return elem_len <= size_ && elem <= size_ - elem_len;
+  }
+
+  // A value of `packed_type` in a slot of `parent_width` bytes at `elem`.
+  bool VerifyRef(size_t elem, uint8_t parent_width, uint8_t packed_type) {
+    return VerifyRef(elem, parent_width,
+                     static_cast<uint8_t>(1U << (packed_type & 3)),
+                     static_cast<Type>(packed_type >> 2));
+  }
+
+  bool VerifyRef(size_t elem, uint8_t parent_width, uint8_t byte_width,
+                 Type type) {
+    if (IsInline(type)) return true;
+    // Everything else is stored over an offset, back into the buffer.
+    size_t target;
+    return VerifyOffset(elem, parent_width, &target) &&
+           VerifyIndirect(target, byte_width, type);
+  }
+
+  bool VerifyOffset(size_t elem, uint8_t width, size_t *target) const {
+    // Offsets of 0 occur, e.g. for an empty map as root.
+    auto off = ReadUInt64(buf_ + elem, width);
+    if (off > elem) return false;
+    *target = elem - static_cast<size_t>(off);
+    return true;
+  }
+
+  // Checks the size field in front of `vec`, and that `size` elements of
+  // `elem_size` bytes follow.
+  bool VerifySized(size_t vec, uint8_t byte_width, size_t elem_size,
+                   size_t *size) const {
+    if (!VerifyByteWidth(byte_width) || !VerifyAlignment(vec, byte_width) ||
+        vec < byte_width) {
+      return false;
+    }
+    auto len = ReadUInt64(buf_ + vec - byte_width, byte_width);
+    if (len > (size_ - vec) / elem_size) return false;
+    *size = static_cast<size_t>(len);
+    return true;
+  }
+
+  bool VerifyIndirect(size_t target, uint8_t byte_width, Type type) {
+    size_t size;
+    switch (type) {
+      case FBT_KEY: return target < keys_end_;
+      case FBT_STRING:
+        // The terminator follows the string.
+        return VerifySized(target, byte_width, 1, &size) &&
+               size < size_ - target && !buf_[target + size];
+      case FBT_BLOB: return VerifySized(target, byte_width, 1, &size);
+      case FBT_INDIRECT_INT:
+      case FBT_INDIRECT_UINT:
+      case FBT_INDIRECT_FLOAT:
+        return VerifyByteWidth(byte_width) &&
+               VerifyAlignment(target, byte_width) &&
+               VerifyRange(target, byte_width);
+      case FBT_VECTOR_INT:
+      case FBT_VECTOR_UINT:
+      case FBT_VECTOR_FLOAT:
+      case FBT_VECTOR_BOOL:
+        return VerifySized(target, byte_width, byte_width, &size);
+      case FBT_VECTOR_INT2:
+      case FBT_VECTOR_UINT2:
+      case FBT_VECTOR_FLOAT2:
+      case FBT_VECTOR_INT3:
+      case FBT_VECTOR_UINT3:
+      case FBT_VECTOR_FLOAT3:
+      case FBT_VECTOR_INT4:
+      case FBT_VECTOR_UINT4:
+      case FBT_VECTOR_FLOAT4: {
+        uint8_t len = 0;
+        ToFixedTypedVectorElementType(type, &len);
+        return VerifyByteWidth(byte_width) &&
+               VerifyAlignment(target, byte_width) &&
+               VerifyRange(target, static_cast<size_t>(len) * byte_width);
+      }
+      case FBT_VECTOR:
+      case FBT_MAP:
+      case FBT_VECTOR_KEY:
+      case FBT_VECTOR_STRING: return VerifyVector(target, byte_width, type);
+      default: return false;
+    }
+  }
+
+  // Vectors whose elements need verifying themselves.
+  bool VerifyVector(size_t vec, uint8_t byte_width, Type type) {
+    auto typed = type == FBT_VECTOR_KEY || type == FBT_VECTOR_STRING;
+    size_t size;
+    if (!VerifySized(vec, byte_width, typed ? byte_width : byte_width + 1U,
+                     &size)) {
+      return false;
+    }
+    // Packed types are never 0 for vectors, so 0 means not verified yet.
+    auto bit_width = (byte_width >> 1) - (byte_width >> 3);  // 0, 1, 2, 3.
+    auto packed_type = static_cast<uint8_t>((type << 2) | bit_width);
+    if (!verified_.empty() && verified_[vec] == packed_type) return true;
+    num_elements_ += size + 1;
+    if (++depth_ > max_depth_ || num_elements_ > max_elements_) return false;
+    if (typed) {
+      auto elem_type = ToTypedVectorElementType(type);
+      for (size_t i = 0; i < size; i++) {
+        if (!VerifyRef(vec + i * byte_width, byte_width, 1, elem_type))
+          return false;
+      }
+    } else {
+      auto types = buf_ + vec + size * byte_width;
+      for (size_t i = 0; i < size; i++) {
+        if (!VerifyRef(vec + i * byte_width, byte_width, types[i]))
+          return false;
+      }
+      if (type == FBT_MAP && !VerifyMapKeys(vec, byte_width, size))
+        return false;
+    }
+    depth_--;
+    if (!verified_.empty()) verified_[vec] = packed_type;
+    return true;
+  }
+
+  // The keys of a map, and its key index if any (see Map::Keys() and
+  // Map::KeyIndex()), are found through the fields in front of its size.
+  bool VerifyMapKeys(size_t map, uint8_t byte_width, size_t size) {
+    if (map < 3U * byte_width) return false;
+    auto keys_width_field =
+        ReadUInt64(buf_ + map - 2 * byte_width, byte_width);
+    auto keys_width = static_cast<uint8_t>(keys_width_field);
+    size_t keys;
+    size_t num_keys;
+    if (!VerifyOffset(map - 3 * byte_width, byte_width, &keys) ||
+        !VerifyIndirect(keys, keys_width, FBT_VECTOR_KEY) ||
+        !VerifySized(keys, keys_width, keys_width, &num_keys) ||
+        num_keys != size) {
+      return false;
+    }
+    auto index_width =
+        byte_width < 2 ? 0 : static_cast<uint8_t>(keys_width_field >> 8);
+    if (!index_width) return true;
+    // The index is only read within its bounds, and its slots are checked
+    // against the number of keys when read.
+    size_t index;
+    return map >= 4U * byte_width &&
+           VerifyOffset(map - 4 * byte_width, byte_width, &index) &&
+           VerifyIndirect(index, index_width, FBT_VECTOR_UINT);
+  }
+
+  const uint8_t *buf_;
+  size_t size_;
+  size_t keys_end_;
+  size_t depth_;
+  size_t max_depth_;
+  size_t num_elements_;
+  size_t max_elements_;
+  bool check_alignment_;
+  std::vector<uint8_t> verified_;
+};
+
+inline bool VerifyBuffer(const uint8_t *buf, size_t buf_len) {
+  Verifier verifier(buf, buf_len);
+  return verifier.VerifyBuffer();
+}
+
+inline bool VerifyBuffer(const std::vector<uint8_t> &buf) {
+  return VerifyBuffer(flatbuffers::vector_data(buf), buf.size());
+}
+
+// Verifies the FlexBuffer in a field with the `flexbuffer` attribute, as part
+// of the generated Verify() of a FlatBuffers table. Null fields verify.
+// This is a template so this header doesn't need to include flatbuffers.h.
+template<typename FlatBuffersVerifier, typename ByteVector>
+bool VerifyNestedFlexBuffer(const ByteVector *nested,
+                            FlatBuffersVerifier &verifier) {
+  return !nested ||
+         verifier.Check(VerifyBuffer(nested->Data(), nested->size()),
+                        "flexbuffer does not verify",
+                        verifier.GetOffset(nested->Data()));
+}
+
 // Flags that configure how the Builder behaves.
 // The "Share" flags determine if the Builder automatically tries to pool
 // this type. Pooling can reduce the size of serialized data if there are
@@ -831,6 +1178,10 @@ inline Reference GetRoot(const std::vector<uint8_t> &buffer) {
 // Turn strings on if you expect many non-unique string values.
 // Additionally, sharing key vectors can save space if you have maps with
 // identical field populations.
+// BUILDER_FLAG_INDEX_MAPS adds a hashed key index to maps with at least
+// Builder::kMinIndexedMapSize keys, which makes looking up keys in large maps
+// faster, at the expense of space (see Map::KeyIndex()). Maps with an index
+// stay readable by code that doesn't know about it.
 enum BuilderFlag {
   BUILDER_FLAG_NONE = 0,
   BUILDER_FLAG_SHARE_KEYS = 1,
@@ -838,18 +1189,20 @@ enum BuilderFlag {
   BUILDER_FLAG_SHARE_KEYS_AND_STRINGS = 3,
   BUILDER_FLAG_SHARE_KEY_VECTORS = 4,
   BUILDER_FLAG_SHARE_ALL = 7,
+  BUILDER_FLAG_INDEX_MAPS = 8,
 };
 
 class Builder FLATBUFFERS_FINAL_CLASS {
  public:
+  // Smaller maps are searched about as fast without a hashed key index.
+  static const size_t kMinIndexedMapSize = 16;
+
   Builder(size_t initial_size = 256,
           BuilderFlag flags = BUILDER_FLAG_SHARE_KEYS)
       : buf_(initial_size),
         finished_(false),
         flags_(flags),
-        force_min_bit_width_(BIT_WIDTH_8),
-        key_pool(KeyOffsetCompare(buf_)),
-        string_pool(StringOffsetCompare(buf_)) {
+        force_min_bit_width_(BIT_WIDTH_8) {
     buf_.clear();
   }
 
@@ -872,6 +1225,7 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     force_min_bit_width_ = BIT_WIDTH_8;
     key_pool.clear();
     string_pool.clear();
+    unsorted_keys_.clear();
   }
 
   // All value constructing functions below have two versions: one that
@@ -945,18 +1299,29 @@ class Builder FLATBUFFERS_FINAL_CLASS {
   }
 
   size_t Key(const char *str, size_t len) {
-    auto sloc = buf_.size();
-    WriteBytes(str, len + 1);
+    size_t sloc;
     if (flags_ & BUILDER_FLAG_SHARE_KEYS) {
-      auto it = key_pool.find(sloc);
-      if (it != key_pool.end()) {
-        // Already in the buffer. Remove key we just serialized, and use
-        // existing offset instead.
-        buf_.resize(sloc);
-        sloc = *it;
-      } else {
-        key_pool.insert(sloc);
+      auto hash = HashKey(str, len);
+      // If already in the buffer, use the existing offset instead.
+      sloc = key_pool.Find(buf_, str, len, hash);
+      if (sloc == StringPool::kNotFound) {
+        sloc = buf_.size();
+        WriteBytes(str, len + 1);
+        key_pool.Insert(sloc, len, hash);
       }
+    } else {
+      sloc = buf_.size();
+      WriteBytes(str, len + 1);
+    }
+    // Remember keys that are out of order with the key pushed before them,
+    // so EndMap() only needs to sort maps that have any.
+    auto pos = stack_.size();
+    if (pos >= 2 && stack_[pos - 2].type_ == FBT_KEY &&
+        strcmp(reinterpret_cast<const char *>(flatbuffers::vector_data(buf_) +
+                                              stack_[pos - 2].u_),
+               reinterpret_cast<const char *>(flatbuffers::vector_data(buf_) +
+                                              sloc)) >= 0) {
+      unsorted_keys_.push_back(pos);
     }
     stack_.push_back(Value(static_cast<uint64_t>(sloc), FBT_KEY, BIT_WIDTH_8));
     return sloc;
@@ -966,20 +1331,18 @@ class Builder FLATBUFFERS_FINAL_CLASS {
   size_t Key(const std::string &str) { return Key(str.c_str(), str.size()); }
 
   size_t String(const char *str, size_t len) {
-    auto reset_to = buf_.size();
-    auto sloc = CreateBlob(str, len, 1, FBT_STRING);
-    if (flags_ & BUILDER_FLAG_SHARE_STRINGS) {
-      StringOffset so(sloc, len);
-      auto it = string_pool.find(so);
-      if (it != string_pool.end()) {
-        // Already in the buffer. Remove string we just serialized, and use
-        // existing offset instead.
-        buf_.resize(reset_to);
-        sloc = it->first;
-        stack_.back().u_ = sloc;
-      } else {
-        string_pool.insert(so);
-      }
+    if (!(flags_ & BUILDER_FLAG_SHARE_STRINGS)) {
+      return CreateBlob(str, len, 1, FBT_STRING);
+    }
+    auto hash = HashKey(str, len);
+    auto sloc = string_pool.Find(buf_, str, len, hash);
+    if (sloc == StringPool::kNotFound) {
+      sloc = CreateBlob(str, len, 1, FBT_STRING);
+      string_pool.Insert(sloc, len, hash);
+    } else {
+      // Already in the buffer, use the existing offset instead.
+      stack_.push_back(
+          Value(static_cast<uint64_t>(sloc), FBT_STRING, WidthU(len)));
     }
     return sloc;
   }
@@ -1032,6 +1395,7 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     auto vec = CreateVector(start, stack_.size() - start, 1, typed, fixed);
     // Remove temp elements and return vector.
     stack_.resize(start);
+    ForgetUnsortedKeys(start);
     stack_.push_back(vec);
     return static_cast<size_t>(vec.u_);
   }
@@ -1052,37 +1416,42 @@ class Builder FLATBUFFERS_FINAL_CLASS {
       Value key;
       Value val;
     };
+    // Key() tracked which keys came out of order, if none of them (apart
+    // from the first one, which is compared to whatever came before the
+    // map) are in this map, it is sorted already.
+    auto sorted = unsorted_keys_.empty() || unsorted_keys_.back() <= start;
+    ForgetUnsortedKeys(start);
     // TODO(wvo): strict aliasing?
-    // TODO(wvo): allow the caller to indicate the data is already sorted
-    // for maximum efficiency? With an assert to check sortedness to make sure
-    // we're not breaking binary search.
-    // Or, we can track if the map is sorted as keys are added which would be
-    // be quite cheap (cheaper than checking it here), so we can skip this
-    // step automatically when appliccable, and encourage people to write in
-    // sorted fashion.
-    // std::sort is typically already a lot faster on sorted data though.
     auto dict =
         reinterpret_cast<TwoValue *>(flatbuffers::vector_data(stack_) + start);
-    std::sort(dict, dict + len,
-              [&](const TwoValue &a, const TwoValue &b) -> bool {
-                auto as = reinterpret_cast<const char *>(
-                    flatbuffers::vector_data(buf_) + a.key.u_);
-                auto bs = reinterpret_cast<const char *>(
-                    flatbuffers::vector_data(buf_) + b.key.u_);
-                auto comp = strcmp(as, bs);
-                // If this assertion hits, you've added two keys with the same
-                // value to this map.
-                // TODO: Have to check for pointer equality, as some sort
-                // implementation apparently call this function with the same
-                // element?? Why?
-                FLATBUFFERS_ASSERT(comp || &a == &b);
-                return comp < 0;
-              });
+    if (!sorted) {
+      std::sort(dict, dict + len,
+                [&](const TwoValue &a, const TwoValue &b) -> bool {
+                  auto as = reinterpret_cast<const char *>(
+                      flatbuffers::vector_data(buf_) + a.key.u_);
+                  auto bs = reinterpret_cast<const char *>(
+                      flatbuffers::vector_data(buf_) + b.key.u_);
+                  auto comp = strcmp(as, bs);
+                  // If this assertion hits, you've added two keys with the
+                  // same value to this map.
+                  // TODO: Have to check for pointer equality, as some sort
+                  // implementation apparently call this function with the
+                  // same element?? Why?
+                  FLATBUFFERS_ASSERT(comp || &a == &b);
+                  return comp < 0;
+                });
+    }
     // First create a vector out of all keys.
     // TODO(wvo): if kBuilderFlagShareKeyVectors is true, see if we can share
     // the first vector.
     auto keys = CreateVector(start, len, 2, true, false);
-    auto vec = CreateVector(start + 1, len, 2, false, false, &keys);
+    Value vec;
+    if ((flags_ & BUILDER_FLAG_INDEX_MAPS) && len >= kMinIndexedMapSize) {
+      auto key_index = CreateKeyIndex(start, len);
+      vec = CreateVector(start + 1, len, 2, false, false, &keys, &key_index);
+    } else {
+      vec = CreateVector(start + 1, len, 2, false, false, &keys);
+    }
     // Remove temp elements and return map.
     stack_.resize(start);
     stack_.push_back(vec);
@@ -1420,6 +1789,7 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     // TODO: instead of asserting, could write vector with larger elements
     // instead, though that would be wasteful.
     FLATBUFFERS_ASSERT(WidthU(len) <= bit_width);
+    Align(bit_width);
     if (!fixed) Write<uint64_t>(len, byte_width);
     auto vloc = buf_.size();
     for (size_t i = 0; i < len; i++) Write(elems[i], byte_width);
@@ -1429,16 +1799,49 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     return vloc;
   }
 
+  // Writes the hashed key index (see Map::KeyIndex()) for the sorted keys
+  // of a map on the stack.
+  Value CreateKeyIndex(size_t start, size_t len) {
+    size_t num_slots = 1;
+    while (num_slots < len * 2) num_slots *= 2;
+    auto mask = num_slots - 1;
+    auto slots_start = stack_.size();
+    stack_.resize(slots_start + num_slots,
+                  Value(static_cast<uint64_t>(0), FBT_UINT, BIT_WIDTH_8));
+    for (size_t i = 0; i < len; i++) {
+      auto key = reinterpret_cast<const char *>(
+          flatbuffers::vector_data(buf_) + stack_[start + i * 2].u_);
+      auto slot = HashKey(key) & mask;
+      while (stack_[slots_start + slot].u_) slot = (slot + 1) & mask;
+      auto key_number = static_cast<uint64_t>(i + 1);
+      stack_[slots_start + slot] =
+          Value(key_number, FBT_UINT, WidthU(key_number));
+    }
+    auto key_index = CreateVector(slots_start, num_slots, 1, true, false);
+    stack_.resize(slots_start);
+    return key_index;
+  }
+
   Value CreateVector(size_t start, size_t vec_len, size_t step, bool typed,
-                     bool fixed, const Value *keys = nullptr) {
+                     bool fixed, const Value *keys = nullptr,
+                     const Value *key_index = nullptr) {
     FLATBUFFERS_ASSERT(!fixed || typed); // typed=false, fixed=true combination is not supported.
     // Figure out smallest bit width we can store this vector with.
     auto bit_width = (std::max)(force_min_bit_width_, WidthU(vec_len));
     auto prefix_elems = 1;
+    if (key_index) {
+      // Maps with a key index are prefixed with an offset to it, which is
+      // flagged in the second byte of the keys byte width field, so they
+      // need at least 16 bits.
+      bit_width = (std::max)(bit_width, BIT_WIDTH_16);
+      bit_width = (std::max)(bit_width, key_index->ElemWidth(buf_.size(), 0));
+      prefix_elems += 1;
+    }
     if (keys) {
       // If this vector is part of a map, we will pre-fix an offset to the keys
       // to this vector.
-      bit_width = (std::max)(bit_width, keys->ElemWidth(buf_.size(), 0));
+      bit_width = (std::max)(bit_width,
+                             keys->ElemWidth(buf_.size(), key_index ? 1 : 0));
       prefix_elems += 2;
     }
     Type vector_type = FBT_KEY;
@@ -1461,9 +1864,12 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     FLATBUFFERS_ASSERT(!fixed || IsTypedVectorElementType(vector_type));
     auto byte_width = Align(bit_width);
     // Write vector. First the keys width/offset if available, and size.
+    if (key_index) WriteOffset(key_index->u_, byte_width);
     if (keys) {
       WriteOffset(keys->u_, byte_width);
-      Write<uint64_t>(1ULL << keys->min_bit_width_, byte_width);
+      auto keys_width = 1ULL << keys->min_bit_width_;
+      if (key_index) keys_width |= (1ULL << key_index->min_bit_width_) << 8;
+      Write<uint64_t>(keys_width, byte_width);
     }
     if (!fixed) Write<uint64_t>(vec_len, byte_width);
     // Then the actual data.
@@ -1497,36 +1903,84 @@ class Builder FLATBUFFERS_FINAL_CLASS {
 
   BitWidth force_min_bit_width_;
 
-  struct KeyOffsetCompare {
-    explicit KeyOffsetCompare(const std::vector<uint8_t> &buf) : buf_(&buf) {}
-    bool operator()(size_t a, size_t b) const {
-      auto stra =
-          reinterpret_cast<const char *>(flatbuffers::vector_data(*buf_) + a);
-      auto strb =
-          reinterpret_cast<const char *>(flatbuffers::vector_data(*buf_) + b);
-      return strcmp(stra, strb) < 0;
+  // Keys or strings already in buf_, for BUILDER_FLAG_SHARE_KEYS and
+  // BUILDER_FLAG_SHARE_STRINGS: an open addressing hash table of their
+  // offsets, which keeps its memory across Clear().
+  class StringPool {
+   public:
+    static const size_t kNotFound = static_cast<size_t>(-1);
+
+    StringPool() : size_(0) {}
+
+    // Returns the offset of a string equal to `str` in `buf`, or kNotFound.
+    size_t Find(const std::vector<uint8_t> &buf, const char *str, size_t len,
+                uint32_t hash) const {
+      if (slots_.empty()) return kNotFound;
+      auto mask = slots_.size() - 1;
+      for (auto i = hash & mask;; i = (i + 1) & mask) {
+        auto &slot = slots_[i];
+        if (!slot.offset_plus_one) return kNotFound;
+        if (slot.hash == hash && slot.len == len &&
+            !memcmp(flatbuffers::vector_data(buf) + slot.offset_plus_one - 1,
+                    str, len)) {
+          return slot.offset_plus_one - 1;
+        }
+      }
+    }
+
+    void Insert(size_t offset, size_t len, uint32_t hash) {
+      // Keep at least half of the slots empty.
+      if ((size_ + 1) * 2 > slots_.size()) Grow();
+      Slot slot = { offset + 1, len, hash };
+      Place(slot);
+      size_++;
     }
-    const std::vector<uint8_t> *buf_;
-  };
 
-  typedef std::pair<size_t, size_t> StringOffset;
-  struct StringOffsetCompare {
-    explicit StringOffsetCompare(const std::vector<uint8_t> &buf) : buf_(&buf) {}
-    bool operator()(const StringOffset &a, const StringOffset &b) const {
-      auto stra = reinterpret_cast<const char *>(
-          flatbuffers::vector_data(*buf_) + a.first);
-      auto strb = reinterpret_cast<const char *>(
-          flatbuffers::vector_data(*buf_) + b.first);
-      return strncmp(stra, strb, (std::min)(a.second, b.second) + 1) < 0;
+    void clear() {
+      if (!size_) return;
+      std::fill(slots_.begin(), slots_.end(), Slot());
+      size_ = 0;
     }
-    const std::vector<uint8_t> *buf_;
+
+   private:
+    struct Slot {
+      size_t offset_plus_one;  // 0 if empty.
+      size_t len;
+      uint32_t hash;
+    };
+
+    void Grow() {
+      std::vector<Slot> old_slots(
+          (std::max)(slots_.size() * 2, static_cast<size_t>(64)));
+      old_slots.swap(slots_);
+      for (auto it = old_slots.begin(); it != old_slots.end(); ++it) {
+        if (it->offset_plus_one) Place(*it);
+      }
+    }
+
+    void Place(const Slot &slot) {
+      auto mask = slots_.size() - 1;
+      auto i = slot.hash & mask;
+      while (slots_[i].offset_plus_one) i = (i + 1) & mask;
+      slots_[i] = slot;
+    }
+
+    std::vector<Slot> slots_;
+    size_t size_;
   };
 
-  typedef std::set<size_t, KeyOffsetCompare> KeyOffsetMap;
-  typedef std::set<StringOffset, StringOffsetCompare> StringOffsetMap;
+  // When the stack shrinks to `start`, out of order keys above it are gone.
+  void ForgetUnsortedKeys(size_t start) {
+    while (!unsorted_keys_.empty() && unsorted_keys_.back() >= start) {
+      unsorted_keys_.pop_back();
+    }
+  }
 
-  KeyOffsetMap key_pool;
-  StringOffsetMap string_pool;
+  StringPool key_pool;
+  StringPool string_pool;
+  // Stack positions of keys that sort before (or equal to) the key two
+  // positions below them, in increasing order.
+  std::vector<size_t> unsorted_keys_;
 };
 
 }  // namespace flexbuffers
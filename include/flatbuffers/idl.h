@@ -180,10 +180,22 @@ struct Type {
 struct Value {
   Value()
       : constant("0"),
-        offset(static_cast<voffset_t>(~(static_cast<voffset_t>(0U)))) {}
+        offset(static_cast<voffset_t>(~(static_cast<voffset_t>(0U)))),
+        has_scalar(false) {
+    scalar.u = 0;
+  }
   Type type;
   std::string constant;
   voffset_t offset;
+  // For scalar types, `constant` converted to `type` once `has_scalar` is
+  // set, so serializing doesn't have to convert it again.
+  union {
+    int64_t i;   // Signed integers.
+    uint64_t u;  // Unsigned integers and bools.
+    float f;
+    double d;
+  } scalar;
+  bool has_scalar;
 };
 
 // Helper class that retains the original order of a set of identifiers and
@@ -199,6 +211,7 @@ template<typename T> class SymbolTable {
     auto it = dict.find(name);
     if (it != dict.end()) return true;
     dict[name] = e;
+    ClearIndex();
     return false;
   }
 
@@ -208,19 +221,122 @@ template<typename T> class SymbolTable {
       auto obj = it->second;
       dict.erase(it);
       dict[newname] = obj;
+      ClearIndex();
     } else {
       FLATBUFFERS_ASSERT(false);
     }
   }
 
   T *Lookup(const std::string &name) const {
+    if (!index_.empty()) return Lookup(name.c_str(), name.length());
     auto it = dict.find(name);
     return it == dict.end() ? nullptr : it->second;
   }
 
+  T *Lookup(const char *name, size_t len) const {
+    if (index_.empty()) return Lookup(std::string(name, len));
+    auto hash = HashName(name, len);
+    auto bucket = hash & (displacements_.size() - 1);
+    auto &slot = index_[IndexOf(hash, displacements_[bucket])];
+    return slot.name && slot.name->length() == len &&
+                   !memcmp(slot.name->c_str(), name, len)
+               ? slot.value
+               : nullptr;
+  }
+
+  // Builds a perfect hash index over the current names, so that Lookup()
+  // costs one hash and one string compare rather than a walk down `dict`.
+  // The parser calls this once a schema is complete. Add() and Move() drop
+  // the index again; code that changes `dict` directly must call
+  // ClearIndex() itself.
+  void BuildIndex() {
+    if (!index_.empty() || dict.empty()) return;
+    // Names are hashed into buckets of about 4, and each bucket gets a
+    // displacement that moves all of its names into free slots of an index
+    // that is at most half full. Placing the largest buckets first makes
+    // this take only a few tries per bucket.
+    size_t num_buckets = 1;
+    while (num_buckets * 4 < dict.size()) num_buckets *= 2;
+    size_t capacity = 8;
+    while (capacity < dict.size() * 2) capacity *= 2;
+    std::vector<std::vector<uint32_t>> hashes(num_buckets);
+    std::vector<std::vector<IndexSlot>> buckets(num_buckets);
+    size_t max_bucket_size = 0;
+    for (auto it = dict.begin(); it != dict.end(); ++it) {
+      auto hash = HashName(it->first.c_str(), it->first.length());
+      auto bucket = hash & (num_buckets - 1);
+      IndexSlot slot = { &it->first, it->second };
+      hashes[bucket].push_back(hash);
+      buckets[bucket].push_back(slot);
+      max_bucket_size = (std::max)(max_bucket_size, buckets[bucket].size());
+    }
+    IndexSlot empty = { nullptr, nullptr };
+    index_.assign(capacity, empty);
+    displacements_.assign(num_buckets, 0);
+    for (auto size = max_bucket_size; size; size--) {
+      for (size_t bucket = 0; bucket < num_buckets; bucket++) {
+        if (buckets[bucket].size() != size) continue;
+        if (!PlaceBucket(hashes[bucket], buckets[bucket],
+                         &displacements_[bucket])) {
+          // Only happens if names have identical hashes: `dict` will do.
+          ClearIndex();
+          return;
+        }
+      }
+    }
+  }
+
+  void ClearIndex() {
+    index_.clear();
+    displacements_.clear();
+  }
+
  public:
   std::map<std::string, T *> dict;  // quick lookup
   std::vector<T *> vec;             // Used to iterate in order of insertion
+
+ private:
+  struct IndexSlot {
+    const std::string *name;  // Key in `dict`.
+    T *value;
+  };
+
+  static uint32_t HashName(const char *name, size_t len) {
+    return HashBytes(reinterpret_cast<const uint8_t *>(name), len);
+  }
+
+  size_t IndexOf(uint32_t hash, uint32_t displacement) const {
+    // Mix in the displacement with the finalizer of MurmurHash3.
+    auto h = hash ^ (displacement * 0x9e3779b9);
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h & (index_.size() - 1);
+  }
+
+  bool PlaceBucket(const std::vector<uint32_t> &hashes,
+                   const std::vector<IndexSlot> &slots,
+                   uint32_t *displacement) {
+    for (uint32_t d = 0; d < 0x10000; d++) {
+      size_t placed = 0;
+      for (; placed < slots.size(); placed++) {
+        auto &slot = index_[IndexOf(hashes[placed], d)];
+        if (slot.name) break;
+        slot = slots[placed];
+      }
+      if (placed == slots.size()) {
+        *displacement = d;
+        return true;
+      }
+      while (placed--) index_[IndexOf(hashes[placed], d)].name = nullptr;
+    }
+    return false;
+  }
+
+  std::vector<IndexSlot> index_;         // Size is 0 or a power of 2.
+  std::vector<uint32_t> displacements_;  // Per bucket, size a power of 2.
 };
 
 // A name space, as set in the schema.
@@ -440,6 +556,12 @@ struct EnumDef : public Definition {
     return vals.Lookup(enum_name);
   }
 
+  const EnumVal *Lookup(const char *enum_name, size_t len) const {
+    return vals.Lookup(enum_name, len);
+  }
+
+  void BuildIndex() { vals.BuildIndex(); }
+
   bool is_union;
   // Type is a union which uses type aliases where at least one type is
   // available under two different names.
@@ -508,6 +630,7 @@ struct IDLOptions {
   std::string cpp_object_api_pointer_type;
   std::string cpp_object_api_string_type;
   bool cpp_object_api_string_flexible_constructor;
+  bool cpp_object_api_allocator;
   bool gen_nullable;
   bool gen_generated;
   std::string object_prefix;
@@ -587,6 +710,7 @@ struct IDLOptions {
         gen_compare(false),
         cpp_object_api_pointer_type("std::unique_ptr"),
         cpp_object_api_string_flexible_constructor(false),
+        cpp_object_api_allocator(false),
         gen_nullable(false),
         gen_generated(false),
         object_suffix("T"),
@@ -757,6 +881,27 @@ class Parser : public ParserState {
   bool Parse(const char *_source, const char **include_paths = nullptr,
              const char *source_filename = nullptr);
 
+  // clang-format off
+  #ifndef FLATBUFFERS_CPP98_STL
+  // Reads `size` bytes at most into `buf`, returns how many were read, or 0
+  // at the end of the input.
+  typedef std::function<size_t(char *buf, size_t size)> JsonStreamReader;
+  // Receives a finished buffer, returns false to stop the stream.
+  typedef std::function<bool(const uint8_t *buf, size_t size)>
+      JsonStreamSink;
+
+  // Parses newline delimited JSON (one object of the root type per line)
+  // incrementally from `reader`, so memory use is bounded by the longest
+  // line rather than the input. Each object is built as a size prefixed
+  // FlatBuffer in builder_, which is passed to `sink` and then reused for the
+  // next object. Blank lines are skipped. A schema must have been parsed
+  // first. On error, error_ names the offending line of the stream.
+  bool ParseJsonStream(const JsonStreamReader &reader,
+                       const JsonStreamSink &sink,
+                       const char *source_filename = nullptr);
+  #endif  // !FLATBUFFERS_CPP98_STL
+  // clang-format on
+
   // Set the root type. May override the one set in the schema.
   bool SetRootType(const char *name);
 
@@ -876,11 +1021,14 @@ class Parser : public ParserState {
                                            const char **include_paths,
                                            const char *source_filename,
                                            const char *include_filename);
+  FLATBUFFERS_CHECKED_ERROR ParseJsonStreamLine(const char *line,
+                                                int line_number);
   FLATBUFFERS_CHECKED_ERROR CheckClash(std::vector<FieldDef*> &fields,
                                        StructDef *struct_def,
                                        const char *suffix,
                                        BaseType baseType);
 
+  void BuildLookupIndices();
   bool SupportsAdvancedUnionFeatures() const;
   bool SupportsAdvancedArrayFeatures() const;
   Namespace *UniqueNamespace(Namespace *ns);
@@ -935,6 +1083,8 @@ extern std::string MakeCamel(const std::string &in, bool first = true);
 // strict_json adds "quotes" around field names if true.
 // If the flatbuffer cannot be encoded in JSON (e.g., it contains non-UTF-8
 // byte arrays in String values), returns false.
+// The text is appended to `text`: clearing and passing the same string for
+// each buffer reuses its memory, and generation itself doesn't allocate.
 extern bool GenerateTextFromTable(const Parser &parser,
                                   const void *table,
                                   const std::string &tablename,
@@ -953,6 +1103,12 @@ extern bool GenerateBinary(const Parser &parser,
                            const std::string &path,
                            const std::string &file_name);
 
+// The name of the file GenerateBinary writes to.
+// See idl_gen_general.cpp.
+extern std::string BinaryFileName(const Parser &parser,
+                                  const std::string &path,
+                                  const std::string &file_name);
+
 // Generate a C++ header from the definitions in the Parser object.
 // See idl_gen_cpp.
 extern bool GenerateCPP(const Parser &parser,
@@ -0,0 +1,627 @@
+/*
+ * Copyright 2019 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_JSON_PRINTER_H_
+#define FLATBUFFERS_JSON_PRINTER_H_
+
+#include <algorithm>
+
+#include "flatbuffers/idl.h"
+#include "flatbuffers/util.h"
+
+namespace flatbuffers {
+
+// JsonPrinter generates the same text as `GenerateText`, but only needs a
+// binary schema (.bfbs) instead of a `Parser`, and is meant for converting
+// many buffers of the same schema.
+//
+// `Compile` flattens every table and struct of the schema into an array of
+// field instructions (vtable offset, kind, key text already rendered for the
+// options in use, enum / object references), which `Print` then runs through
+// for each buffer, without looking at the schema again.
+//
+// For bit_flags enums, nested_flatbuffer and flexbuffer fields to be printed
+// like `GenerateText` does, the schema must have been written with
+// `--bfbs-builtins`.
+// Vectors of unions aren't supported: schemas with them compile, but `Print`
+// fails for buffers where such a field is present.
+// The printer doesn't refer to the schema after compiling, and `Print` may be
+// called concurrently from multiple threads.
+//
+// Example:
+//   flatbuffers::JsonPrinter printer;
+//   if (!printer.Compile(bfbs.data(), bfbs.size(), opts)) ...
+//   std::string json;
+//   printer.Print(buf, &json);
+class JsonPrinter {
+ public:
+  JsonPrinter()
+      : root_(-1),
+        schema_objects_(nullptr),
+        newline_(true),
+        indent_step_(0),
+        strict_json_(false),
+        output_enum_identifiers_(true),
+        output_default_scalars_(false),
+        protobuf_ascii_alike_(false),
+        allow_non_utf8_(false),
+        natural_utf8_(false),
+        size_prefixed_(false) {}
+
+  // Verify the binary schema and compile it. Returns false on a corrupt
+  // schema, or one without a root_type.
+  bool Compile(const uint8_t *bfbs, size_t length,
+               const IDLOptions &opts = IDLOptions()) {
+    Verifier verifier(bfbs, length);
+    if (!reflection::VerifySchemaBuffer(verifier)) {
+      error_ = "invalid binary schema";
+      return false;
+    }
+    return Compile(*reflection::GetSchema(bfbs), opts);
+  }
+
+  bool Compile(const reflection::Schema &schema,
+               const IDLOptions &opts = IDLOptions()) {
+    Clear();
+    newline_ = opts.indent_step >= 0;
+    indent_step_ = std::max(opts.indent_step, 0);
+    strict_json_ = opts.strict_json;
+    output_enum_identifiers_ = opts.output_enum_identifiers;
+    output_default_scalars_ = opts.output_default_scalars_in_json;
+    protobuf_ascii_alike_ = opts.protobuf_ascii_alike;
+    allow_non_utf8_ = opts.allow_non_utf8;
+    natural_utf8_ = opts.natural_utf8;
+    size_prefixed_ = opts.size_prefixed;
+    auto objects = schema.objects();
+    auto enums = schema.enums();
+    schema_objects_ = objects;
+    for (uoffset_t i = 0; i < enums->size(); i++) {
+      CompileEnum(*enums->Get(i));
+    }
+    for (uoffset_t i = 0; i < objects->size(); i++) {
+      if (!CompileObject(*objects->Get(i))) {
+        auto error = error_;
+        Clear();
+        error_ = error;
+        return false;
+      }
+      if (objects->Get(i) == schema.root_table()) root_ = static_cast<int>(i);
+    }
+    schema_objects_ = nullptr;
+    if (root_ < 0) {
+      Clear();
+      error_ = "schema has no root_type";
+      return false;
+    }
+    return true;
+  }
+
+  bool IsCompiled() const { return root_ >= 0; }
+
+  // Human readable reason of the last failing `Compile`.
+  const std::string &GetError() const { return error_; }
+
+  // Append the text for a buffer whose root is the schema's root_type.
+  bool Print(const void *flatbuffer, std::string *text) const {
+    FLATBUFFERS_ASSERT(IsCompiled());
+    if (!IsCompiled()) return false;
+    text->reserve(text->size() + 1024);  // Reduce amount of reallocs.
+    auto root = size_prefixed_ ? GetSizePrefixedRoot<Table>(flatbuffer)
+                               : GetRoot<Table>(flatbuffer);
+    if (!PrintObject(root_, reinterpret_cast<const uint8_t *>(root), 0,
+                     text)) {
+      return false;
+    }
+    if (newline_) *text += '\n';
+    return true;
+  }
+
+ private:
+  enum {
+    kDeprecated = 1,
+    kFlexBuffer = 2,
+    kNestedFlatBuffer = 4,
+    kUnsupported = 8,  // Printing fails if the field is present.
+  };
+
+  // One field of a table or struct.
+  struct Op {
+    uint32_t key;  // Offset of the rendered key in strings_.
+    uint32_t key_length;
+    voffset_t offset;  // Into the vtable for tables, or into the struct.
+    uint8_t kind;      // reflection::BaseType.
+    uint8_t element;   // For vectors and arrays.
+    uint8_t flags;
+    uint16_t fixed_length;  // For arrays.
+    // Enum for scalars and unions, object for tables, structs, nested
+    // flatbuffers and their vectors, -1 if none.
+    int target;
+    union {
+      int64_t i;
+      double f;
+    } default_value;
+  };
+
+  struct Object {
+    size_t begin;  // Range of ops_.
+    size_t end;
+    bool is_struct;
+    size_t bytesize;
+  };
+
+  struct EnumValue {
+    int64_t value;
+    uint32_t name;  // Offset of the name in strings_.
+    uint32_t name_length;
+    // Object index of this union member, -1 if none (or a string member).
+    int union_object;
+    bool union_string;
+  };
+
+  struct Enum {
+    std::vector<EnumValue> values;  // In order of their values.
+    bool dense;                     // values[i].value == values[0].value + i.
+    bool bit_flags;
+  };
+
+  void Clear() {
+    root_ = -1;
+    error_.clear();
+    ops_.clear();
+    objects_.clear();
+    enums_.clear();
+    strings_.clear();
+  }
+
+  uint32_t AddString(const std::string &s) {
+    auto offset = static_cast<uint32_t>(strings_.size());
+    strings_ += s;
+    return offset;
+  }
+
+  static bool HasAttribute(
+      const Vector<Offset<reflection::KeyValue>> *attributes,
+      const char *key) {
+    return attributes && attributes->LookupByKey(key);
+  }
+
+  void CompileEnum(const reflection::Enum &enum_def) {
+    Enum e;
+    e.bit_flags = HasAttribute(enum_def.attributes(), "bit_flags");
+    auto values = enum_def.values();
+    for (uoffset_t i = 0; i < values->size(); i++) {
+      auto ev = values->Get(i);
+      EnumValue v;
+      v.value = ev->value();
+      v.name = AddString(ev->name()->str());
+      v.name_length = ev->name()->size();
+      v.union_object = -1;
+      v.union_string = false;
+      if (auto union_type = ev->union_type()) {
+        if (union_type->base_type() == reflection::Obj) {
+          v.union_object = union_type->index();
+        } else if (union_type->base_type() == reflection::String) {
+          v.union_string = true;
+        }
+      } else if (ev->object()) {
+        v.union_object = LookupObject(ev->object()->name()->c_str());
+      }
+      e.values.push_back(v);
+    }
+    e.dense = e.values.empty() ||
+              static_cast<uint64_t>(e.values.back().value) -
+                      static_cast<uint64_t>(e.values.front().value) ==
+                  e.values.size() - 1;
+    enums_.push_back(e);
+  }
+
+  int LookupObject(const char *name) const {
+    auto objects = schema_objects_;
+    if (!objects) return -1;
+    auto object = objects->LookupByKey(name);
+    if (!object) return -1;
+    for (uoffset_t i = 0; i < objects->size(); i++) {
+      if (objects->Get(i) == object) return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  // The nested_flatbuffer attribute holds a type name relative to the
+  // namespace of the table that declares it.
+  int LookupNestedObject(const std::string &object_name,
+                         const std::string &name) const {
+    auto ns = object_name;
+    for (;;) {
+      auto dot = ns.find_last_of('.');
+      ns = dot == std::string::npos ? "" : ns.substr(0, dot);
+      auto index = LookupObject((ns.empty() ? name : ns + "." + name).c_str());
+      if (index >= 0 || ns.empty()) return index;
+    }
+  }
+
+  bool CompileObject(const reflection::Object &object) {
+    Object o;
+    o.begin = ops_.size();
+    o.is_struct = object.is_struct();
+    o.bytesize = static_cast<size_t>(object.bytesize());
+    // The schema has fields sorted by name, text has them in the order
+    // they were declared in, which is their id.
+    auto fields = object.fields();
+    std::vector<const reflection::Field *> ordered(fields->size());
+    for (uoffset_t i = 0; i < fields->size(); i++) {
+      auto field = fields->Get(i);
+      if (field->id() >= ordered.size() || ordered[field->id()]) {
+        error_ = "invalid field ids in " + object.name()->str();
+        return false;
+      }
+      ordered[field->id()] = field;
+    }
+    for (auto it = ordered.begin(); it != ordered.end(); ++it) {
+      auto field = *it;
+      auto type = field->type();
+      Op op;
+      op.offset = field->offset();
+      op.kind = static_cast<uint8_t>(type->base_type());
+      op.element = static_cast<uint8_t>(type->element());
+      op.fixed_length = type->fixed_length();
+      op.target = type->index();
+      op.flags = field->deprecated() ? kDeprecated : 0;
+      if (type->element() == reflection::Union) op.flags |= kUnsupported;
+      if (IsFloat(type->base_type())) {
+        op.default_value.f = field->default_real();
+      } else {
+        op.default_value.i = field->default_integer();
+      }
+      if (HasAttribute(field->attributes(), "flexbuffer")) {
+        op.flags |= kFlexBuffer;
+      } else if (auto nested = field->attributes()
+                                   ? field->attributes()->LookupByKey(
+                                         "nested_flatbuffer")
+                                   : nullptr) {
+        op.flags |= kNestedFlatBuffer;
+        op.target =
+            LookupNestedObject(object.name()->str(), nested->value()->str());
+        if (op.target < 0) {
+          error_ = "unknown nested_flatbuffer type: " + nested->value()->str();
+          return false;
+        }
+      }
+      // Render the key the way GenerateText does.
+      std::string key;
+      if (strict_json_) key += '\"';
+      key += field->name()->str();
+      if (strict_json_) key += '\"';
+      if (!protobuf_ascii_alike_ || (type->base_type() != reflection::Obj &&
+                                     type->base_type() != reflection::Vector)) {
+        key += ':';
+      }
+      key += ' ';
+      op.key = AddString(key);
+      op.key_length = static_cast<uint32_t>(key.size());
+      ops_.push_back(op);
+    }
+    o.end = ops_.size();
+    objects_.push_back(o);
+    return true;
+  }
+
+  const EnumValue *LookupEnumValue(int enum_index, int64_t value) const {
+    auto &e = enums_[static_cast<size_t>(enum_index)];
+    if (e.values.empty()) return nullptr;
+    if (e.dense) {
+      auto i = static_cast<uint64_t>(value) -
+               static_cast<uint64_t>(e.values.front().value);
+      return i < e.values.size() ? &e.values[static_cast<size_t>(i)] : nullptr;
+    }
+    auto it = std::lower_bound(e.values.begin(), e.values.end(), value,
+                               [](const EnumValue &ev, int64_t v) {
+                                 return ev.value < v;
+                               });
+    return it != e.values.end() && it->value == value ? &*it : nullptr;
+  }
+
+  void AppendName(const EnumValue &ev, std::string *text) const {
+    text->append(strings_, ev.name, ev.name_length);
+  }
+
+  template<typename T>
+  void PrintScalar(T val, reflection::BaseType kind, int enum_index,
+                   std::string *text) const {
+    if (enum_index >= 0 && output_enum_identifiers_) {
+      if (auto ev = LookupEnumValue(enum_index, static_cast<int64_t>(val))) {
+        *text += '\"';
+        AppendName(*ev, text);
+        *text += '\"';
+        return;
+      }
+      auto &e = enums_[static_cast<size_t>(enum_index)];
+      if (val && e.bit_flags) {
+        // Space separated names of the flags set, if any.
+        auto start = text->length();
+        *text += '\"';
+        for (auto it = e.values.begin(); it != e.values.end(); ++it) {
+          if (static_cast<uint64_t>(it->value) & static_cast<uint64_t>(val)) {
+            AppendName(*it, text);
+            *text += ' ';
+          }
+        }
+        if (text->length() > start + 1) {
+          (*text)[text->length() - 1] = '\"';
+          return;
+        }
+        text->resize(start);
+      }
+    }
+    if (kind == reflection::Bool) {
+      *text += val != 0 ? "true" : "false";
+    } else {
+      AppendNumToString(val, text);
+    }
+  }
+
+  // Print a scalar stored at `p`, or the field's default if `p` is null.
+  void PrintScalarField(reflection::BaseType kind, int enum_index,
+                        const uint8_t *p, const Op *op,
+                        std::string *text) const {
+    // clang-format off
+    #define FLATBUFFERS_PRINT_SCALAR(KIND, CTYPE, DEFAULT) \
+      case reflection::KIND: \
+        PrintScalar<CTYPE>( \
+            p ? ReadScalar<CTYPE>(p) \
+              : static_cast<CTYPE>(op->default_value.DEFAULT), \
+            kind, enum_index, text); \
+        break;
+    switch (kind) {
+      FLATBUFFERS_PRINT_SCALAR(UType, uint8_t, i)
+      FLATBUFFERS_PRINT_SCALAR(Bool, uint8_t, i)
+      FLATBUFFERS_PRINT_SCALAR(Byte, int8_t, i)
+      FLATBUFFERS_PRINT_SCALAR(UByte, uint8_t, i)
+      FLATBUFFERS_PRINT_SCALAR(Short, int16_t, i)
+      FLATBUFFERS_PRINT_SCALAR(UShort, uint16_t, i)
+      FLATBUFFERS_PRINT_SCALAR(Int, int32_t, i)
+      FLATBUFFERS_PRINT_SCALAR(UInt, uint32_t, i)
+      FLATBUFFERS_PRINT_SCALAR(Long, int64_t, i)
+      FLATBUFFERS_PRINT_SCALAR(ULong, uint64_t, i)
+      FLATBUFFERS_PRINT_SCALAR(Float, float, f)
+      FLATBUFFERS_PRINT_SCALAR(Double, double, f)
+      default: FLATBUFFERS_ASSERT(0);
+    }
+    #undef FLATBUFFERS_PRINT_SCALAR
+    // clang-format on
+  }
+
+  // Print a value of a vector or array element, or of a non-scalar field:
+  // `p` points at the value itself for scalars and structs, or at the offset
+  // to it otherwise.
+  bool PrintValue(reflection::BaseType kind, int target, const uint8_t *p,
+                  int indent, std::string *text) const {
+    if (IsScalar(kind)) {
+      PrintScalarField(kind, target, p, nullptr, text);
+      return true;
+    }
+    switch (kind) {
+      case reflection::String: {
+        auto s = reinterpret_cast<const String *>(p + ReadScalar<uoffset_t>(p));
+        return EscapeString(s->c_str(), s->size(), text, allow_non_utf8_,
+                            natural_utf8_);
+      }
+      case reflection::Obj: {
+        auto &o = objects_[static_cast<size_t>(target)];
+        return PrintObject(target,
+                           o.is_struct ? p : p + ReadScalar<uoffset_t>(p),
+                           indent, text);
+      }
+      default: FLATBUFFERS_ASSERT(0); return false;
+    }
+  }
+
+  size_t ElementSize(reflection::BaseType kind, int target) const {
+    return kind == reflection::Obj &&
+                   objects_[static_cast<size_t>(target)].is_struct
+               ? objects_[static_cast<size_t>(target)].bytesize
+               : GetTypeSize(kind);
+  }
+
+  void AppendElementSeparator(size_t i, int indent, std::string *text) const {
+    if (i) {
+      if (!protobuf_ascii_alike_) *text += ',';
+      if (newline_) *text += '\n';
+    }
+    text->append(static_cast<size_t>(indent), ' ');
+  }
+
+  // Scalar elements are the most common, and get a loop of their own type.
+  template<typename T>
+  void PrintScalarElements(const Op &op, const uint8_t *data, size_t size,
+                           int indent, std::string *text) const {
+    auto element = static_cast<reflection::BaseType>(op.element);
+    for (size_t i = 0; i < size; i++) {
+      AppendElementSeparator(i, indent, text);
+      PrintScalar<T>(ReadScalar<T>(data + i * sizeof(T)), element, op.target,
+                     text);
+    }
+  }
+
+  // Print a vector or an array, comma separated, wrapped in "[]".
+  bool PrintContainer(const Op &op, const uint8_t *data, size_t size,
+                      int indent, std::string *text) const {
+    auto element = static_cast<reflection::BaseType>(op.element);
+    auto element_indent = indent + indent_step_;
+    *text += '[';
+    if (newline_) *text += '\n';
+    // clang-format off
+    #define FLATBUFFERS_PRINT_SCALARS(KIND, CTYPE) \
+      case reflection::KIND: \
+        PrintScalarElements<CTYPE>(op, data, size, element_indent, text); \
+        break;
+    switch (element) {
+      FLATBUFFERS_PRINT_SCALARS(UType, uint8_t)
+      FLATBUFFERS_PRINT_SCALARS(Bool, uint8_t)
+      FLATBUFFERS_PRINT_SCALARS(Byte, int8_t)
+      FLATBUFFERS_PRINT_SCALARS(UByte, uint8_t)
+      FLATBUFFERS_PRINT_SCALARS(Short, int16_t)
+      FLATBUFFERS_PRINT_SCALARS(UShort, uint16_t)
+      FLATBUFFERS_PRINT_SCALARS(Int, int32_t)
+      FLATBUFFERS_PRINT_SCALARS(UInt, uint32_t)
+      FLATBUFFERS_PRINT_SCALARS(Long, int64_t)
+      FLATBUFFERS_PRINT_SCALARS(ULong, uint64_t)
+      FLATBUFFERS_PRINT_SCALARS(Float, float)
+      FLATBUFFERS_PRINT_SCALARS(Double, double)
+      default: {
+        auto element_size = ElementSize(element, op.target);
+        for (size_t i = 0; i < size; i++) {
+          AppendElementSeparator(i, element_indent, text);
+          if (!PrintValue(element, op.target, data + i * element_size,
+                          element_indent, text)) {
+            return false;
+          }
+        }
+      }
+    }
+    #undef FLATBUFFERS_PRINT_SCALARS
+    // clang-format on
+    if (newline_) *text += '\n';
+    text->append(static_cast<size_t>(indent), ' ');
+    *text += ']';
+    return true;
+  }
+
+  // Generate text for a struct or table, values separated by commas,
+  // indented, and bracketed by "{}".
+  bool PrintObject(int index, const uint8_t *data, int indent,
+                   std::string *text) const {
+    auto &object = objects_[static_cast<size_t>(index)];
+    const uint8_t *vtable = nullptr;
+    voffset_t vtable_size = 0;
+    if (!object.is_struct) {
+      vtable = data - ReadScalar<soffset_t>(data);
+      vtable_size = ReadScalar<voffset_t>(vtable);
+    }
+    auto field_indent = indent + indent_step_;
+    *text += '{';
+    bool first = true;
+    int64_t union_type = 0;
+    for (auto op = vector_data(ops_) + object.begin,
+              end = vector_data(ops_) + object.end;
+         op != end; ++op) {
+      auto kind = static_cast<reflection::BaseType>(op->kind);
+      const uint8_t *p;
+      if (object.is_struct) {
+        p = data + op->offset;
+      } else {
+        auto field_offset = op->offset < vtable_size
+                                ? ReadScalar<voffset_t>(vtable + op->offset)
+                                : 0;
+        p = field_offset ? data + field_offset : nullptr;
+        if (!p && !(output_default_scalars_ && IsScalar(kind) &&
+                    !(op->flags & kDeprecated))) {
+          continue;
+        }
+        if (op->flags & kUnsupported) return false;
+      }
+      if (!first && !protobuf_ascii_alike_) *text += ',';
+      first = false;
+      if (newline_) *text += '\n';
+      text->append(static_cast<size_t>(field_indent), ' ');
+      text->append(strings_, op->key, op->key_length);
+      if (IsScalar(kind)) {
+        PrintScalarField(kind, op->target, p, op, text);
+        if (kind == reflection::UType) {
+          union_type = p ? ReadScalar<uint8_t>(p) : 0;
+        }
+        continue;
+      }
+      switch (kind) {
+        case reflection::String:
+        case reflection::Obj:
+          if (!PrintValue(kind, op->target, p, field_indent, text)) {
+            return false;
+          }
+          break;
+        case reflection::Union: {
+          // The type field is declared right before the union.
+          auto ev = union_type ? LookupEnumValue(op->target, union_type)
+                               : nullptr;
+          if (!ev) return false;
+          if (ev->union_string) {
+            if (!PrintValue(reflection::String, -1, p, field_indent, text)) {
+              return false;
+            }
+          } else if (ev->union_object < 0 ||
+                     !PrintObject(ev->union_object,
+                                  p + ReadScalar<uoffset_t>(p), field_indent,
+                                  text)) {
+            return false;
+          }
+          break;
+        }
+        case reflection::Vector: {
+          auto vec = p + ReadScalar<uoffset_t>(p);
+          auto size = ReadScalar<uoffset_t>(vec);
+          auto elements = vec + sizeof(uoffset_t);
+          if (op->flags & kFlexBuffer) {
+            flexbuffers::GetRoot(elements, size)
+                .ToString(true, strict_json_, *text);
+          } else if (op->flags & kNestedFlatBuffer) {
+            if (!PrintObject(op->target,
+                             elements + ReadScalar<uoffset_t>(elements),
+                             field_indent, text)) {
+              return false;
+            }
+          } else if (!PrintContainer(*op, elements, size, field_indent,
+                                     text)) {
+            return false;
+          }
+          break;
+        }
+        case reflection::Array:
+          if (!PrintContainer(*op, p, op->fixed_length, field_indent, text)) {
+            return false;
+          }
+          break;
+        default: FLATBUFFERS_ASSERT(0); return false;
+      }
+    }
+    if (newline_) *text += '\n';
+    text->append(static_cast<size_t>(indent), ' ');
+    *text += '}';
+    return true;
+  }
+
+  int root_;
+  std::string error_;
+  std::vector<Op> ops_;
+  std::vector<Object> objects_;
+  std::vector<Enum> enums_;
+  // Keys and enum names, referred to by offset.
+  std::string strings_;
+  // Only valid while compiling.
+  const Vector<Offset<reflection::Object>> *schema_objects_;
+
+  bool newline_;
+  int indent_step_;
+  bool strict_json_;
+  bool output_enum_identifiers_;
+  bool output_default_scalars_;
+  bool protobuf_ascii_alike_;
+  bool allow_non_utf8_;
+  bool natural_utf8_;
+  bool size_prefixed_;
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_JSON_PRINTER_H_
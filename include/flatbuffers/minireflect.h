@@ -402,6 +402,75 @@ inline std::string FlatBufferToString(const uint8_t *buffer,
   return tostring_visitor.s;
 }
 
+// clang-format off
+#ifdef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+// clang-format on
+
+// Describes why `verifier` failed to verify `buffer`, whose root is of the type
+// of `type_table`, e.g. "testarrayoftables[2].name: string not zero
+// terminated at offset 120". Fields are named if the code was generated with
+// --reflect-names, and numbered otherwise. When verifying lazily, pass the
+// type of the table last passed to `Verifier::Verified()` instead.
+inline std::string VerifierErrorToString(const Verifier &verifier,
+                                         const uint8_t *buffer,
+                                         const TypeTable *type_table) {
+  std::string path;
+  auto &tables = verifier.GetErrorPath();
+  for (size_t i = 0; i < tables.size() && type_table; i++) {
+    // All fields of these tables up to the failing one have been verified,
+    // so we can read them to find out how they lead to the next table.
+    auto field = tables[i].field;
+    if (field < FieldIndexToOffset(0)) break;
+    auto idx = static_cast<size_t>(field / sizeof(voffset_t) - 2);
+    if (idx >= type_table->num_elems) break;
+    if (!path.empty()) path += ".";
+    path += type_table->names ? type_table->names[idx] : NumToString(idx);
+    if (i + 1 == tables.size()) break;
+    auto type_code = type_table->type_codes[idx];
+    auto ref = type_code.sequence_ref >= 0
+                   ? type_table->type_refs[type_code.sequence_ref]()
+                   : nullptr;
+    auto table = reinterpret_cast<const Table *>(buffer + tables[i].table);
+    auto child = buffer + tables[i + 1].table;
+    int64_t union_type = 0;
+    if (type_code.is_vector) {
+      auto vec = table->GetPointer<const Vector<Offset<Table>> *>(field);
+      uoffset_t j = 0;
+      while (j < vec->size() &&
+             reinterpret_cast<const uint8_t *>(vec->Get(j)) != child) {
+        j++;
+      }
+      if (j == vec->size()) break;
+      path += "[" + NumToString(j) + "]";
+      if (ref && ref->st == ST_UNION) {
+        auto types = table->GetPointer<const Vector<uint8_t> *>(
+            field - sizeof(voffset_t));
+        if (!types || j >= types->size()) break;
+        union_type = types->Get(j);
+      }
+    } else if (ref && ref->st == ST_UNION) {
+      union_type = table->GetField<uint8_t>(field - sizeof(voffset_t), 0);
+    }
+    if (ref && ref->st == ST_UNION) {
+      auto member = LookupEnum(union_type, ref->values, ref->num_elems);
+      if (member < 0 || member >= static_cast<int64_t>(ref->num_elems)) break;
+      auto member_code = ref->type_codes[member];
+      ref = member_code.sequence_ref >= 0
+                ? ref->type_refs[member_code.sequence_ref]()
+                : nullptr;
+    }
+    type_table = ref;
+  }
+  auto rule = verifier.GetErrorRule();
+  if (!rule) return path.empty() ? "invalid value" : path + ": invalid value";
+  return (path.empty() ? "" : path + ": ") + rule + " at offset " +
+         NumToString(verifier.GetErrorOffset());
+}
+
+// clang-format off
+#endif  // FLATBUFFERS_VERIFIER_DIAGNOSTICS
+// clang-format on
+
 }  // namespace flatbuffers
 
 #endif  // FLATBUFFERS_MINIREFLECT_H_
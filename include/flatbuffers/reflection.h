@@ -430,6 +430,83 @@ void ResizeVector(const reflection::Schema &schema, uoffset_t newsize, T val,
   }
 }
 
+// Collects any number of string and vector resizes to a FlatBuffer, and
+// insertions of new data, and applies them all at once. SetString and
+// ResizeAnyVector above walk all offsets in the buffer and move everything
+// after the edit for each call, whereas Apply() does a single walk and moves
+// each byte at most once.
+// All strings, vectors and tables passed in must live inside "flatbuf" as it is
+// before Apply(), and each string or vector may only be changed once per batch.
+// They remain valid until Apply(), which may invalidate them.
+// If your FlatBuffer's root table is not the schema's root table, you should
+// pass in your root_table type as well.
+class ResizeBatch {
+ public:
+  ResizeBatch(const reflection::Schema &schema, std::vector<uint8_t> *flatbuf,
+              const reflection::Object *root_table = nullptr)
+      : schema_(schema), flatbuf_(flatbuf), root_table_(root_table) {}
+
+  // Changes the contents of "str" to "val".
+  void SetString(const String *str, const std::string &val);
+
+  // Resizes "vec" to "newsize" elements. New elements are set to "val" (of
+  // elem_size bytes) if given, or 0 otherwise.
+  void ResizeAnyVector(const VectorOfAny *vec, uoffset_t num_elems,
+                       uoffset_t newsize, uoffset_t elem_size,
+                       const uint8_t *val = nullptr);
+
+  template<typename T>
+  void ResizeVector(const Vector<T> *vec, uoffset_t newsize, T val) {
+    uint8_t elem[sizeof(T)];
+    auto is_scalar = flatbuffers::is_scalar<T>::value;
+    if (is_scalar) {
+      WriteScalar(elem, val);
+    } else {  // struct
+      memcpy(elem, &val, sizeof(T));
+    }
+    ResizeAnyVector(reinterpret_cast<const VectorOfAny *>(vec), vec->size(),
+                    newsize, static_cast<uoffset_t>(sizeof(T)), elem);
+  }
+
+  // Like AddFlatBuffer below, but also points "field" of "table" at the root
+  // of the new data once it has been added, since the table may have moved by
+  // then. Returns false if "table" doesn't store "field" (see SetFieldT).
+  // The new data is copied, and isn't affected by the other changes.
+  bool AddFlatBuffer(const Table *table, const reflection::Field &field,
+                     const uint8_t *newbuf, size_t newlen);
+
+  // Applies all changes collected so far, and starts a new batch.
+  void Apply();
+
+  bool empty() const { return edits_.empty() && insertions_.empty(); }
+
+ private:
+  struct Edit {
+    uoffset_t object;  // Length field of the string or vector.
+    uoffset_t start;   // Where bytes are inserted or removed.
+    int delta;         // Number of bytes inserted (> 0) or removed (< 0).
+    uoffset_t length;  // New value of the length field.
+    uoffset_t clear_start;  // Old contents to clear before resizing.
+    uoffset_t clear_size;
+    std::vector<uint8_t> data;  // New contents, copied to start afterwards.
+  };
+
+  struct Insertion {
+    uoffset_t table;  // Where the table is before Apply().
+    const reflection::Field *field;
+    std::vector<uint8_t> data;  // The FlatBuffer to add.
+  };
+
+  void Add(Edit &edit);
+  static int RoundDelta(int delta);
+
+  const reflection::Schema &schema_;
+  std::vector<uint8_t> *flatbuf_;
+  const reflection::Object *root_table_;
+  std::vector<Edit> edits_;
+  std::vector<Insertion> insertions_;
+};
+
 // Adds any new data (in the form of a new FlatBuffer) to an existing
 // FlatBuffer. This can be used when any of the above methods are not
 // sufficient, in particular for adding new tables and new fields.
@@ -465,6 +542,66 @@ Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
                                 const Table &table,
                                 bool use_string_pooling = false);
 
+// Copies tables the same way as CopyTable above, but works out what to do for
+// each field of an object only once, the first time a table of that object is
+// copied, and reuses its scratch space between tables. Scalar and struct
+// vectors are copied in bulk. Keep one around to copy many tables of the same
+// schema, e.g. to extract subtrees from large buffers.
+class TableCopier {
+ public:
+  explicit TableCopier(const reflection::Schema &schema,
+                       bool use_string_pooling = false)
+      : schema_(schema),
+        use_string_pooling_(use_string_pooling),
+        plans_(schema.objects()->size()) {}
+
+  Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
+                                  const reflection::Object &objectdef,
+                                  const Table &table);
+
+ private:
+  struct FieldPlan {
+    enum Kind {
+      kInline,  // Scalars and structs.
+      kString,
+      kTable,
+      kUnion,
+      kVectorOfInline,
+      kVectorOfStrings,
+      kVectorOfTables
+    };
+    Kind kind;
+    voffset_t offset;
+    // Size and alignment of inline data or vector elements.
+    size_t size;
+    size_t align;
+    // Object index of sub-tables.
+    int object;
+    // For unions: the type field, and the object index each type refers to,
+    // looked up on first use (-1 until then).
+    voffset_t type_offset;
+    const reflection::Enum *union_enum;
+    std::vector<int> union_objects;
+  };
+
+  struct ObjectPlan {
+    ObjectPlan() : built(false) {}
+    bool built;
+    std::vector<FieldPlan> fields;
+  };
+
+  ObjectPlan &Plan(int object);
+  int UnionObject(FieldPlan &field, uint8_t type);
+  uoffset_t Copy(FlatBufferBuilder &fbb, ObjectPlan &plan, const Table &table);
+  uoffset_t CopyString(FlatBufferBuilder &fbb, const String *str);
+
+  const reflection::Schema &schema_;
+  bool use_string_pooling_;
+  std::vector<ObjectPlan> plans_;
+  // Offsets of sub-objects for all tables being copied, used as a stack.
+  std::vector<Offset<void>> scratch_;
+};
+
 // Verifies the provided flatbuffer using reflection.
 // root should point to the root type for this flatbuffer.
 // buf should point to the start of flatbuffer data.
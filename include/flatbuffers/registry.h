@@ -17,7 +17,10 @@
 #ifndef FLATBUFFERS_REGISTRY_H_
 #define FLATBUFFERS_REGISTRY_H_
 
+#include <mutex>
+
 #include "flatbuffers/idl.h"
+#include "flatbuffers/json_printer.h"
 
 namespace flatbuffers {
 
@@ -25,14 +28,27 @@ namespace flatbuffers {
 // Simply pre-populate it with all schema filenames that may be in use, and
 // This class will look them up using the file_identifier declared in the
 // schema.
+// Schemas are loaded and parsed on first use, and kept until invalidated, so
+// converting many buffers doesn't parse their schema over and over. Text is
+// generated by a `JsonPrinter` compiled once per schema.
+// All functions may be called concurrently from multiple threads. Loading a
+// schema doesn't hold up calls that use other schemas, or schemas already
+// loaded.
 class Registry {
  public:
+  Registry() : generation_(0) {}
+
   // Call this for all schemas that may be in use. The identifier has
   // a function in the generated code, e.g. MonsterIdentifier().
+  // The schema may be a binary schema (generated with
+  // `flatc -b --schema --bfbs-builtins`) if its path ends in .bfbs, which is
+  // faster to load, and doesn't need any includes.
   void Register(const char *file_identifier, const char *schema_path) {
     Schema schema;
     schema.path_ = schema_path;
+    std::lock_guard<std::mutex> lock(mutex_);
     schemas_[file_identifier] = schema;
+    generation_++;
   }
 
   // Generate text from an arbitrary FlatBuffer by looking up its
@@ -41,18 +57,22 @@ class Registry {
     // Get the identifier out of the buffer.
     // If the buffer is truncated, exit.
     if (len < sizeof(uoffset_t) + FlatBufferBuilder::kFileIdentifierLength) {
-      lasterror_ = "buffer truncated";
+      SetError("buffer truncated");
       return false;
     }
     std::string ident(
         reinterpret_cast<const char *>(flatbuf) + sizeof(uoffset_t),
         FlatBufferBuilder::kFileIdentifierLength);
-    // Load and parse the schema.
-    Parser parser;
-    if (!LoadSchema(ident, &parser)) return false;
+    // Get the parsed schema.
+    auto loaded = LoadSchema(ident);
+    if (!loaded) return false;
+    if (!loaded->printer_.IsCompiled()) {
+      SetError(loaded->printer_.GetError());
+      return false;
+    }
     // Now we're ready to generate text.
-    if (!GenerateText(parser, flatbuf, dest)) {
-      lasterror_ = "unable to generate text for FlatBuffer binary";
+    if (!loaded->printer_.Print(flatbuf, dest)) {
+      SetError("unable to generate text for FlatBuffer binary");
       return false;
     }
     return true;
@@ -63,60 +83,285 @@ class Registry {
   // If DetachedBuffer::data() is null then parsing failed.
   DetachedBuffer TextToFlatBuffer(const char *text,
                                   const char *file_identifier) {
-    // Load and parse the schema.
-    Parser parser;
-    if (!LoadSchema(file_identifier, &parser)) return DetachedBuffer();
+    // Get the parsed schema.
+    auto loaded = LoadSchema(file_identifier);
+    if (!loaded) return DetachedBuffer();
+    // Parsing text modifies the parser, so each call needs one of its own.
+    auto parser = loaded->AcquireParser();
+    if (!parser) {
+      SetError("could not deserialize schema");
+      return DetachedBuffer();
+    }
     // Parse the text.
-    if (!parser.Parse(text)) {
-      lasterror_ = parser.error_;
+    if (!parser->Parse(text)) {
+      SetError(parser->error_);
       return DetachedBuffer();
     }
     // We have a valid FlatBuffer. Detach it from the builder and return.
-    return parser.builder_.Release();
+    auto buf = parser->builder_.Release();
+    loaded->ReleaseParser(std::move(parser));
+    return buf;
   }
 
   // Modify any parsing / output options used by the other functions.
-  void SetOptions(const IDLOptions &opts) { opts_ = opts; }
+  // Schemas loaded with other options are invalidated.
+  void SetOptions(const IDLOptions &opts) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    opts_ = opts;
+    InvalidateAllLocked();
+  }
 
   // If schemas used contain include statements, call this function for every
   // directory the parser should search them for.
-  void AddIncludeDirectory(const char *path) { include_paths_.push_back(path); }
+  // Schemas loaded without it are invalidated.
+  void AddIncludeDirectory(const char *path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    include_paths_.push_back(path);
+    InvalidateAllLocked();
+  }
+
+  // Forget the parsed schema for this identifier (e.g. because the file
+  // changed), so it is loaded again on next use. Calls in progress
+  // keep using the old one.
+  void Invalidate(const char *file_identifier) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = schemas_.find(file_identifier);
+    if (it != schemas_.end()) it->second.loaded_.reset();
+    generation_++;
+  }
+
+  void InvalidateAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    InvalidateAllLocked();
+  }
+
+  // Load the schema for this identifier again right away, e.g. to find out
+  // whether it still parses. If not, the previous one stays in use.
+  bool Reload(const char *file_identifier) {
+    SchemaSource source;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = schemas_.find(file_identifier);
+      if (it == schemas_.end()) {
+        SetError("identifier not in the registry");
+        return false;
+      }
+      source = GetSourceLocked(it->second);
+    }
+    auto loaded = LoadSchemaFile(source);
+    if (!loaded) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = schemas_.find(file_identifier);
+    if (it != schemas_.end() && generation_ == source.generation) {
+      it->second.loaded_ = loaded;
+    }
+    return true;
+  }
 
   // Returns a human readable error if any of the above functions fail.
-  const std::string &GetLastError() { return lasterror_; }
+  // Errors are kept per thread: this is the error of the last call that
+  // failed on the calling thread.
+  std::string GetLastError() { return LastError(); }
 
  private:
-  bool LoadSchema(const std::string &ident, Parser *parser) {
-    // Find the schema, if not, exit.
+  // A schema once parsed, which is never modified again.
+  struct LoadedSchema {
+    explicit LoadedSchema(const IDLOptions &opts)
+        : opts_(opts), has_deserialized_state_(false) {}
+
+    // Returns a parser for text, set up from the binary schema (which is a
+    // lot cheaper than parsing the schema again), or reused from an earlier
+    // call.
+    std::unique_ptr<Parser> AcquireParser() const {
+      {
+        std::lock_guard<std::mutex> lock(idle_parsers_mutex_);
+        if (!idle_parsers_.empty()) {
+          auto parser = std::move(idle_parsers_.back());
+          idle_parsers_.pop_back();
+          return parser;
+        }
+      }
+      std::unique_ptr<Parser> parser(new Parser(opts_));
+      if (!parser->Deserialize(vector_data(bfbs_), bfbs_.size())) {
+        return nullptr;
+      }
+      std::lock_guard<std::mutex> lock(idle_parsers_mutex_);
+      if (!has_deserialized_state_) {
+        deserialized_state_ = ParserState(*parser);
+        has_deserialized_state_ = true;
+      }
+      return parser;
+    }
+
+    // Only for parsers that succeeded, others may be in any state.
+    // Text may also declare types, attributes or a root_type of its own,
+    // which would leak into the next call, so such parsers are dropped.
+    void ReleaseParser(std::unique_ptr<Parser> parser) const {
+      std::lock_guard<std::mutex> lock(idle_parsers_mutex_);
+      if (!has_deserialized_state_ ||
+          !(ParserState(*parser) == deserialized_state_)) {
+        return;
+      }
+      idle_parsers_.push_back(std::move(parser));
+    }
+
+    // What parsing text can add to a parser.
+    struct ParserState {
+      ParserState()
+          : structs(0), enums(0), services(0), namespaces(0), attributes(0) {}
+      explicit ParserState(const Parser &parser)
+          : structs(parser.structs_.vec.size()),
+            enums(parser.enums_.vec.size()),
+            services(parser.services_.vec.size()),
+            namespaces(parser.namespaces_.size()),
+            attributes(parser.known_attributes_.size()),
+            file_identifier(parser.file_identifier_),
+            file_extension(parser.file_extension_) {
+        auto root = parser.root_struct_def_;
+        if (root) {
+          root_type = root->defined_namespace->GetFullyQualifiedName(
+              root->name);
+        }
+      }
+      bool operator==(const ParserState &other) const {
+        return structs == other.structs && enums == other.enums &&
+               services == other.services && namespaces == other.namespaces &&
+               attributes == other.attributes &&
+               root_type == other.root_type &&
+               file_identifier == other.file_identifier &&
+               file_extension == other.file_extension;
+      }
+
+      size_t structs;
+      size_t enums;
+      size_t services;
+      size_t namespaces;
+      size_t attributes;
+      std::string root_type;
+      std::string file_identifier;
+      std::string file_extension;
+    };
+
+    IDLOptions opts_;
+    std::vector<uint8_t> bfbs_;
+    JsonPrinter printer_;
+    mutable std::mutex idle_parsers_mutex_;
+    mutable std::vector<std::unique_ptr<Parser>> idle_parsers_;
+    mutable bool has_deserialized_state_;
+    mutable ParserState deserialized_state_;
+  };
+
+  struct Schema {
+    std::string path_;
+    // Null until first used.
+    std::shared_ptr<const LoadedSchema> loaded_;
+  };
+
+  // What loading a schema needs, copied so it can be loaded without holding
+  // the registry lock.
+  struct SchemaSource {
+    std::string path;
+    IDLOptions opts;
+    std::vector<const char *> include_paths;
+    // Of the registry, to tell whether the schema was invalidated since.
+    size_t generation;
+  };
+
+  SchemaSource GetSourceLocked(const Schema &schema) const {
+    SchemaSource source;
+    source.path = schema.path_;
+    source.opts = opts_;
+    source.include_paths = include_paths_;
+    source.generation = generation_;
+    return source;
+  }
+
+  std::shared_ptr<const LoadedSchema> LoadSchema(const std::string &ident) {
+    SchemaSource source;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // Find the schema, if not, exit.
+      auto it = schemas_.find(ident);
+      if (it == schemas_.end()) {
+        // Don't attach the identifier, since it may not be human readable.
+        SetError("identifier for this buffer not in the registry");
+        return nullptr;
+      }
+      if (it->second.loaded_) return it->second.loaded_;
+      source = GetSourceLocked(it->second);
+    }
+    auto loaded = LoadSchemaFile(source);
+    if (!loaded) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
     auto it = schemas_.find(ident);
-    if (it == schemas_.end()) {
-      // Don't attach the identifier, since it may not be human readable.
-      lasterror_ = "identifier for this buffer not in the registry";
-      return false;
+    // If it was invalidated meanwhile, only this call gets to use it.
+    if (it == schemas_.end() || generation_ != source.generation) {
+      return loaded;
     }
-    auto &schema = it->second;
+    // Threads loading the same schema at once all use the first one.
+    if (!it->second.loaded_) it->second.loaded_ = loaded;
+    return it->second.loaded_;
+  }
+
+  // Doesn't use any members, so it runs without the registry lock.
+  static std::shared_ptr<const LoadedSchema> LoadSchemaFile(
+      const SchemaSource &source) {
     // Load the schema from disk. If not, exit.
+    auto &path = source.path;
+    auto binary = GetExtension(path) == "bfbs";
     std::string schematext;
-    if (!LoadFile(schema.path_.c_str(), false, &schematext)) {
-      lasterror_ = "could not load schema: " + schema.path_;
-      return false;
+    if (!LoadFile(path.c_str(), binary, &schematext)) {
+      SetError("could not load schema: " + path);
+      return nullptr;
     }
-    // Parse schema.
-    parser->opts = opts_;
-    if (!parser->Parse(schematext.c_str(), vector_data(include_paths_),
-                       schema.path_.c_str())) {
-      lasterror_ = parser->error_;
-      return false;
+    auto loaded = std::make_shared<LoadedSchema>(source.opts);
+    Parser parser(source.opts);
+    if (binary) {
+      auto bfbs = reinterpret_cast<const uint8_t *>(schematext.c_str());
+      if (!parser.Deserialize(bfbs, schematext.size())) {
+        SetError("could not deserialize schema: " + path);
+        return nullptr;
+      }
+      loaded->bfbs_.assign(bfbs, bfbs + schematext.size());
+    } else {
+      // Parse schema. The parser wants a null terminated list of paths.
+      std::vector<const char *> include_paths(source.include_paths);
+      include_paths.push_back(nullptr);
+      if (!parser.Parse(schematext.c_str(), vector_data(include_paths),
+                        path.c_str())) {
+        SetError(parser.error_);
+        return nullptr;
+      }
+      // Parsing text needs built-in attributes like nested_flatbuffer.
+      auto builtins = parser.opts.binary_schema_builtins;
+      parser.opts.binary_schema_builtins = true;
+      parser.Serialize();
+      parser.opts.binary_schema_builtins = builtins;
+      auto bfbs = parser.builder_.GetBufferPointer();
+      loaded->bfbs_.assign(bfbs, bfbs + parser.builder_.GetSize());
     }
-    return true;
+    // Schemas without a root_type can still be used to parse text.
+    loaded->printer_.Compile(
+        *reflection::GetSchema(vector_data(loaded->bfbs_)), source.opts);
+    return loaded;
   }
 
-  struct Schema {
-    std::string path_;
-    // TODO(wvo) optionally cache schema file or parsed schema here.
-  };
+  void InvalidateAllLocked() {
+    for (auto it = schemas_.begin(); it != schemas_.end(); ++it) {
+      it->second.loaded_.reset();
+    }
+    generation_++;
+  }
+
+  static std::string &LastError() {
+    static thread_local std::string error;
+    return error;
+  }
+
+  static void SetError(const std::string &error) { LastError() = error; }
 
-  std::string lasterror_;
+  std::mutex mutex_;
+  size_t generation_;
   IDLOptions opts_;
   std::vector<const char *> include_paths_;
   std::map<std::string, Schema> schemas_;
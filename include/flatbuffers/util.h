@@ -183,6 +183,122 @@ template<> inline std::string NumToString<float>(float t) {
   return FloatToString(t, 6);
 }
 
+// Writes the decimal digits of `u` to the chars ending at `end`, returns a
+// pointer to the first one.
+inline char *UIntToCharsBackwards(uint64_t u, char *end) {
+  do {
+    *--end = static_cast<char>('0' + u % 10);
+    u /= 10;
+  } while (u);
+  return end;
+}
+
+// Writes `t` as FloatToString(t, precision) does, with an exact integer
+// rather than a stream or printf based conversion, so it is fast and doesn't
+// allocate. `buf` must hold at least 48 chars. Returns the number of chars
+// written, or 0 for the values this doesn't handle: non-finite ones, those
+// of 2^64 / 10^precision and above, and precisions outside [1, 17].
+inline size_t FloatToChars(double t, int precision, char *buf) {
+  if (precision < 1 || precision > 17) return 0;
+  uint64_t bits;
+  memcpy(&bits, &t, sizeof(bits));
+  auto biased_exponent = static_cast<int>((bits >> 52) & 0x7FF);
+  if (biased_exponent == 0x7FF) return 0;  // Inf or NaN.
+  // t is exactly mantissa * 2^exponent.
+  uint64_t mantissa = bits & ((static_cast<uint64_t>(1) << 52) - 1);
+  int exponent = -1074;
+  if (biased_exponent) {
+    mantissa |= static_cast<uint64_t>(1) << 52;
+    exponent = biased_exponent - 1075;
+  }
+  // The output is t * 10^precision rounded to an integer, half to even like
+  // printf, with a decimal point inserted. That integer is mantissa *
+  // 5^precision (which fits in 128 bits) shifted by exponent + precision.
+  uint64_t pow5 = 1;
+  for (int i = 0; i < precision; i++) pow5 *= 5;
+  auto m_lo = mantissa & 0xFFFFFFFF, m_hi = mantissa >> 32;
+  auto p_lo = pow5 & 0xFFFFFFFF, p_hi = pow5 >> 32;
+  auto mid = m_hi * p_lo + ((m_lo * p_lo) >> 32) + (m_lo * p_hi & 0xFFFFFFFF);
+  uint64_t lo = mantissa * pow5;
+  uint64_t hi = m_hi * p_hi + (mid >> 32) + ((m_lo * p_hi) >> 32);
+  uint64_t scaled;
+  auto shift = exponent + precision;
+  if (shift >= 0) {
+    if (hi || shift >= 64 || (shift && lo >> (64 - shift))) return 0;
+    scaled = lo << shift;
+  } else if (-shift >= 128) {
+    scaled = 0;  // mantissa * 5^precision < 2^93, so this is below 1/2.
+  } else {
+    // Split into the integer (hi:lo >> shift) and the fraction below it.
+    shift = -shift;
+    uint64_t frac_hi, frac_lo;
+    if (shift >= 64) {
+      scaled = hi >> (shift - 64);
+      frac_hi = hi & ((static_cast<uint64_t>(1) << (shift - 64)) - 1);
+      frac_lo = lo;
+    } else {
+      if (hi >> shift) return 0;
+      scaled = (lo >> shift) | (hi << (64 - shift));
+      frac_hi = 0;
+      frac_lo = lo & ((static_cast<uint64_t>(1) << shift) - 1);
+    }
+    // Compare the fraction with 1/2 = 2^(shift - 1).
+    auto one = static_cast<uint64_t>(1);
+    uint64_t half_hi = shift > 64 ? one << (shift - 65) : 0;
+    uint64_t half_lo = shift > 64 ? 0 : one << (shift - 1);
+    if (frac_hi > half_hi || (frac_hi == half_hi && frac_lo > half_lo) ||
+        (frac_hi == half_hi && frac_lo == half_lo && (scaled & 1))) {
+      if (!++scaled) return 0;
+    }
+  }
+  // Digits, with at least one before the decimal point.
+  char digits[24];
+  auto end = digits + sizeof(digits);
+  auto begin = UIntToCharsBackwards(scaled, end);
+  while (end - begin <= precision) *--begin = '0';
+  auto point = end - precision;
+  // Strip trailing zeroes, but keep one after the point.
+  while (end > point + 1 && end[-1] == '0') end--;
+  auto out = buf;
+  if (bits >> 63) *out++ = '-';
+  memcpy(out, begin, static_cast<size_t>(point - begin));
+  out += point - begin;
+  *out++ = '.';
+  memcpy(out, point, static_cast<size_t>(end - point));
+  out += end - point;
+  return static_cast<size_t>(out - buf);
+}
+
+// Appends NumToString(t) to `dest`, without a temporary string for the
+// common cases.
+template<typename T> void AppendNumToString(T t, std::string *dest) {
+  auto u = static_cast<uint64_t>(t);
+  auto negative = !is_unsigned<T>::value && static_cast<int64_t>(u) < 0;
+  char buf[24];
+  auto end = buf + sizeof(buf);
+  auto begin = UIntToCharsBackwards(negative ? 0 - u : u, end);
+  if (negative) *--begin = '-';
+  dest->append(begin, end);
+}
+inline void AppendNumToString(double t, std::string *dest) {
+  char buf[48];
+  auto len = FloatToChars(t, 12, buf);
+  if (len) {
+    dest->append(buf, len);
+  } else {
+    *dest += NumToString(t);
+  }
+}
+inline void AppendNumToString(float t, std::string *dest) {
+  char buf[48];
+  auto len = FloatToChars(t, 6, buf);
+  if (len) {
+    dest->append(buf, len);
+  } else {
+    *dest += NumToString(t);
+  }
+}
+
 // Convert an integer value to a hexadecimal string.
 // The returned string length is always xdigits long, prefixed by 0 digits.
 // For example, IntToStringHex(0x23, 8) returns the string "00000023".
@@ -566,6 +682,16 @@ inline std::string WordWrap(const std::string in, size_t max_length,
 }
 #endif  // !FLATBUFFERS_PREFER_PRINTF
 
+// Appends `i` as IntToStringHex(i, xdigits) does, for values that fit in
+// `xdigits` digits.
+inline void AppendIntToStringHex(uint32_t i, int xdigits, std::string *dest) {
+  FLATBUFFERS_ASSERT(xdigits >= 8 || !(i >> (xdigits * 4)));
+  static const char kHexDigits[] = "0123456789ABCDEF";
+  for (int shift = (xdigits - 1) * 4; shift >= 0; shift -= 4) {
+    *dest += kHexDigits[(i >> shift) & 0xF];
+  }
+}
+
 inline bool EscapeString(const char *s, size_t length, std::string *_text,
                          bool allow_non_utf8, bool natural_utf8) {
   std::string &text = *_text;
@@ -590,7 +716,7 @@ inline bool EscapeString(const char *s, size_t length, std::string *_text,
           if (ucc < 0) {
             if (allow_non_utf8) {
               text += "\\x";
-              text += IntToStringHex(static_cast<uint8_t>(c), 2);
+              AppendIntToStringHex(static_cast<uint8_t>(c), 2, _text);
             } else {
               // There are two cases here:
               //
@@ -613,7 +739,7 @@ inline bool EscapeString(const char *s, size_t length, std::string *_text,
             } else if (ucc <= 0xFFFF) {
               // Parses as Unicode within JSON's \uXXXX range, so use that.
               text += "\\u";
-              text += IntToStringHex(ucc, 4);
+              AppendIntToStringHex(static_cast<uint32_t>(ucc), 4, _text);
             } else if (ucc <= 0x10FFFF) {
               // Encode Unicode SMP values to a surrogate pair using two \u
               // escapes.
@@ -621,9 +747,9 @@ inline bool EscapeString(const char *s, size_t length, std::string *_text,
               auto high_surrogate = (base >> 10) + 0xD800;
               auto low_surrogate = (base & 0x03FF) + 0xDC00;
               text += "\\u";
-              text += IntToStringHex(high_surrogate, 4);
+              AppendIntToStringHex(high_surrogate, 4, _text);
               text += "\\u";
-              text += IntToStringHex(low_surrogate, 4);
+              AppendIntToStringHex(low_surrogate, 4, _text);
             }
             // Skip past characters recognized.
             i = static_cast<uoffset_t>(utf8 - s - 1);
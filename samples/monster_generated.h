@@ -131,7 +131,9 @@ struct EquipmentUnion {
 #endif  // FLATBUFFERS_CPP98_STL
 
   static void *UnPack(const void *obj, Equipment type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t SerializedSizeBound() const;
 
   MyGame::Sample::WeaponT *AsWeapon() {
     return type == Equipment_Weapon ?
@@ -234,6 +236,7 @@ struct MonsterT : public flatbuffers::NativeTable {
         hp(100),
         color(MyGame::Sample::Color_Blue) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const MonsterT &lhs, const MonsterT &rhs) {
@@ -474,6 +477,7 @@ struct WeaponT : public flatbuffers::NativeTable {
   WeaponT()
       : damage(0) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const WeaponT &lhs, const WeaponT &rhs) {
@@ -573,16 +577,16 @@ inline MonsterT *Monster::UnPack(const flatbuffers::resolver_function_t *_resolv
 inline void Monster::UnPackTo(MonsterT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = pos(); if (_e) _o->pos = flatbuffers::unique_ptr<MyGame::Sample::Vec3>(new MyGame::Sample::Vec3(*_e)); };
+  { auto _e = pos(); if (_e) { if (_o->pos) *_o->pos = *_e; else _o->pos = flatbuffers::unique_ptr<MyGame::Sample::Vec3>(new MyGame::Sample::Vec3(*_e)); } else { _o->pos.reset(); } };
   { auto _e = mana(); _o->mana = _e; };
   { auto _e = hp(); _o->hp = _e; };
-  { auto _e = name(); if (_e) _o->name = _e->str(); };
-  { auto _e = inventory(); if (_e) { _o->inventory.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->inventory[_i] = _e->Get(_i); } } };
+  { auto _e = name(); if (_e) { _o->name.assign(_e->c_str(), _e->size()); } else { _o->name.clear(); } };
+  { auto _e = inventory(); if (_e) { flatbuffers::UnPackVector(_e, &_o->inventory); } else { _o->inventory.clear(); } };
   { auto _e = color(); _o->color = _e; };
-  { auto _e = weapons(); if (_e) { _o->weapons.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->weapons[_i] = flatbuffers::unique_ptr<MyGame::Sample::WeaponT>(_e->Get(_i)->UnPack(_resolver)); } } };
-  { auto _e = equipped_type(); _o->equipped.type = _e; };
-  { auto _e = equipped(); if (_e) _o->equipped.value = EquipmentUnion::UnPack(_e, equipped_type(), _resolver); };
-  { auto _e = path(); if (_e) { _o->path.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->path[_i] = *_e->Get(_i); } } };
+  { auto _e = weapons(); if (_e) { { _o->weapons.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if (_o->weapons[_i]) _e->Get(_i)->UnPackTo(_o->weapons[_i].get(), _resolver); else _o->weapons[_i] = flatbuffers::unique_ptr<MyGame::Sample::WeaponT>(_e->Get(_i)->UnPack(_resolver)); } } } else { _o->weapons.clear(); } };
+  { auto _e = equipped_type(); if (_o->equipped.type != _e) _o->equipped.Reset(); _o->equipped.type = _e; };
+  { auto _e = equipped(); if (_e) { _o->equipped.UnPackTo(_e, _resolver); } else { _o->equipped.Reset(); } };
+  { auto _e = path(); if (_e) { flatbuffers::UnPackVector(_e, &_o->path); } else { _o->path.clear(); } };
 }
 
 inline flatbuffers::Offset<Monster> Monster::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MonsterT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -617,6 +621,19 @@ inline flatbuffers::Offset<Monster> CreateMonster(flatbuffers::FlatBufferBuilder
       _path);
 }
 
+inline size_t MonsterT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(11, 68);
+  _size += flatbuffers::FlatBufferBuilder::StringSizeBound(name.length());
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(inventory.size(), 1, 1);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(weapons.size(), 4, 4);
+  for (size_t _i = 0; _i < weapons.size(); _i++) {
+    _size += weapons[_i].get()->SerializedSizeBound();
+  }
+  _size += equipped.SerializedSizeBound();
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(path.size(), 12, 4);
+  return _size;
+}
+
 inline WeaponT *Weapon::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new WeaponT();
   UnPackTo(_o, _resolver);
@@ -626,7 +643,7 @@ inline WeaponT *Weapon::UnPack(const flatbuffers::resolver_function_t *_resolver
 inline void Weapon::UnPackTo(WeaponT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = name(); if (_e) _o->name = _e->str(); };
+  { auto _e = name(); if (_e) { _o->name.assign(_e->c_str(), _e->size()); } else { _o->name.clear(); } };
   { auto _e = damage(); _o->damage = _e; };
 }
 
@@ -646,6 +663,12 @@ inline flatbuffers::Offset<Weapon> CreateWeapon(flatbuffers::FlatBufferBuilder &
       _damage);
 }
 
+inline size_t WeaponT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(2, 12);
+  _size += flatbuffers::FlatBufferBuilder::StringSizeBound(name.length());
+  return _size;
+}
+
 inline bool VerifyEquipment(flatbuffers::Verifier &verifier, const void *obj, Equipment type) {
   switch (type) {
     case Equipment_NONE: {
@@ -681,6 +704,18 @@ inline void *EquipmentUnion::UnPack(const void *obj, Equipment type, const flatb
   }
 }
 
+inline void EquipmentUnion::UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver) {
+  switch (type) {
+    case Equipment_Weapon: {
+      auto ptr = reinterpret_cast<const MyGame::Sample::Weapon *>(obj);
+      auto _o = reinterpret_cast<MyGame::Sample::WeaponT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> EquipmentUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   switch (type) {
     case Equipment_Weapon: {
@@ -691,6 +726,16 @@ inline flatbuffers::Offset<void> EquipmentUnion::Pack(flatbuffers::FlatBufferBui
   }
 }
 
+inline size_t EquipmentUnion::SerializedSizeBound() const {
+  switch (type) {
+    case Equipment_Weapon: {
+      auto ptr = reinterpret_cast<const MyGame::Sample::WeaponT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    default: return 0;
+  }
+}
+
 inline EquipmentUnion::EquipmentUnion(const EquipmentUnion &u) FLATBUFFERS_NOEXCEPT : type(u.type), value(nullptr) {
   switch (type) {
     case Equipment_Weapon: {
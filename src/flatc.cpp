@@ -16,46 +16,193 @@
 
 #include "flatbuffers/flatc.h"
 
+#include <atomic>
+#include <cstdio>
+#include <fstream>
 #include <list>
+#include <set>
+#include <thread>
 
 namespace flatbuffers {
 
 const char *FLATC_VERSION() { return FLATBUFFERS_VERSION(); }
 
-void FlatCompiler::ParseFile(
+bool FlatCompiler::ParseFile(
     flatbuffers::Parser &parser, const std::string &filename,
     const std::string &contents,
     std::vector<const char *> &include_directories) const {
   auto local_include_directory = flatbuffers::StripFileName(filename);
   include_directories.push_back(local_include_directory.c_str());
   include_directories.push_back(nullptr);
-  if (!parser.Parse(contents.c_str(), &include_directories[0],
-                    filename.c_str())) {
+  auto ok = parser.Parse(contents.c_str(), &include_directories[0],
+                         filename.c_str());
+  include_directories.pop_back();
+  include_directories.pop_back();
+  if (!ok) {
     Error(parser.error_, false, false);
+    return false;
   }
   if (!parser.error_.empty()) { Warn(parser.error_, false); }
-  include_directories.pop_back();
-  include_directories.pop_back();
+  return true;
 }
 
-void FlatCompiler::LoadBinarySchema(flatbuffers::Parser &parser,
+bool FlatCompiler::LoadBinarySchema(flatbuffers::Parser &parser,
                                     const std::string &filename,
                                     const std::string &contents) {
   if (!parser.Deserialize(reinterpret_cast<const uint8_t *>(contents.c_str()),
       contents.size())) {
     Error("failed to load binary schema: " + filename, false, false);
+    return false;
+  }
+  return true;
+}
+
+// Converts a newline delimited JSON file to a file of size prefixed binaries,
+// one per line, without loading all of it into memory.
+bool FlatCompiler::ParseJsonStreamFile(flatbuffers::Parser &parser,
+                                       const std::string &filename,
+                                       const std::string &output_path) const {
+  std::ifstream in(filename.c_str(), std::ifstream::in | std::ifstream::binary);
+  if (!in.is_open()) {
+    Error("unable to load file: " + filename);
+    return false;
   }
+  flatbuffers::EnsureDirExists(output_path);
+  auto out_name = BinaryFileName(
+      parser, output_path,
+      flatbuffers::StripPath(flatbuffers::StripExtension(filename)));
+  std::ofstream out(out_name.c_str(),
+                    std::ofstream::out | std::ofstream::binary);
+  if (!out.is_open()) {
+    Error("unable to write file: " + out_name, false);
+    return false;
+  }
+  auto reader = [&](char *buf, size_t size) {
+    in.read(buf, static_cast<std::streamsize>(size));
+    return static_cast<size_t>(in.gcount());
+  };
+  auto sink = [&](const uint8_t *buf, size_t size) {
+    out.write(reinterpret_cast<const char *>(buf),
+              static_cast<std::streamsize>(size));
+    return !out.bad();
+  };
+  if (!parser.ParseJsonStream(reader, sink, filename.c_str())) {
+    // Don't leave the lines before the error behind as if they were all.
+    out.close();
+    std::remove(out_name.c_str());
+    Error(parser.error_, false, false);
+    return false;
+  }
+  return true;
+}
+
+namespace {
+
+// A warning or error issued while compiling a file on a worker thread.
+struct DeferredMessage {
+  bool is_error;
+  std::string text;
+  bool usage;
+  bool show_exe_name;
+};
+
+// Set on worker threads, so messages are reported in command line order once
+// all files have been compiled.
+thread_local std::vector<DeferredMessage> *deferred_messages = nullptr;
+
+// Set on worker threads to the index of the first file with an error so far.
+thread_local const std::atomic<size_t> *deferred_first_error = nullptr;
+
+// Whether a worker thread should not write the outputs of a file, because a
+// file before it has an error.
+bool SkipOutput(size_t file_index) {
+  return deferred_first_error && file_index > *deferred_first_error;
 }
 
+}  // namespace
+
 void FlatCompiler::Warn(const std::string &warn, bool show_exe_name) const {
+  if (deferred_messages) {
+    DeferredMessage message = { false, warn, false, show_exe_name };
+    deferred_messages->push_back(message);
+    return;
+  }
   params_.warn_fn(this, warn, show_exe_name);
 }
 
 void FlatCompiler::Error(const std::string &err, bool usage,
                          bool show_exe_name) const {
+  if (deferred_messages) {
+    DeferredMessage message = { true, err, usage, show_exe_name };
+    deferred_messages->push_back(message);
+    return;
+  }
   params_.error_fn(this, err, usage, show_exe_name);
 }
 
+bool FlatCompiler::CompileInParallel(
+    flatbuffers::Parser &parser, size_t begin, size_t end, size_t jobs,
+    const CompileFileFn &compile_file) const {
+  // Each worker gets its own copy of the schema, made by deserializing it.
+  // Builtin attributes are needed to parse JSON into nested flatbuffers.
+  auto builtins = parser.opts.binary_schema_builtins;
+  parser.opts.binary_schema_builtins = true;
+  parser.Serialize();
+  parser.opts.binary_schema_builtins = builtins;
+  std::vector<std::unique_ptr<flatbuffers::Parser>> parsers(jobs);
+  for (auto it = parsers.begin(); it != parsers.end(); ++it) {
+    it->reset(new flatbuffers::Parser(parser.opts));
+    if (!(*it)->Deserialize(parser.builder_.GetBufferPointer(),
+                            parser.builder_.GetSize())) {
+      return false;
+    }
+    (*it)->MarkGenerated();
+  }
+
+  std::vector<std::vector<DeferredMessage>> messages(end - begin);
+  std::atomic<size_t> next_file(begin);
+  // Files after the first one with an error are skipped, as they would be
+  // when compiling one file at a time. One that is already being compiled
+  // when the error is found stops before writing its output (see
+  // SkipOutput), unless it had already started writing it.
+  std::atomic<size_t> first_error(end);
+  auto work = [&](std::unique_ptr<flatbuffers::Parser> &worker_parser) {
+    deferred_first_error = &first_error;
+    for (;;) {
+      auto file_index = next_file++;
+      if (file_index >= end || file_index > first_error) break;
+      deferred_messages = &messages[file_index - begin];
+      auto ok = compile_file(worker_parser, file_index);
+      deferred_messages = nullptr;
+      if (ok) continue;
+      auto error = first_error.load();
+      while (file_index < error &&
+             !first_error.compare_exchange_weak(error, file_index)) {}
+    }
+    deferred_first_error = nullptr;
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < jobs; i++) {
+    threads.push_back(std::thread(work, std::ref(parsers[i])));
+  }
+  work(parsers[0]);
+  for (auto it = threads.begin(); it != threads.end(); ++it) it->join();
+
+  // Report messages up to the first error only, like a sequential run.
+  auto reported = (first_error < end ? first_error + 1 : end) - begin;
+  for (size_t i = 0; i < reported; i++) {
+    auto &file_messages = messages[i];
+    for (auto m = file_messages.begin(); m != file_messages.end(); ++m) {
+      if (m->is_error) {
+        Error(m->text, m->usage, m->show_exe_name);
+      } else {
+        Warn(m->text, m->show_exe_name);
+      }
+    }
+  }
+  return true;
+}
+
 std::string FlatCompiler::GetUsageString(const char *program_name) const {
   std::stringstream ss;
   ss << "Usage: " << program_name << " [OPTION]... FILE... [-- FILE...]\n";
@@ -73,6 +220,7 @@ std::string FlatCompiler::GetUsageString(const char *program_name) const {
   ss <<
     "  -o PATH            Prefix PATH to all generated files.\n"
     "  -I PATH            Search for includes in the specified path.\n"
+    "  --jobs N           Compile JSON and binary FILEs with N threads.\n"
     "  -M                 Print make rules for generated files.\n"
     "  --version          Print the version number of flatc and exit.\n"
     "  --strict-json      Strict JSON: field names must be / will be quoted,\n"
@@ -115,6 +263,9 @@ std::string FlatCompiler::GetUsageString(const char *program_name) const {
     "                     (see the --cpp-str-flex-ctor option to change this behavior).\n"
     "  --cpp-str-flex-ctor Don't construct custom string types by passing std::string\n"
     "                     from Flatbuffers, but (char* + length).\n"
+    "  --cpp-object-api-allocator Allocate object API types, their strings and\n"
+    "                     vectors from a flatbuffers::NativeArena, and add\n"
+    "                     UnPack(arena) overloads (see flatbuffers/arena.h).\n"
     "  --object-prefix    Customise class prefix for C++ object-based API.\n"
     "  --object-suffix    Customise class suffix for C++ object-based API.\n"
     "                     Default value is \"T\".\n"
@@ -127,6 +278,9 @@ std::string FlatCompiler::GetUsageString(const char *program_name) const {
     "  --raw-binary       Allow binaries without file_indentifier to be read.\n"
     "                     This may crash flatc given a mismatched schema.\n"
     "  --size-prefixed    Input binaries are size prefixed buffers.\n"
+    "  --ndjson           JSON FILEs hold one object per line (use with -b).\n"
+    "                     Each is streamed to a size prefixed buffer, and the\n"
+    "                     buffers are written one after the other.\n"
     "  --proto            Input is a .proto, translate to .fbs.\n"
     "  --oneof-union      Translate .proto oneofs to flatbuffer unions.\n"
     "  --grpc             Generate GRPC interfaces for the specified languages.\n"
@@ -169,6 +323,7 @@ int FlatCompiler::Compile(int argc, const char **argv) {
   bool any_generator = false;
   bool print_make_rules = false;
   bool raw_binary = false;
+  bool ndjson = false;
   bool schema_binary = false;
   bool grpc_enabled = false;
   std::vector<std::string> filenames;
@@ -178,6 +333,7 @@ int FlatCompiler::Compile(int argc, const char **argv) {
   std::vector<bool> generator_enabled(params_.num_generators, false);
   size_t binary_files_from = std::numeric_limits<size_t>::max();
   std::string conform_to_schema;
+  size_t jobs = 1;
 
   for (int argi = 0; argi < argc; argi++) {
     std::string arg = argv[argi];
@@ -194,6 +350,12 @@ int FlatCompiler::Compile(int argc, const char **argv) {
             flatbuffers::PosixPath(argv[argi]));
         include_directories.push_back(
             include_directories_storage.back().c_str());
+      } else if (arg == "--jobs") {
+        if (++argi >= argc) Error("missing count following: " + arg, true);
+        auto count = atoi(argv[argi]);
+        if (count < 1)
+          Error("invalid thread count: " + std::string(argv[argi]), true);
+        jobs = static_cast<size_t>(count);
       } else if (arg == "--conform") {
         if (++argi >= argc) Error("missing path following" + arg, true);
         conform_to_schema = flatbuffers::PosixPath(argv[argi]);
@@ -259,6 +421,8 @@ int FlatCompiler::Compile(int argc, const char **argv) {
         opts.cpp_object_api_string_type = argv[argi];
       } else if (arg == "--cpp-str-flex-ctor") {
         opts.cpp_object_api_string_flexible_constructor = true;
+      } else if (arg == "--cpp-object-api-allocator") {
+        opts.cpp_object_api_allocator = true;
       } else if (arg == "--gen-nullable") {
         opts.gen_nullable = true;
       } else if (arg == "--gen-generated") {
@@ -283,6 +447,8 @@ int FlatCompiler::Compile(int argc, const char **argv) {
         raw_binary = true;
       } else if (arg == "--size-prefixed") {
         opts.size_prefixed = true;
+      } else if (arg == "--ndjson") {
+        ndjson = true;
       } else if (arg == "--") {  // Separator between text and binary inputs.
         binary_files_from = filenames.size();
       } else if (arg == "--proto") {
@@ -347,6 +513,10 @@ int FlatCompiler::Compile(int argc, const char **argv) {
     Error("no options: specify at least one generator.", true);
   }
 
+  if (ndjson && !(opts.lang_to_generate & IDLOptions::kBinary)) {
+    Error("--ndjson requires -b", true);
+  }
+
   flatbuffers::Parser conform_parser;
   if (!conform_to_schema.empty()) {
     std::string contents;
@@ -362,20 +532,33 @@ int FlatCompiler::Compile(int argc, const char **argv) {
     }
   }
 
-  std::unique_ptr<flatbuffers::Parser> parser(new flatbuffers::Parser(opts));
-
-  for (auto file_it = filenames.begin(); file_it != filenames.end();
-       ++file_it) {
-    auto &filename = *file_it;
-    std::string contents;
-    if (!flatbuffers::LoadFile(filename.c_str(), true, &contents))
-      Error("unable to load file: " + filename);
+  auto is_data_file = [&](size_t file_index) {
+    auto ext = flatbuffers::GetExtension(filenames[file_index]);
+    return file_index >= binary_files_from ||
+           (ext != "fbs" && ext != "proto" &&
+            ext != reflection::SchemaExtension());
+  };
 
-    bool is_binary =
-        static_cast<size_t>(file_it - filenames.begin()) >= binary_files_from;
+  // Compiles one input file. Schemas replace `parser`, other files are
+  // parsed with the schema it holds. Returns false as soon as there is an
+  // error, which only happens on worker threads: otherwise Error() exits.
+  auto compile_file = [&](std::unique_ptr<flatbuffers::Parser> &parser,
+                          size_t file_index) {
+    auto &filename = filenames[file_index];
+    bool is_binary = file_index >= binary_files_from;
     auto ext = flatbuffers::GetExtension(filename);
     auto is_schema = ext == "fbs" || ext == "proto";
     auto is_binary_schema = ext == reflection::SchemaExtension();
+    if (ndjson && !is_binary && !is_schema && !is_binary_schema) {
+      return print_make_rules ||
+             ParseJsonStreamFile(*parser.get(), filename, output_path);
+    }
+
+    std::string contents;
+    if (!flatbuffers::LoadFile(filename.c_str(), true, &contents)) {
+      Error("unable to load file: " + filename);
+      return false;
+    }
     if (is_binary) {
       parser->builder_.Clear();
       parser->builder_.PushFlatBuffer(
@@ -392,18 +575,21 @@ int FlatCompiler::Compile(int argc, const char **argv) {
                 filename +
                 "\" matches the schema, use --raw-binary to read this file"
                 " anyway.");
+          return false;
         } else if (!flatbuffers::BufferHasIdentifier(
                        contents.c_str(), parser->file_identifier_.c_str(), opts.size_prefixed)) {
           Error("binary \"" + filename +
                 "\" does not have expected file_identifier \"" +
                 parser->file_identifier_ +
                 "\", use --raw-binary to read this file anyway.");
+          return false;
         }
       }
     } else {
       // Check if file contains 0 bytes.
       if (!is_binary_schema && contents.length() != strlen(contents.c_str())) {
         Error("input file appears to be binary: " + filename, true);
+        return false;
       }
       if (is_schema) {
         // If we're processing multiple schemas, make sure to start each
@@ -412,20 +598,29 @@ int FlatCompiler::Compile(int argc, const char **argv) {
         parser.reset(new flatbuffers::Parser(opts));
       }
       if (is_binary_schema) {
-        LoadBinarySchema(*parser.get(), filename, contents);
+        if (!LoadBinarySchema(*parser.get(), filename, contents)) return false;
       } else {
-        ParseFile(*parser.get(), filename, contents, include_directories);
+        // ParseFile adds to the include directories, so use a copy.
+        auto file_include_directories = include_directories;
+        if (!ParseFile(*parser.get(), filename, contents,
+                       file_include_directories)) {
+          return false;
+        }
         if (!is_schema && !parser->builder_.GetSize()) {
           // If a file doesn't end in .fbs, it must be json/binary. Ensure we
           // didn't just parse a schema with a different extension.
           Error("input file is neither json nor a .fbs (schema) file: " +
                     filename,
                 true);
+          return false;
         }
       }
       if ((is_schema || is_binary_schema) && !conform_to_schema.empty()) {
         auto err = parser->ConformTo(conform_parser);
-        if (!err.empty()) Error("schemas don\'t conform: " + err);
+        if (!err.empty()) {
+          Error("schemas don\'t conform: " + err);
+          return false;
+        }
       }
       if (schema_binary) {
         parser->Serialize();
@@ -433,6 +628,8 @@ int FlatCompiler::Compile(int argc, const char **argv) {
       }
     }
 
+    if (SkipOutput(file_index)) return true;
+
     std::string filebase =
         flatbuffers::StripPath(flatbuffers::StripExtension(filename));
 
@@ -447,6 +644,7 @@ int FlatCompiler::Compile(int argc, const char **argv) {
                                               filebase)) {
             Error(std::string("Unable to generate ") +
                   params_.generators[i].lang_name + " for " + filebase);
+            return false;
           }
         } else {
           std::string make_rule = params_.generators[i].make_rule(
@@ -461,6 +659,7 @@ int FlatCompiler::Compile(int argc, const char **argv) {
                                                     filebase)) {
               Error(std::string("Unable to generate GRPC interface for") +
                     params_.generators[i].lang_name);
+              return false;
             }
           } else {
             Warn(std::string("GRPC interface generator not implemented for ") +
@@ -471,10 +670,13 @@ int FlatCompiler::Compile(int argc, const char **argv) {
     }
 
     if (!opts.root_type.empty()) {
-      if (!parser->SetRootType(opts.root_type.c_str()))
+      if (!parser->SetRootType(opts.root_type.c_str())) {
         Error("unknown root type: " + opts.root_type);
-      else if (parser->root_struct_def_->fixed)
+        return false;
+      } else if (parser->root_struct_def_->fixed) {
         Error("root type must be a table");
+        return false;
+      }
     }
 
     if (opts.proto_mode) GenerateFBS(*parser.get(), output_path, filebase);
@@ -482,6 +684,33 @@ int FlatCompiler::Compile(int argc, const char **argv) {
     // We do not want to generate code for the definitions in this file
     // in any files coming up next.
     parser->MarkGenerated();
+    return true;
+  };
+
+  std::unique_ptr<flatbuffers::Parser> parser(new flatbuffers::Parser(opts));
+
+  for (size_t file_index = 0; file_index < filenames.size(); file_index++) {
+    // Runs of JSON and binary files can be compiled in parallel, except when
+    // their output depends on the order they are compiled in.
+    if (jobs > 1 && !print_make_rules && !schema_binary &&
+        is_data_file(file_index)) {
+      auto end = file_index;
+      std::set<std::string> filebases;
+      while (end < filenames.size() && is_data_file(end) &&
+             filebases.insert(flatbuffers::StripPath(
+                                  flatbuffers::StripExtension(filenames[end])))
+                 .second) {
+        end++;
+      }
+      if (end - file_index > 1 &&
+          CompileInParallel(*parser.get(), file_index, end,
+                            (std::min)(jobs, end - file_index),
+                            compile_file)) {
+        file_index = end - 1;
+        continue;
+      }
+    }
+    compile_file(parser, file_index);
   }
   return 0;
 }
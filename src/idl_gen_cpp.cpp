@@ -242,6 +242,7 @@ class CppGenerator : public BaseGenerator {
     if (parser_.uses_flexbuffers_) {
       code_ += "#include \"flatbuffers/flexbuffers.h\"";
     }
+    if (UseNativeArena()) { code_ += "#include \"flatbuffers/arena.h\""; }
     code_ += "";
 
     if (parser_.opts.include_dependence_headers) { GenIncludeDependencies(); }
@@ -492,6 +493,17 @@ class CppGenerator : public BaseGenerator {
         code_ += "(GetSizePrefixed{{STRUCT_NAME}}(buf)->UnPack(res));";
         code_ += "}";
         code_ += "";
+
+        if (UseNativeArena()) {
+          code_.SetValue("NATIVE_NAME", native_name);
+          code_ += "inline {{NATIVE_NAME}} *UnPack{{STRUCT_NAME}}(";
+          code_ += "    const void *buf,";
+          code_ += "    flatbuffers::NativeArena &arena,";
+          code_ += "    const flatbuffers::resolver_function_t *res = nullptr) {";
+          code_ += "  return Get{{STRUCT_NAME}}(buf)->UnPack(arena, res);";
+          code_ += "}";
+          code_ += "";
+        }
       }
     }
 
@@ -611,10 +623,18 @@ class CppGenerator : public BaseGenerator {
     return attr ? attr->constant : parser_.opts.cpp_object_api_pointer_type;
   }
 
+  // Whether native objects are allocated from a flatbuffers::NativeArena.
+  bool UseNativeArena() const {
+    return parser_.opts.generate_object_based_api &&
+           parser_.opts.cpp_object_api_allocator;
+  }
+
   const std::string NativeString(const FieldDef *field) {
     auto attr = field ? field->attributes.Lookup("cpp_str_type") : nullptr;
     auto &ret = attr ? attr->constant : parser_.opts.cpp_object_api_string_type;
-    if (ret.empty()) { return "std::string"; }
+    if (ret.empty()) {
+      return UseNativeArena() ? "flatbuffers::native_string" : "std::string";
+    }
     return ret;
   }
 
@@ -622,12 +642,30 @@ class CppGenerator : public BaseGenerator {
     auto attr = field
                     ? (field->attributes.Lookup("cpp_str_flex_ctor") != nullptr)
                     : false;
-    auto ret =
-        attr ? attr : parser_.opts.cpp_object_api_string_flexible_constructor;
+    auto ret = attr ? attr
+                    : parser_.opts.cpp_object_api_string_flexible_constructor ||
+                          UseNativeArena();
     return ret && NativeString(field) !=
                       "std::string";  // Only for custom string types.
   }
 
+  // Whether a native string can be assigned in place, reusing its capacity.
+  bool AssignableString(const FieldDef &field) {
+    const auto type = NativeString(&field);
+    return type == "std::string" || type == "flatbuffers::native_string";
+  }
+
+  // Whether UnPackTo() may unpack into the object a field already points to,
+  // which is only safe if the field is its sole owner.
+  bool UnPacksInPlace(const FieldDef &field) {
+    auto ptr_type = PtrType(&field);
+    if (ptr_type == "default_ptr_type") {
+      ptr_type = parser_.opts.cpp_object_api_pointer_type;
+    }
+    return ptr_type == "std::unique_ptr" ||
+           ptr_type == "flatbuffers::unique_ptr";
+  }
+
   std::string GenTypeNativePtr(const std::string &type, const FieldDef *field,
                                bool is_constructor) {
     auto &ptr_type = PtrType(field);
@@ -664,6 +702,9 @@ class CppGenerator : public BaseGenerator {
               type.struct_def->attributes.Lookup("native_custom_alloc");
           return "std::vector<" + type_name + "," +
                  native_custom_alloc->constant + "<" + type_name + ">>";
+        } else if (UseNativeArena()) {
+          return "std::vector<" + type_name + ", flatbuffers::NativeAllocator<" +
+                 type_name + ">>";
         } else
           return "std::vector<" + type_name + ">";
       }
@@ -772,6 +813,12 @@ class CppGenerator : public BaseGenerator {
            " type, const flatbuffers::resolver_function_t *resolver)";
   }
 
+  std::string UnionUnPackToSignature(const EnumDef &enum_def, bool inclass) {
+    return "void " + (inclass ? "" : Name(enum_def) + "Union::") +
+           "UnPackTo(const void *obj, "
+           "const flatbuffers::resolver_function_t *resolver)";
+  }
+
   std::string UnionPackSignature(const EnumDef &enum_def, bool inclass) {
     return "flatbuffers::Offset<void> " +
            (inclass ? "" : Name(enum_def) + "Union::") +
@@ -815,6 +862,25 @@ class CppGenerator : public BaseGenerator {
            (inclass ? " = nullptr" : "") + ") const";
   }
 
+  std::string TableUnPackArenaSignature(const StructDef &struct_def,
+                                        bool inclass, const IDLOptions &opts) {
+    return NativeName(Name(struct_def), &struct_def, opts) + " *" +
+           (inclass ? "" : Name(struct_def) + "::") +
+           "UnPack(flatbuffers::NativeArena &_arena, "
+           "const flatbuffers::resolver_function_t *_resolver" +
+           (inclass ? " = nullptr" : "") + ") const";
+  }
+
+  std::string TableUnPackToArenaSignature(const StructDef &struct_def,
+                                          bool inclass,
+                                          const IDLOptions &opts) {
+    return "void " + (inclass ? "" : Name(struct_def) + "::") +
+           "UnPackTo(flatbuffers::NativeArena &_arena, " +
+           NativeName(Name(struct_def), &struct_def, opts) + " *" +
+           "_o, const flatbuffers::resolver_function_t *_resolver" +
+           (inclass ? " = nullptr" : "") + ") const";
+  }
+
   void GenMiniReflectPre(const StructDef *struct_def) {
     code_.SetValue("NAME", struct_def->name);
     code_ += "inline const flatbuffers::TypeTable *{{NAME}}TypeTable();";
@@ -1162,7 +1228,9 @@ class CppGenerator : public BaseGenerator {
         code_ += "";
       }
       code_ += "  " + UnionUnPackSignature(enum_def, true) + ";";
+      code_ += "  " + UnionUnPackToSignature(enum_def, true) + ";";
       code_ += "  " + UnionPackSignature(enum_def, true) + ";";
+      code_ += "  size_t SerializedSizeBound() const;";
       code_ += "";
 
       for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
@@ -1336,6 +1404,45 @@ class CppGenerator : public BaseGenerator {
       code_ += "}";
       code_ += "";
 
+      // Generate the union UnPackTo() function, which unpacks into the value
+      // the union already holds, if any: `type` must be that of `obj`.
+      code_ += "inline " + UnionUnPackToSignature(enum_def, false) + " {";
+      code_ += "  switch (type) {";
+      for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
+           ++it) {
+        const auto &ev = **it;
+        if (ev.IsZero()) { continue; }
+
+        code_.SetValue("LABEL", GetEnumValUse(enum_def, ev));
+        code_.SetValue("TYPE", GetUnionElement(ev, true, true));
+        code_.SetValue("NATIVE_TYPE",
+                       NativeName(GetUnionElement(ev, true, true, true),
+                                  ev.union_type.struct_def, parser_.opts));
+        code_ += "    case {{LABEL}}: {";
+        code_ += "      auto ptr = reinterpret_cast<const {{TYPE}} *>(obj);";
+        code_ += "      auto _o = reinterpret_cast<{{NATIVE_TYPE}} *>(value);";
+        if (ev.union_type.base_type == BASE_TYPE_STRUCT) {
+          if (ev.union_type.struct_def->fixed) {
+            code_ += "      if (_o) *_o = *ptr; else value = UnPack(obj, type, "
+                     "resolver);";
+          } else {
+            code_ += "      if (_o) ptr->UnPackTo(_o, resolver); else value = "
+                     "UnPack(obj, type, resolver);";
+          }
+        } else if (ev.union_type.base_type == BASE_TYPE_STRING) {
+          code_ += "      if (_o) _o->assign(ptr->c_str(), ptr->size()); else "
+                   "value = UnPack(obj, type, resolver);";
+        } else {
+          FLATBUFFERS_ASSERT(false);
+        }
+        code_ += "      break;";
+        code_ += "    }";
+      }
+      code_ += "    default: break;";
+      code_ += "  }";
+      code_ += "}";
+      code_ += "";
+
       code_ += "inline " + UnionPackSignature(enum_def, false) + " {";
       code_ += "  switch (type) {";
       for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
@@ -1369,6 +1476,45 @@ class CppGenerator : public BaseGenerator {
       code_ += "}";
       code_ += "";
 
+      // Generate the union SerializedSizeBound() function, an upper bound on
+      // the buffer space Pack() takes.
+      code_ += "inline size_t {{ENUM_NAME}}Union::SerializedSizeBound() const {";
+      code_ += "  switch (type) {";
+      for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
+           ++it) {
+        auto &ev = **it;
+        if (ev.IsZero()) { continue; }
+
+        code_.SetValue("LABEL", GetEnumValUse(enum_def, ev));
+        code_.SetValue("TYPE",
+                       NativeName(GetUnionElement(ev, true, true, true),
+                                  ev.union_type.struct_def, parser_.opts));
+        code_ += "    case {{LABEL}}: {";
+        if (ev.union_type.base_type == BASE_TYPE_STRUCT &&
+            ev.union_type.struct_def->fixed) {
+          code_.SetValue("SIZE",
+                         NumToString(InlineSize(ev.union_type) +
+                                     InlineAlignment(ev.union_type)));
+          code_ += "      return {{SIZE}};";
+        } else {
+          code_ += "      auto ptr = reinterpret_cast<const {{TYPE}} *>(value);";
+          if (ev.union_type.base_type == BASE_TYPE_STRUCT) {
+            code_ += "      return ptr->SerializedSizeBound();";
+          } else if (ev.union_type.base_type == BASE_TYPE_STRING) {
+            code_ +=
+                "      return flatbuffers::FlatBufferBuilder::StringSizeBound("
+                "ptr->size());";
+          } else {
+            FLATBUFFERS_ASSERT(false);
+          }
+        }
+        code_ += "    }";
+      }
+      code_ += "    default: return 0;";
+      code_ += "  }";
+      code_ += "}";
+      code_ += "";
+
       // Union copy constructor
       code_ +=
           "inline {{ENUM_NAME}}Union::{{ENUM_NAME}}Union(const "
@@ -1667,6 +1813,14 @@ class CppGenerator : public BaseGenerator {
                "<{{NATIVE_NAME}}>().deallocate(static_cast<{{NATIVE_NAME}}*>("
                "ptr),1);";
       code_ += "  }";
+    } else if (UseNativeArena() && struct_def.minalign <= 16) {
+      // Structs aligned beyond NativeArena::kMaxAlign stay on the heap.
+      code_ += "  static void *operator new(std::size_t size) {";
+      code_ += "    return flatbuffers::NativeArena::NewObject(size);";
+      code_ += "  }";
+      code_ += "  static void operator delete(void *ptr) {";
+      code_ += "    flatbuffers::NativeArena::DeleteObject(ptr);";
+      code_ += "  }";
     }
   }
 
@@ -1686,6 +1840,7 @@ class CppGenerator : public BaseGenerator {
     }
     GenOperatorNewDelete(struct_def);
     GenDefaultConstructor(struct_def);
+    code_ += "  size_t SerializedSizeBound() const;";
     code_ += "};";
     if (parser_.opts.gen_compare) GenCompareOperator(struct_def);
     code_ += "";
@@ -1726,6 +1881,10 @@ class CppGenerator : public BaseGenerator {
       }
       case BASE_TYPE_VECTOR: {
         code_ += "{{PRE}}verifier.VerifyVector({{NAME}}())\\";
+        if (field.flexbuffer) {
+          code_ += "{{PRE}}flexbuffers::VerifyNestedFlexBuffer({{NAME}}(), "
+                   "verifier)\\";
+        }
 
         switch (field.value.type.element) {
           case BASE_TYPE_STRING: {
@@ -1999,6 +2158,14 @@ class CppGenerator : public BaseGenerator {
           "  " + TableUnPackSignature(struct_def, true, parser_.opts) + ";";
       code_ +=
           "  " + TableUnPackToSignature(struct_def, true, parser_.opts) + ";";
+      if (UseNativeArena()) {
+        code_ += "  " +
+                 TableUnPackArenaSignature(struct_def, true, parser_.opts) +
+                 ";";
+        code_ += "  " +
+                 TableUnPackToArenaSignature(struct_def, true, parser_.opts) +
+                 ";";
+      }
       code_ += "  " + TablePackSignature(struct_def, true, parser_.opts) + ";";
     }
 
@@ -2307,6 +2474,19 @@ class CppGenerator : public BaseGenerator {
             field.value.type.element == BASE_TYPE_UTYPE
                 ? ".type"
                 : (field.value.type.element == BASE_TYPE_UNION ? ".value" : "");
+        // Vectors of scalars and structs whose native type is the one in the
+        // buffer are copied in bulk where possible, of the form:
+        //   flatbuffers::UnPackVector(_e, &_o->field);
+        const auto vector_type = field.value.type.VectorType();
+        if (!cpp_type &&
+            ((IsScalar(vector_type.base_type) &&
+              vector_type.base_type != BASE_TYPE_BOOL &&
+              vector_type.base_type != BASE_TYPE_UTYPE) ||
+             (IsStruct(vector_type) &&
+              !vector_type.struct_def->attributes.Lookup("native_type")))) {
+          code += "flatbuffers::UnPackVector(_e, &_o->" + name + ");";
+          break;
+        }
         code += "{ _o->" + name + ".resize(_e->size()); ";
         code += "for (flatbuffers::uoffset_t _i = 0;";
         code += " _i < _e->size(); _i++) { ";
@@ -2331,6 +2511,24 @@ class CppGenerator : public BaseGenerator {
             // GenTypeNativePtr(cpp_type->constant, &field, true) + "();";
             code += "/* else do nothing */";
           }
+        } else if (vector_type.base_type == BASE_TYPE_UTYPE) {
+          // A union whose type changes drops its old value.
+          const auto elem = "_o->" + name + "[_i]";
+          code += "if (" + elem + ".type != " + indexing + ") " + elem +
+                  ".Reset(); ";
+          code += elem + ".type = " + indexing;
+        } else if (vector_type.base_type == BASE_TYPE_UNION) {
+          code += "_o->" + name + "[_i].UnPackTo(_e->Get(_i), _resolver)";
+        } else if (vector_type.base_type == BASE_TYPE_STRING &&
+                   AssignableString(field)) {
+          code += "_o->" + name + "[_i].assign(_e->Get(_i)->c_str(), " +
+                  "_e->Get(_i)->size())";
+        } else if (vector_type.base_type == BASE_TYPE_STRUCT &&
+                   !IsStruct(vector_type) && UnPacksInPlace(field)) {
+          const auto elem = "_o->" + name + "[_i]";
+          code += "if (" + elem + ") _e->Get(_i)->UnPackTo(" + elem +
+                  GenPtrGet(field) + ", _resolver); else ";
+          code += elem + " = " + GenUnpackVal(vector_type, indexing, true, field);
         } else {
           code += "_o->" + name + "[_i]" + access + " = ";
           code += GenUnpackVal(field.value.type.VectorType(), indexing, true,
@@ -2343,16 +2541,17 @@ class CppGenerator : public BaseGenerator {
         FLATBUFFERS_ASSERT(union_field->value.type.base_type ==
                            BASE_TYPE_UNION);
         // Generate code that sets the union type, of the form:
-        //   _o->field.type = _e;
-        code += "_o->" + union_field->name + ".type = _e;";
+        //   if (_o->field.type != _e) _o->field.Reset(); _o->field.type = _e;
+        const auto value = "_o->" + union_field->name;
+        code += "if (" + value + ".type != _e) " + value + ".Reset(); ";
+        code += value + ".type = _e;";
         break;
       }
       case BASE_TYPE_UNION: {
-        // Generate code that sets the union value, of the form:
-        //   _o->field.value = Union::Unpack(_e, field_type(), resolver);
-        code += "_o->" + Name(field) + ".value = ";
-        code += GenUnionUnpackVal(field, "", "");
-        code += ";";
+        // Generate code that sets the union value (its type was set from the
+        // preceding type field), of the form:
+        //   _o->field.UnPackTo(_e, resolver);
+        code += "_o->" + Name(field) + ".UnPackTo(_e, _resolver);";
         break;
       }
       default: {
@@ -2377,6 +2576,29 @@ class CppGenerator : public BaseGenerator {
             // GenTypeNativePtr(cpp_type->constant, &field, true) + "();";
             code += "/* else do nothing */;";
           }
+        } else if (field.value.type.base_type == BASE_TYPE_STRING &&
+                   AssignableString(field)) {
+          // Generate code that reuses the string's capacity, of the form:
+          //  _o->field.assign(_e->c_str(), _e->size());
+          code += "_o->" + Name(field) + ".assign(_e->c_str(), _e->size());";
+        } else if (field.value.type.base_type == BASE_TYPE_STRUCT &&
+                   UnPacksInPlace(field) &&
+                   !field.value.type.struct_def->attributes.Lookup(
+                       "native_type") &&
+                   !field.native_inline) {
+          // Generate code that reuses an object the field already owns, of the
+          // form:
+          //  if (_o->field) _e->UnPackTo(_o->field.get(), _resolver);
+          //  else _o->field = value;
+          const auto value = "_o->" + Name(field);
+          if (IsStruct(field.value.type)) {
+            code += "if (" + value + ") *" + value + " = *_e; else ";
+          } else {
+            code += "if (" + value + ") _e->UnPackTo(" + value +
+                    GenPtrGet(field) + ", _resolver); else ";
+          }
+          code += value + " = ";
+          code += GenUnpackVal(field.value.type, "_e", false, field) + ";";
         } else {
           // Generate code for assigning the value, of the form:
           //  _o->field = value;
@@ -2389,6 +2611,38 @@ class CppGenerator : public BaseGenerator {
     return code;
   }
 
+  // Generate code that resets a field that is absent from the buffer, so that
+  // unpacking into a reused object leaves no values of the previous one.
+  std::string GenUnpackFieldClear(const FieldDef &field) {
+    const auto value = "_o->" + Name(field);
+    switch (field.value.type.base_type) {
+      case BASE_TYPE_STRING: {
+        return AssignableString(field) ? value + ".clear();" : "";
+      }
+      case BASE_TYPE_VECTOR: {
+        if (field.value.type.element == BASE_TYPE_UTYPE) {
+          return "_o->" + StripUnionType(Name(field)) + ".clear();";
+        }
+        return value + ".clear();";
+      }
+      case BASE_TYPE_UNION: {
+        return value + ".Reset();";
+      }
+      case BASE_TYPE_STRUCT: {
+        if (field.native_inline ||
+            field.value.type.struct_def->attributes.Lookup("native_type")) {
+          if (!IsStruct(field.value.type)) return "";
+          return value + " = " + GenTypeNative(field.value.type, false, field) +
+                 "();";
+        }
+        return UnPacksInPlace(field) ? value + ".reset();" : "";
+      }
+      default: {
+        return "";
+      }
+    }
+  }
+
   std::string GenCreateParam(const FieldDef &field) {
     const IDLOptions &opts = parser_.opts;
 
@@ -2485,7 +2739,16 @@ class CppGenerator : public BaseGenerator {
             break;
           }
           case BASE_TYPE_BOOL: {
-            code += "_fbb.CreateVector(" + value + ")";
+            if (UseNativeArena()) {
+              // Only std::vector<bool> with the default allocator has a
+              // CreateVector() overload.
+              code += "_fbb.CreateVector<uint8_t>(" + value +
+                      ".size(), [](size_t i, _VectorArgs *__va) { "
+                      "return static_cast<uint8_t>(__va->_" +
+                      value + "[i]); }, &_va)";
+            } else {
+              code += "_fbb.CreateVector(" + value + ")";
+            }
             break;
           }
           case BASE_TYPE_UNION: {
@@ -2608,11 +2871,37 @@ class CppGenerator : public BaseGenerator {
         auto prefix = "  { auto _e = {{FIELD_NAME}}(); ";
         auto check = IsScalar(field.value.type.base_type) ? "" : "if (_e) ";
         auto postfix = " };";
-        code_ += std::string(prefix) + check + statement + postfix;
+        const auto clear = GenUnpackFieldClear(field);
+        if (clear.empty()) {
+          code_ += std::string(prefix) + check + statement + postfix;
+        } else {
+          code_ += std::string(prefix) + "if (_e) { " + statement +
+                   " } else { " + clear + " }" + postfix;
+        }
       }
       code_ += "}";
       code_ += "";
 
+      if (UseNativeArena()) {
+        // Generate the X::UnPack() and X::UnPackTo() overloads that allocate
+        // the whole object tree from an arena.
+        code_ += "inline " +
+                 TableUnPackArenaSignature(struct_def, false, parser_.opts) +
+                 " {";
+        code_ += "  flatbuffers::NativeArena::Scope _scope(_arena);";
+        code_ += "  return UnPack(_resolver);";
+        code_ += "}";
+        code_ += "";
+
+        code_ += "inline " +
+                 TableUnPackToArenaSignature(struct_def, false, parser_.opts) +
+                 " {";
+        code_ += "  flatbuffers::NativeArena::Scope _scope(_arena);";
+        code_ += "  UnPackTo(_o, _resolver);";
+        code_ += "}";
+        code_ += "";
+      }
+
       // Generate the X::Pack member function that simply calls the global
       // CreateX function.
       code_ += "inline " + TablePackSignature(struct_def, false, parser_.opts) +
@@ -2673,6 +2962,94 @@ class CppGenerator : public BaseGenerator {
       code_ += ");";
       code_ += "}";
       code_ += "";
+
+      // Generate the X::SerializedSizeBound() method, an upper bound on the
+      // buffer space CreateX() takes for this object.
+      size_t inline_size = 0;
+      for (auto it = struct_def.fields.vec.begin();
+           it != struct_def.fields.vec.end(); ++it) {
+        const auto &field = **it;
+        if (field.deprecated) { continue; }
+        inline_size +=
+            InlineSize(field.value.type) + InlineAlignment(field.value.type);
+      }
+      code_.SetValue("NUM_FIELDS", NumToString(struct_def.fields.vec.size()));
+      code_.SetValue("INLINE_SIZE", NumToString(inline_size));
+      code_ += "inline size_t {{NATIVE_NAME}}::SerializedSizeBound() const {";
+      code_ +=
+          "  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound("
+          "{{NUM_FIELDS}}, {{INLINE_SIZE}});";
+      for (auto it = struct_def.fields.vec.begin();
+           it != struct_def.fields.vec.end(); ++it) {
+        const auto &field = **it;
+        if (field.deprecated) { continue; }
+        GenSizeBoundStatement(field);
+      }
+      code_ += "  return _size;";
+      code_ += "}";
+      code_ += "";
+    }
+  }
+
+  // Generate the code adding the out-of-line data of a field to the size
+  // bound computed by SerializedSizeBound().
+  void GenSizeBoundStatement(const FieldDef &field) {
+    const auto &type = field.value.type;
+    code_.SetValue("FIELD_NAME", Name(field));
+    code_.SetValue("PTR_GET", GenPtrGet(field));
+    switch (type.base_type) {
+      case BASE_TYPE_STRING: {
+        code_ +=
+            "  _size += flatbuffers::FlatBufferBuilder::StringSizeBound("
+            "{{FIELD_NAME}}.length());";
+        break;
+      }
+      case BASE_TYPE_VECTOR: {
+        const auto vector_type = type.VectorType();
+        if (vector_type.base_type == BASE_TYPE_UTYPE) {
+          // The types of a vector of unions, stored next to its values.
+          code_.SetValue("FIELD_NAME", StripUnionType(Name(field)));
+        }
+        code_.SetValue("ELEM_SIZE", NumToString(InlineSize(vector_type)));
+        code_.SetValue("ELEM_ALIGN",
+                       NumToString(InlineAlignment(vector_type)));
+        code_ +=
+            "  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound("
+            "{{FIELD_NAME}}.size(), {{ELEM_SIZE}}, {{ELEM_ALIGN}});";
+        std::string elem;
+        if (vector_type.base_type == BASE_TYPE_STRING) {
+          elem =
+              "flatbuffers::FlatBufferBuilder::StringSizeBound("
+              "{{FIELD_NAME}}[_i].length())";
+        } else if (vector_type.base_type == BASE_TYPE_UNION) {
+          elem = "{{FIELD_NAME}}[_i].SerializedSizeBound()";
+        } else if (vector_type.base_type == BASE_TYPE_STRUCT &&
+                   !IsStruct(vector_type)) {
+          elem = "{{FIELD_NAME}}[_i]{{PTR_GET}}->SerializedSizeBound()";
+        }
+        if (!elem.empty()) {
+          code_ += "  for (size_t _i = 0; _i < {{FIELD_NAME}}.size(); _i++) {";
+          code_ += "    _size += " + elem + ";";
+          code_ += "  }";
+        }
+        break;
+      }
+      case BASE_TYPE_UNION: {
+        code_ += "  _size += {{FIELD_NAME}}.SerializedSizeBound();";
+        break;
+      }
+      case BASE_TYPE_STRUCT: {
+        if (IsStruct(type)) break;
+        if (field.native_inline) {
+          code_ += "  _size += {{FIELD_NAME}}.SerializedSizeBound();";
+        } else {
+          code_ +=
+              "  if ({{FIELD_NAME}}) _size += "
+              "{{FIELD_NAME}}{{PTR_GET}}->SerializedSizeBound();";
+        }
+        break;
+      }
+      default: break;
     }
   }
 
@@ -2813,7 +3190,8 @@ class CppGenerator : public BaseGenerator {
         if (IsArray(field.value.type)) {
           const auto &member = Name(field) + "_";
           code_ +=
-              "    std::memset(" + member + ", 0, sizeof(" + member + "));";
+              "    std::memset(static_cast<void *>(" + member + "), 0, sizeof(" +
+              member + "));";
         }
         if (field.padding) {
           std::string padding;
@@ -51,30 +51,35 @@ bool Print(T val, Type type, int /*indent*/, Type * /*union_type*/,
            const IDLOptions &opts, std::string *_text) {
   std::string &text = *_text;
   if (type.enum_def && opts.output_enum_identifiers) {
-    std::vector<EnumVal const *> enum_values;
     if (auto ev = type.enum_def->ReverseLookup(static_cast<int64_t>(val))) {
-      enum_values.push_back(ev);
+      text += '\"';
+      text += ev->name;
+      text += '\"';
+      return true;
     } else if (val && type.enum_def->attributes.Lookup("bit_flags")) {
+      // Space separated names of the flags set, if any.
+      auto start = text.length();
+      text += '\"';
       for (auto it = type.enum_def->Vals().begin(),
                 e = type.enum_def->Vals().end();
            it != e; ++it) {
-        if ((*it)->GetAsUInt64() & static_cast<uint64_t>(val))
-          enum_values.push_back(*it);
+        if ((*it)->GetAsUInt64() & static_cast<uint64_t>(val)) {
+          text += (*it)->name;
+          text += ' ';
+        }
       }
-    }
-    if (!enum_values.empty()) {
-      text += '\"';
-      for (auto it = enum_values.begin(), e = enum_values.end(); it != e; ++it)
-        text += (*it)->name + ' ';
-      text[text.length() - 1] = '\"';
-      return true;
+      if (text.length() > start + 1) {
+        text[text.length() - 1] = '\"';
+        return true;
+      }
+      text.resize(start);
     }
   }
 
   if (type.base_type == BASE_TYPE_BOOL) {
     text += val != 0 ? "true" : "false";
   } else {
-    text += NumToString(val);
+    AppendNumToString(val, _text);
   }
 
   return true;
@@ -211,11 +216,15 @@ template<typename T> static T GetFieldDefault(const FieldDef &fd) {
 template<typename T>
 static bool GenField(const FieldDef &fd, const Table *table, bool fixed,
                      const IDLOptions &opts, int indent, std::string *_text) {
-  return Print(
-      fixed ? reinterpret_cast<const Struct *>(table)->GetField<T>(
-                  fd.value.offset)
-            : table->GetField<T>(fd.value.offset, GetFieldDefault<T>(fd)),
-      fd.value.type, indent, nullptr, opts, _text);
+  T val;
+  if (fixed) {
+    val = reinterpret_cast<const Struct *>(table)->GetField<T>(fd.value.offset);
+  } else {
+    // Only convert the default if the field isn't present.
+    auto p = table->GetAddressOf(fd.value.offset);
+    val = p ? ReadScalar<T>(p) : GetFieldDefault<T>(fd);
+  }
+  return Print(val, fd.value.type, indent, nullptr, opts, _text);
 }
 
 static bool GenStruct(const StructDef &struct_def, const Table *table,
@@ -172,6 +172,53 @@ inline CheckedError atot<Offset<void>>(const char *s, Parser &parser,
   return NoError();
 }
 
+// Typed access to Value::scalar, with T the C++ type of the value's type.
+template<typename T> inline void SetScalar(Value &e, T val) {
+  if (flatbuffers::is_floating_point<T>::value) {
+    if (sizeof(T) == sizeof(float)) {
+      e.scalar.f = static_cast<float>(val);
+    } else {
+      e.scalar.d = static_cast<double>(val);
+    }
+  } else if (flatbuffers::is_unsigned<T>::value) {
+    e.scalar.u = static_cast<uint64_t>(val);
+  } else {
+    e.scalar.i = static_cast<int64_t>(val);
+  }
+}
+
+template<typename T> inline T GetScalar(const Value &e) {
+  FLATBUFFERS_ASSERT(e.has_scalar);
+  if (flatbuffers::is_floating_point<T>::value) {
+    return sizeof(T) == sizeof(float) ? static_cast<T>(e.scalar.f)
+                                      : static_cast<T>(e.scalar.d);
+  }
+  return flatbuffers::is_unsigned<T>::value ? static_cast<T>(e.scalar.u)
+                                            : static_cast<T>(e.scalar.i);
+}
+
+// Convert the constant of a scalar value to its type, the one time it is
+// needed as a number.
+static CheckedError ConvertScalar(Value &e, Parser &parser) {
+  switch (e.type.base_type) {
+    // clang-format off
+    #define FLATBUFFERS_TD(ENUM, IDLTYPE, \
+      CTYPE, JTYPE, GTYPE, NTYPE, PTYPE, RTYPE, KTYPE) \
+      case BASE_TYPE_ ## ENUM: { \
+        CTYPE val; \
+        ECHECK(atot(e.constant.c_str(), parser, &val)); \
+        SetScalar(e, val); \
+        break; \
+      }
+      FLATBUFFERS_GEN_TYPES_SCALAR(FLATBUFFERS_TD)
+    #undef FLATBUFFERS_TD
+    // clang-format on
+    default: FLATBUFFERS_ASSERT(false);
+  }
+  e.has_scalar = true;
+  return NoError();
+}
+
 std::string Namespace::GetFullyQualifiedName(const std::string &name,
                                              size_t max_components) const {
   // Early exit if we don't have a defined namespace.
@@ -1012,6 +1059,7 @@ CheckedError Parser::ParseAnyValue(Value &val, FieldDef *field,
       ECHECK(ParseSingleValue(field ? &field->name : nullptr, val, false));
       break;
   }
+  if (IsScalar(val.type.base_type)) ECHECK(ConvertScalar(val, *this));
   return NoError();
 }
 
@@ -1173,14 +1221,14 @@ CheckedError Parser::ParseTable(const StructDef &struct_def, std::string *value,
             case BASE_TYPE_ ## ENUM: \
               builder_.Pad(field->padding); \
               if (struct_def.fixed) { \
-                CTYPE val; \
-                ECHECK(atot(field_value.constant.c_str(), *this, &val)); \
-                builder_.PushElement(val); \
+                builder_.PushElement(GetScalar<CTYPE>(field_value)); \
               } else { \
-                CTYPE val, valdef; \
-                ECHECK(atot(field_value.constant.c_str(), *this, &val)); \
-                ECHECK(atot(field->value.constant.c_str(), *this, &valdef)); \
-                builder_.AddElement(field_value.offset, val, valdef); \
+                /* Defaults are converted on first use only. */ \
+                if (!field->value.has_scalar) \
+                  ECHECK(ConvertScalar(field->value, *this)); \
+                builder_.AddElement(field_value.offset, \
+                                    GetScalar<CTYPE>(field_value), \
+                                    GetScalar<CTYPE>(field->value)); \
               } \
               break;
             FLATBUFFERS_GEN_TYPES_SCALAR(FLATBUFFERS_TD);
@@ -1266,6 +1314,13 @@ CheckedError Parser::ParseVector(const Type &type, uoffset_t *ovalue,
     auto &val = field_stack_.back().first;
     switch (val.type.base_type) {
       // clang-format off
+      #define FLATBUFFERS_TD(ENUM, IDLTYPE, \
+        CTYPE, JTYPE, GTYPE, NTYPE, PTYPE, RTYPE, KTYPE) \
+        case BASE_TYPE_ ## ENUM: \
+          builder_.PushElement(GetScalar<CTYPE>(val)); \
+          break;
+        FLATBUFFERS_GEN_TYPES_SCALAR(FLATBUFFERS_TD)
+      #undef FLATBUFFERS_TD
       #define FLATBUFFERS_TD(ENUM, IDLTYPE, \
         CTYPE, JTYPE, GTYPE, NTYPE, PTYPE, RTYPE, KTYPE) \
         case BASE_TYPE_ ## ENUM: \
@@ -1276,7 +1331,8 @@ CheckedError Parser::ParseVector(const Type &type, uoffset_t *ovalue,
              builder_.PushElement(elem); \
           } \
           break;
-        FLATBUFFERS_GEN_TYPES(FLATBUFFERS_TD)
+        FLATBUFFERS_GEN_TYPES_POINTER(FLATBUFFERS_TD)
+        FLATBUFFERS_GEN_TYPE_ARRAY(FLATBUFFERS_TD)
       #undef FLATBUFFERS_TD
       // clang-format on
     }
@@ -1360,6 +1416,7 @@ CheckedError Parser::ParseNestedFlatbuffer(Value &val, FieldDef *field,
     // Clean nested_parser to avoid deleting the elements in
     // the SymbolTables on destruction
     nested_parser.enums_.dict.clear();
+    nested_parser.enums_.ClearIndex();
     nested_parser.enums_.vec.clear();
 
     if (!ok) {
@@ -1452,12 +1509,17 @@ CheckedError Parser::ParseEnumFromString(const Type &type,
   for (size_t pos = 0; pos != std::string::npos;) {
     const auto delim = attribute_.find_first_of(' ', pos);
     const auto last = (std::string::npos == delim);
-    auto word = attribute_.substr(pos, !last ? delim - pos : std::string::npos);
+    const auto word_start = pos;
+    const auto len = (!last ? delim : attribute_.length()) - word_start;
     pos = !last ? delim + 1 : std::string::npos;
     const EnumVal *ev = nullptr;
     if (type.enum_def) {
-      ev = type.enum_def->Lookup(word);
+      ev = type.enum_def->Lookup(attribute_.c_str() + word_start, len);
+      if (!ev)
+        return Error("unknown enum value: " +
+                     attribute_.substr(word_start, len));
     } else {
+      auto word = attribute_.substr(word_start, len);
       auto dot = word.find_first_of('.');
       if (std::string::npos == dot)
         return Error("enum values need to be qualified by an enum type");
@@ -1466,8 +1528,8 @@ CheckedError Parser::ParseEnumFromString(const Type &type,
       if (!enum_def) return Error("unknown enum: " + enum_def_str);
       auto enum_val_str = word.substr(dot + 1);
       ev = enum_def->Lookup(enum_val_str);
+      if (!ev) return Error("unknown enum value: " + word);
     }
-    if (!ev) return Error("unknown enum value: " + word);
     u64 |= ev->GetAsUInt64();
   }
   *result = IsUnsigned(base_type) ? NumToString(u64)
@@ -2703,6 +2765,71 @@ bool Parser::Parse(const char *source, const char **include_paths,
   return r;
 }
 
+#ifndef FLATBUFFERS_CPP98_STL
+bool Parser::ParseJsonStream(const JsonStreamReader &reader,
+                             const JsonStreamSink &sink,
+                             const char *source_filename) {
+  FLATBUFFERS_ASSERT(0 == recurse_protection_counter);
+  file_being_parsed_ = source_filename ? source_filename : "";
+  error_.clear();
+  if (!root_struct_def_) {
+    ResetState("");
+    return !Error("no root type set to parse json with").Check();
+  }
+  BuildLookupIndices();
+  // Holds the lines not parsed yet, the last of which may be incomplete.
+  std::string pending;
+  size_t start = 0;
+  int line_number = 0;
+  for (bool eof = false; !eof;) {
+    pending.erase(0, start);
+    start = 0;
+    static const size_t kChunkSize = 64 * 1024;
+    auto old_size = pending.size();
+    pending.resize(old_size + kChunkSize);
+    auto read = reader(&pending[old_size], kChunkSize);
+    pending.resize(old_size + read);
+    eof = !read;
+    if (eof && !pending.empty()) pending += '\n';
+    // What was read before has no newlines left, so only search what's new.
+    for (auto end = pending.find('\n', old_size); end != std::string::npos;
+         end = pending.find('\n', start)) {
+      line_number++;
+      pending[end] = '\0';
+      auto line = pending.c_str() + start;
+      start = end + 1;
+      if (line_number == 1) {
+        ResetState(line);
+        if (SkipByteOrderMark().Check()) return false;
+        line = cursor_;
+      }
+      while (*line == ' ' || *line == '\t' || *line == '\r') line++;
+      if (!*line) continue;
+      if (ParseJsonStreamLine(line, line_number).Check()) return false;
+      if (!sink(builder_.GetBufferPointer(), builder_.GetSize())) {
+        return !Error("json stream stopped by its sink").Check();
+      }
+    }
+  }
+  return true;
+}
+#endif  // !FLATBUFFERS_CPP98_STL
+
+CheckedError Parser::ParseJsonStreamLine(const char *line, int line_number) {
+  builder_.Clear();
+  source_ = line;
+  ResetState(source_);
+  line_ = line_number;
+  NEXT();
+  uoffset_t toff;
+  ECHECK(ParseTable(*root_struct_def_, nullptr, &toff));
+  builder_.FinishSizePrefixed(
+      Offset<Table>(toff),
+      file_identifier_.length() ? file_identifier_.c_str() : nullptr);
+  EXPECT(kTokenEof);
+  return NoError();
+}
+
 CheckedError Parser::StartParseFile(const char *source,
                                     const char *source_filename) {
   file_being_parsed_ = source_filename ? source_filename : "";
@@ -2763,6 +2890,7 @@ CheckedError Parser::ParseRoot(const char *source, const char **include_paths,
                          " use(s) of pre-declaration enum not accounted for: " +
                          enum_def->name);
           structs_.dict.erase(structs_.dict.find(struct_def.name));
+          structs_.ClearIndex();
           it = structs_.vec.erase(it);
           delete &struct_def;
           continue;  // Skip error.
@@ -2793,9 +2921,20 @@ CheckedError Parser::ParseRoot(const char *source, const char **include_paths,
       }
     }
   }
+  BuildLookupIndices();
   return NoError();
 }
 
+// Called once the schema is complete, to speed up JSON parsing.
+void Parser::BuildLookupIndices() {
+  for (auto it = structs_.vec.begin(); it != structs_.vec.end(); ++it) {
+    (*it)->fields.BuildIndex();
+  }
+  for (auto it = enums_.vec.begin(); it != enums_.vec.end(); ++it) {
+    (*it)->BuildIndex();
+  }
+}
+
 CheckedError Parser::DoParse(const char *source, const char **include_paths,
                              const char *source_filename,
                              const char *include_filename) {
@@ -2890,6 +3029,7 @@ CheckedError Parser::DoParse(const char *source, const char **include_paths,
       if (builder_.GetSize()) {
         return Error("cannot have more than one json object in a file");
       }
+      BuildLookupIndices();
       uoffset_t toff;
       ECHECK(ParseTable(*root_struct_def_, nullptr, &toff));
       if (opts.size_prefixed) {
@@ -3126,8 +3266,12 @@ Offset<reflection::Field> FieldDef::Serialize(FlatBufferBuilder *builder,
                 ? builder->CreateVectorOfStrings(doc_comment)
                 : 0;
   return reflection::CreateField(*builder, name__, type__, id, value.offset,
-      // Is uint64>max(int64) tested?
-      IsInteger(value.type.base_type) ? StringToInt(value.constant.c_str()) : 0,
+      // uint64 defaults above max(int64) are stored as their two's complement.
+      value.type.base_type == BASE_TYPE_ULONG
+          ? static_cast<int64_t>(StringToUInt(value.constant.c_str()))
+          : IsInteger(value.type.base_type)
+                ? StringToInt(value.constant.c_str())
+                : 0,
       // result may be platform-dependent if underlying is float (not double)
       IsFloat(value.type.base_type) ? strtod(value.constant.c_str(), nullptr)
                                     : 0.0,
@@ -3142,13 +3286,16 @@ bool FieldDef::Deserialize(Parser &parser, const reflection::Field *field) {
   if (!value.type.Deserialize(parser, field->type()))
     return false;
   value.offset = field->offset();
-  if (IsInteger(value.type.base_type)) {
+  if (value.type.base_type == BASE_TYPE_ULONG) {
+    value.constant =
+        NumToString(static_cast<uint64_t>(field->default_integer()));
+  } else if (IsInteger(value.type.base_type)) {
     value.constant = NumToString(field->default_integer());
   } else if (IsFloat(value.type.base_type)) {
     value.constant = FloatToString(field->default_real(), 16);
     size_t last_zero = value.constant.find_last_not_of('0');
     if (last_zero != std::string::npos && last_zero != 0) {
-      value.constant.erase(last_zero, std::string::npos);
+      value.constant.erase(last_zero + 1, std::string::npos);
     }
   }
   deprecated = field->deprecated();
@@ -3458,7 +3605,7 @@ bool Parser::Deserialize(const reflection::Schema *schema) {
       }
     }
   }
-
+  BuildLookupIndices();
   return true;
 }
 
@@ -170,35 +170,103 @@ class ResizeContext {
                 std::vector<uint8_t> *flatbuf,
                 const reflection::Object *root_table = nullptr)
       : schema_(schema),
-        startptr_(vector_data(*flatbuf) + start),
-        delta_(delta),
         buf_(*flatbuf),
         dag_check_(flatbuf->size() / sizeof(uoffset_t), false) {
     auto mask = static_cast<int>(sizeof(largest_scalar_t) - 1);
-    delta_ = (delta_ + mask) & ~mask;
-    if (!delta_) return;  // We can't shrink by less than largest_scalar_t.
-    // Now change all the offsets by delta_.
-    auto root = GetAnyRoot(vector_data(buf_));
-    Straddle<uoffset_t, 1>(vector_data(buf_), root, vector_data(buf_));
-    ResizeTable(root_table ? *root_table : *schema.root_table(), root);
+    delta = (delta + mask) & ~mask;
+    if (!delta) return;  // We can't shrink by less than largest_scalar_t.
+    starts_.push_back(start);
+    shifts_.push_back(0);
+    shifts_.push_back(delta);
+    // Now change all the offsets by delta.
+    ResizeRoot(root_table);
     // We can now add or remove bytes at start.
-    if (delta_ > 0)
-      buf_.insert(buf_.begin() + start, delta_, 0);
+    if (delta > 0)
+      buf_.insert(buf_.begin() + start, delta, 0);
     else
-      buf_.erase(buf_.begin() + start, buf_.begin() + start - delta_);
+      buf_.erase(buf_.begin() + start, buf_.begin() + start - delta);
+  }
+
+  // As above, but for any number of insertion points at once, which must be
+  // sorted and distinct. Each of "deltas" must already be a multiple of
+  // sizeof(largest_scalar_t). All offsets are adjusted in a single walk over
+  // the buffer, and all bytes are moved in a single pass afterwards.
+  ResizeContext(const reflection::Schema &schema,
+                const std::vector<uoffset_t> &starts,
+                const std::vector<int> &deltas, std::vector<uint8_t> *flatbuf,
+                const reflection::Object *root_table = nullptr)
+      : schema_(schema),
+        starts_(starts),
+        buf_(*flatbuf),
+        dag_check_(flatbuf->size() / sizeof(uoffset_t), false) {
+    if (starts_.empty()) return;
+    shifts_.push_back(0);
+    for (size_t i = 0; i < deltas.size(); i++) {
+      FLATBUFFERS_ASSERT(!i || starts_[i - 1] < starts_[i]);
+      shifts_.push_back(shifts_.back() + deltas[i]);
+    }
+    ResizeRoot(root_table);
+    MoveSegments();
+  }
+
+  void ResizeRoot(const reflection::Object *root_table) {
+    auto root = GetAnyRoot(vector_data(buf_));
+    Straddle<uoffset_t, 1>(vector_data(buf_), root, vector_data(buf_));
+    ResizeTable(root_table ? *root_table : *schema_.root_table(), root);
+  }
+
+  // How far the byte at "p" moves: the sum of all deltas at or before it.
+  int Shift(const void *p) const {
+    auto off = static_cast<uoffset_t>(reinterpret_cast<const uint8_t *>(p) -
+                                      vector_data(buf_));
+    return shifts_[std::upper_bound(starts_.begin(), starts_.end(), off) -
+                   starts_.begin()];
   }
 
   // Check if the range between first (lower address) and second straddles
-  // the insertion point. If it does, change the offset at offsetloc (of
+  // any insertion points. If it does, change the offset at offsetloc (of
   // type T, with direction D).
   template<typename T, int D>
   void Straddle(const void *first, const void *second, void *offsetloc) {
-    if (first <= startptr_ && second >= startptr_) {
-      WriteScalar<T>(offsetloc, ReadScalar<T>(offsetloc) + delta_ * D);
+    auto delta = Shift(second) - Shift(first);
+    if (delta) {
+      WriteScalar<T>(offsetloc, ReadScalar<T>(offsetloc) + delta * D);
       DagCheck(offsetloc) = true;
     }
   }
 
+  // Moves the bytes between insertion points to their new locations, and
+  // zeroes the inserted space. Segments moving down are moved front to back
+  // and those moving up back to front: neither can then overwrite a segment
+  // that hasn't been moved yet.
+  void MoveSegments() {
+    auto old_size = buf_.size();
+    auto new_size = old_size + shifts_.back();
+    if (new_size > old_size) buf_.resize(new_size, 0);
+    auto buf = vector_data(buf_);
+    auto nsegs = starts_.size() + 1;
+    for (size_t i = 1; i < nsegs; i++) {
+      if (shifts_[i] < 0) MoveSegment(buf, i, old_size);
+    }
+    for (size_t i = nsegs - 1; i > 0; i--) {
+      if (shifts_[i] > 0) MoveSegment(buf, i, old_size);
+    }
+    for (size_t i = 0; i < starts_.size(); i++) {
+      auto delta = shifts_[i + 1] - shifts_[i];
+      if (delta > 0) memset(buf + starts_[i] + shifts_[i], 0, delta);
+    }
+    if (new_size < old_size) buf_.resize(new_size);
+  }
+
+  // Segment i runs from insertion point i - 1 to insertion point i.
+  void MoveSegment(uint8_t *buf, size_t i, size_t old_size) {
+    auto delta = shifts_[i] - shifts_[i - 1];
+    // The bytes removed at a negative delta are not part of any segment.
+    auto begin = starts_[i - 1] + (delta < 0 ? -delta : 0);
+    auto end = i < starts_.size() ? starts_[i] : old_size;
+    memmove(buf + begin + shifts_[i], buf + begin, end - begin);
+  }
+
   // This returns a boolean that records if the corresponding offset location
   // has been modified already. If so, we can't even read the corresponding
   // offset, since it is pointing to a location that is illegal until the
@@ -217,11 +285,11 @@ class ResizeContext {
     // Early out: since all fields inside the table must point forwards in
     // memory, if the insertion point is before the table we can stop here.
     auto tableloc = reinterpret_cast<uint8_t *>(table);
-    if (startptr_ <= tableloc) {
+    if (vector_data(buf_) + starts_.back() <= tableloc) {
       // Check if insertion point is between the table and a vtable that
       // precedes it. This can't happen in current construction code, but check
       // just in case we ever change the way flatbuffers are built.
-      Straddle<soffset_t, -1>(vtable, table, table);
+      Straddle<soffset_t, 1>(vtable, table, table);
     } else {
       // Check each field.
       auto fielddefs = objectdef.fields();
@@ -290,8 +358,9 @@ class ResizeContext {
 
  private:
   const reflection::Schema &schema_;
-  uint8_t *startptr_;
-  int delta_;
+  // Insertion points, and the running sum of the deltas up to each.
+  std::vector<uoffset_t> starts_;
+  std::vector<int> shifts_;
   std::vector<uint8_t> &buf_;
   std::vector<uint8_t> dag_check_;
 };
@@ -343,6 +412,125 @@ uint8_t *ResizeAnyVector(const reflection::Schema &schema, uoffset_t newsize,
   return vector_data(*flatbuf) + start;
 }
 
+void ResizeBatch::SetString(const String *str, const std::string &val) {
+  auto str_start = static_cast<uoffset_t>(
+      reinterpret_cast<const uint8_t *>(str) - vector_data(*flatbuf_));
+  Edit edit;
+  edit.object = str_start;
+  edit.start = str_start + static_cast<uoffset_t>(sizeof(uoffset_t));
+  edit.delta = static_cast<int>(val.size()) - static_cast<int>(str->size());
+  edit.length = static_cast<uoffset_t>(val.size());
+  // Clear the old string, since we don't want parts of it remaining.
+  edit.clear_start = edit.start;
+  edit.clear_size = str->size();
+  edit.data.assign(val.c_str(), val.c_str() + val.size() + 1);
+  Add(edit);
+}
+
+void ResizeBatch::ResizeAnyVector(const VectorOfAny *vec, uoffset_t num_elems,
+                                  uoffset_t newsize, uoffset_t elem_size,
+                                  const uint8_t *val) {
+  auto delta_elem = static_cast<int>(newsize) - static_cast<int>(num_elems);
+  if (!delta_elem) return;
+  auto vec_start = static_cast<uoffset_t>(
+      reinterpret_cast<const uint8_t *>(vec) - vector_data(*flatbuf_));
+  auto end = vec_start + static_cast<uoffset_t>(sizeof(uoffset_t)) +
+             elem_size * num_elems;
+  Edit edit;
+  edit.object = vec_start;
+  edit.start = end;
+  edit.delta = delta_elem * static_cast<int>(elem_size);
+  edit.length = newsize;
+  edit.clear_start = end;
+  edit.clear_size = 0;
+  if (delta_elem < 0) {
+    // Clear elements we're throwing away, since some might remain in the
+    // buffer, and remove space from their end.
+    edit.clear_size = -delta_elem * elem_size;
+    edit.clear_start = end - edit.clear_size;
+    edit.start = end - static_cast<uoffset_t>(-RoundDelta(edit.delta));
+  } else if (val) {
+    // New elements start out as 0 unless a value was given.
+    for (int i = 0; i < delta_elem; i++)
+      edit.data.insert(edit.data.end(), val, val + elem_size);
+  }
+  Add(edit);
+}
+
+bool ResizeBatch::AddFlatBuffer(const Table *table,
+                                const reflection::Field &field,
+                                const uint8_t *newbuf, size_t newlen) {
+  FLATBUFFERS_ASSERT(sizeof(uoffset_t) ==
+                     GetTypeSize(field.type()->base_type()));
+  // Vtables aren't changed by Apply(), so whether the field is stored is
+  // known now.
+  if (!table->GetOptionalFieldOffset(field.offset())) return false;
+  Insertion insertion;
+  insertion.table = static_cast<uoffset_t>(
+      reinterpret_cast<const uint8_t *>(table) - vector_data(*flatbuf_));
+  insertion.field = &field;
+  insertion.data.assign(newbuf, newbuf + newlen);
+  insertions_.push_back(insertion);
+  return true;
+}
+
+void ResizeBatch::Add(Edit &edit) {
+  edit.delta = RoundDelta(edit.delta);
+  edits_.push_back(edit);
+}
+
+int ResizeBatch::RoundDelta(int delta) {
+  // Deltas must keep everything after them aligned, we can't shrink by less
+  // than largest_scalar_t.
+  auto mask = static_cast<int>(sizeof(largest_scalar_t) - 1);
+  return (delta + mask) & ~mask;
+}
+
+void ResizeBatch::Apply() {
+  std::sort(edits_.begin(), edits_.end(),
+            [](const Edit &a, const Edit &b) { return a.start < b.start; });
+  auto buf = vector_data(*flatbuf_);
+  std::vector<uoffset_t> starts;
+  std::vector<int> deltas;
+  for (auto it = edits_.begin(); it != edits_.end(); ++it) {
+    // Each string or vector can only be changed once per batch.
+    FLATBUFFERS_ASSERT(it == edits_.begin() || (it - 1)->start < it->start);
+    memset(buf + it->clear_start, 0, it->clear_size);
+    // Length fields are never moved by their own edit, and no other edit can
+    // lie between them and their start, so set them before resizing.
+    WriteScalar(buf + it->object, it->length);
+    if (it->delta) {
+      starts.push_back(it->start);
+      deltas.push_back(it->delta);
+    }
+  }
+  ResizeContext(schema_, starts, deltas, flatbuf_, root_table_);
+  // Copy new data into the space created for it, which has moved along with
+  // all edits before it.
+  buf = vector_data(*flatbuf_);
+  int shift = 0;
+  for (auto it = edits_.begin(); it != edits_.end(); ++it) {
+    if (!it->data.empty())
+      memcpy(buf + it->start + shift, vector_data(it->data), it->data.size());
+    shift += it->delta;
+  }
+  // New data goes at the end, where it doesn't move anything, after the
+  // tables referring to it have been moved by all edits before them.
+  for (auto it = insertions_.begin(); it != insertions_.end(); ++it) {
+    auto table = it->table;
+    for (auto edit = edits_.begin();
+         edit != edits_.end() && edit->start <= it->table; ++edit) {
+      table += edit->delta;
+    }
+    auto root = flatbuffers::AddFlatBuffer(*flatbuf_, vector_data(it->data),
+                                           it->data.size());
+    SetFieldT(reinterpret_cast<Table *>(vector_data(*flatbuf_) + table),
+              *it->field, root);
+  }
+  edits_.clear();
+  insertions_.clear();
+}
+
 const uint8_t *AddFlatBuffer(std::vector<uint8_t> &flatbuf,
                              const uint8_t *newbuf, size_t newlen) {
   // Align to sizeof(uoffset_t) past sizeof(largest_scalar_t) since we're
@@ -388,16 +576,17 @@ Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
       case reflection::Obj: {
         auto &subobjectdef = *schema.objects()->Get(fielddef.type()->index());
         if (!subobjectdef.is_struct()) {
-          offset =
-              CopyTable(fbb, schema, subobjectdef, *GetFieldT(table, fielddef))
-                  .o;
+          offset = CopyTable(fbb, schema, subobjectdef,
+                             *GetFieldT(table, fielddef), use_string_pooling)
+                       .o;
         }
         break;
       }
       case reflection::Union: {
         auto &subobjectdef = GetUnionType(schema, objectdef, fielddef, table);
-        offset =
-            CopyTable(fbb, schema, subobjectdef, *GetFieldT(table, fielddef)).o;
+        offset = CopyTable(fbb, schema, subobjectdef,
+                           *GetFieldT(table, fielddef), use_string_pooling)
+                     .o;
         break;
       }
       case reflection::Vector: {
@@ -424,8 +613,8 @@ Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
             if (!elemobjectdef->is_struct()) {
               std::vector<Offset<const Table *>> elements(vec->size());
               for (uoffset_t i = 0; i < vec->size(); i++) {
-                elements[i] =
-                    CopyTable(fbb, schema, *elemobjectdef, *vec->Get(i));
+                elements[i] = CopyTable(fbb, schema, *elemobjectdef,
+                                        *vec->Get(i), use_string_pooling);
               }
               offset = fbb.CreateVector(elements).o;
               break;
@@ -488,6 +677,209 @@ Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
   }
 }
 
+TableCopier::ObjectPlan &TableCopier::Plan(int object) {
+  auto &plan = plans_[static_cast<size_t>(object)];
+  if (plan.built) return plan;
+  plan.built = true;
+  auto &objectdef = *schema_.objects()->Get(static_cast<uoffset_t>(object));
+  auto fielddefs = objectdef.fields();
+  plan.fields.reserve(fielddefs->size());
+  // Same field order as CopyTable, so both produce the same buffer.
+  for (auto it = fielddefs->begin(); it != fielddefs->end(); ++it) {
+    auto &fielddef = **it;
+    auto type = fielddef.type();
+    FieldPlan field;
+    field.offset = fielddef.offset();
+    field.size = 0;
+    field.align = 0;
+    field.object = type->index();
+    field.type_offset = 0;
+    field.union_enum = nullptr;
+    auto subobjectdef =
+        type->index() >= 0 &&
+                (type->base_type() == reflection::Obj ||
+                 type->element() == reflection::Obj)
+            ? schema_.objects()->Get(static_cast<uoffset_t>(type->index()))
+            : nullptr;
+    switch (type->base_type()) {
+      case reflection::String: field.kind = FieldPlan::kString; break;
+      case reflection::Obj: {
+        if (subobjectdef->is_struct()) {
+          field.kind = FieldPlan::kInline;
+          field.size = subobjectdef->bytesize();
+          field.align = static_cast<size_t>(subobjectdef->minalign());
+        } else {
+          field.kind = FieldPlan::kTable;
+        }
+        break;
+      }
+      case reflection::Union: {
+        field.kind = FieldPlan::kUnion;
+        field.union_enum = schema_.enums()->Get(type->index());
+        auto type_field = fielddefs->LookupByKey(
+            (fielddef.name()->str() + UnionTypeFieldSuffix()).c_str());
+        FLATBUFFERS_ASSERT(type_field);
+        field.type_offset = type_field->offset();
+        break;
+      }
+      case reflection::Vector: {
+        switch (type->element()) {
+          case reflection::String: {
+            field.kind = FieldPlan::kVectorOfStrings;
+            break;
+          }
+          case reflection::Obj: {
+            if (!subobjectdef->is_struct()) {
+              field.kind = FieldPlan::kVectorOfTables;
+              break;
+            }
+            field.kind = FieldPlan::kVectorOfInline;
+            field.size = subobjectdef->bytesize();
+            // Align to the struct size like CreateVectorOfStructs does, unless
+            // that isn't a power of 2.
+            field.align = field.size & (field.size - 1)
+                              ? static_cast<size_t>(subobjectdef->minalign())
+                              : field.size;
+            break;
+          }
+          default: {  // Scalars.
+            field.kind = FieldPlan::kVectorOfInline;
+            field.size = GetTypeSize(type->element());
+            field.align = field.size;
+            break;
+          }
+        }
+        break;
+      }
+      default: {  // Scalars.
+        field.kind = FieldPlan::kInline;
+        field.size = GetTypeSize(type->base_type());
+        field.align = field.size;
+        break;
+      }
+    }
+    plan.fields.push_back(field);
+  }
+  return plan;
+}
+
+int TableCopier::UnionObject(FieldPlan &field, uint8_t type) {
+  if (static_cast<size_t>(type) >= field.union_objects.size())
+    field.union_objects.resize(static_cast<size_t>(type) + 1, -1);
+  auto &object = field.union_objects[type];
+  if (object < 0) {
+    auto enumval = field.union_enum->values()->LookupByKey(type);
+    FLATBUFFERS_ASSERT(enumval && enumval->object());
+    auto objects = schema_.objects();
+    for (uoffset_t i = 0; i < objects->size(); i++) {
+      if (objects->Get(i) == enumval->object()) object = static_cast<int>(i);
+    }
+  }
+  return object;
+}
+
+uoffset_t TableCopier::CopyString(FlatBufferBuilder &fbb, const String *str) {
+  return use_string_pooling_ ? fbb.CreateSharedString(str).o
+                             : fbb.CreateString(str).o;
+}
+
+Offset<const Table *> TableCopier::CopyTable(
+    FlatBufferBuilder &fbb, const reflection::Object &objectdef,
+    const Table &table) {
+  FLATBUFFERS_ASSERT(!objectdef.is_struct());
+  auto objects = schema_.objects();
+  for (uoffset_t i = 0; i < objects->size(); i++) {
+    if (objects->Get(i) == &objectdef)
+      return Copy(fbb, Plan(static_cast<int>(i)), table);
+  }
+  FLATBUFFERS_ASSERT(false);  // objectdef must be part of the schema.
+  return 0;
+}
+
+uoffset_t TableCopier::Copy(FlatBufferBuilder &fbb, ObjectPlan &plan,
+                            const Table &table) {
+  // Before we can construct the table, we have to first generate any
+  // subobjects, and collect their offsets on top of those of our parents.
+  auto base = scratch_.size();
+  for (auto it = plan.fields.begin(); it != plan.fields.end(); ++it) {
+    auto &field = *it;
+    if (field.kind == FieldPlan::kInline) continue;
+    auto ref = table.GetPointer<const uint8_t *>(field.offset);
+    if (!ref) continue;
+    uoffset_t offset = 0;
+    switch (field.kind) {
+      case FieldPlan::kString: {
+        offset = CopyString(fbb, reinterpret_cast<const String *>(ref));
+        break;
+      }
+      case FieldPlan::kTable: {
+        offset = Copy(fbb, Plan(field.object),
+                      *reinterpret_cast<const Table *>(ref));
+        break;
+      }
+      case FieldPlan::kUnion: {
+        auto type = table.GetField<uint8_t>(field.type_offset, 0);
+        offset = Copy(fbb, Plan(UnionObject(field, type)),
+                      *reinterpret_cast<const Table *>(ref));
+        break;
+      }
+      case FieldPlan::kVectorOfInline: {
+        auto vec = reinterpret_cast<const Vector<uint8_t> *>(ref);
+        auto bytes = vec->size() * field.size;
+        // Struct sizes need not be a power of 2, so align by hand.
+        fbb.ForceVectorAlignment(vec->size(), field.size, field.align);
+        fbb.StartVector(bytes, sizeof(uint8_t));
+        fbb.PushBytes(vec->Data(), bytes);
+        offset = fbb.EndVector(vec->size());
+        break;
+      }
+      case FieldPlan::kVectorOfStrings: {
+        auto vec = reinterpret_cast<const Vector<Offset<String>> *>(ref);
+        auto start = scratch_.size();
+        for (auto s = vec->begin(); s != vec->end(); ++s) {
+          scratch_.push_back(CopyString(fbb, *s));
+        }
+        offset = fbb.CreateVector(vector_data(scratch_) + start, vec->size()).o;
+        scratch_.resize(start);
+        break;
+      }
+      case FieldPlan::kVectorOfTables: {
+        auto vec = reinterpret_cast<const Vector<Offset<Table>> *>(ref);
+        auto &elemplan = Plan(field.object);
+        auto start = scratch_.size();
+        for (auto t = vec->begin(); t != vec->end(); ++t) {
+          // Pushed after the call, which may grow scratch_ itself.
+          auto elem = Copy(fbb, elemplan, **t);
+          scratch_.push_back(elem);
+        }
+        offset = fbb.CreateVector(vector_data(scratch_) + start, vec->size()).o;
+        scratch_.resize(start);
+        break;
+      }
+      case FieldPlan::kInline: break;
+    }
+    scratch_.push_back(offset);
+  }
+  // Now we can build the actual table from either offsets or scalar data.
+  auto start = fbb.StartTable();
+  auto offset_idx = base;
+  for (auto it = plan.fields.begin(); it != plan.fields.end(); ++it) {
+    auto &field = *it;
+    if (field.kind == FieldPlan::kInline) {
+      auto data = table.GetAddressOf(field.offset);
+      if (!data) continue;
+      fbb.Align(field.align);
+      fbb.PushBytes(data, field.size);
+      fbb.TrackField(field.offset, fbb.GetSize());
+    } else if (table.GetPointer<const uint8_t *>(field.offset)) {
+      fbb.AddOffset(field.offset, scratch_[offset_idx++]);
+    }
+  }
+  FLATBUFFERS_ASSERT(offset_idx == scratch_.size());
+  scratch_.resize(base);
+  return fbb.EndTable(start);
+}
+
 bool VerifyStruct(flatbuffers::Verifier &v,
                   const flatbuffers::Table &parent_table,
                   voffset_t field_offset, const reflection::Object &obj,
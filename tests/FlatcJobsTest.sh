@@ -0,0 +1,80 @@
+#!/bin/bash
+#
+# Copyright 2020 Google Inc. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Checks that flatc --jobs writes the same files as compiling one file at a
+# time, and stops at the first file with an error.
+# Usage: FlatcJobsTest.sh path/to/flatc
+
+set -e
+
+flatc="$(cd "$(dirname "$1")" && pwd)/$(basename "$1")"
+cd "$(dirname "$0")"
+tmp="$(mktemp -d)"
+trap 'rm -rf "$tmp"' EXIT
+schema="-I include_test monster_test.fbs"
+
+fail() {
+  echo "FlatcJobsTest failed: $*"
+  exit 1
+}
+
+mkdir -p "$tmp/json" "$tmp/bin"
+for i in 1 2 3 4 5 6 7 8; do
+  cp monsterdata_test.json "$tmp/json/m$i.json"
+done
+
+# JSON to binary, and the binaries back to JSON.
+$flatc -b -o "$tmp/bin" $schema "$tmp"/json/*.json
+$flatc -b --jobs 3 -o "$tmp/bin_jobs" $schema "$tmp"/json/*.json
+diff -r "$tmp/bin" "$tmp/bin_jobs" || fail "binaries differ"
+$flatc -t -o "$tmp/text" $schema -- "$tmp"/bin/*.mon
+$flatc -t --jobs 3 -o "$tmp/text_jobs" $schema -- "$tmp"/bin/*.mon
+diff -r "$tmp/text" "$tmp/text_jobs" || fail "text differs"
+
+# -j is still the short form of --java.
+$flatc -j -o "$tmp/java" $schema
+test -f "$tmp/java/MyGame/Example/Monster.java" || fail "-j generated no Java"
+
+# A binary with the wrong file_identifier, and JSON that doesn't parse.
+mkdir -p "$tmp/bad"
+cp "$tmp/bin/m1.mon" "$tmp/bad/a.mon"
+cp "$tmp/bin/m1.mon" "$tmp/bad/b.mon"
+printf 'XXXX' | dd of="$tmp/bad/b.mon" bs=1 seek=4 conv=notrunc 2>/dev/null
+for i in 1 2 3 4 5 6; do cp "$tmp/bin/m1.mon" "$tmp/bad/c$i.mon"; done
+cp monsterdata_test.json "$tmp/bad/a.json"
+echo "{ name: " > "$tmp/bad/b.json"
+for i in 1 2 3 4 5 6; do cp monsterdata_test.json "$tmp/bad/c$i.json"; done
+
+for jobs in 1 3; do
+  out="$tmp/bad_out$jobs"
+  status=0
+  $flatc -t --jobs $jobs -o "$out" $schema -- "$tmp"/bad/*.mon \
+    > "$tmp/err" 2>&1 || status=$?
+  test $status -eq 1 || fail "--jobs $jobs exited with $status on a bad binary"
+  grep -q "does not have expected file_identifier" "$tmp/err" ||
+    fail "--jobs $jobs did not report the bad binary"
+  test -f "$out/a.json" || fail "--jobs $jobs skipped the file before the error"
+  test ! -f "$out/b.json" || fail "--jobs $jobs wrote the bad binary"
+
+  status=0
+  $flatc -b --jobs $jobs -o "$out" $schema "$tmp"/bad/*.json \
+    > "$tmp/err" 2>&1 || status=$?
+  test $status -eq 1 || fail "--jobs $jobs exited with $status on bad JSON"
+  test -f "$out/a.mon" || fail "--jobs $jobs skipped the file before the error"
+  test ! -f "$out/b.mon" || fail "--jobs $jobs wrote the bad JSON"
+done
+
+echo "FlatcJobsTest passed"
@@ -78,8 +78,8 @@ FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) NestedStruct FLATBUFFERS_FINAL_CLASS {
   }
   NestedStruct(MyGame::Example::TestEnum _b)
       : b_(flatbuffers::EndianScalar(static_cast<int8_t>(_b))) {
-    std::memset(a_, 0, sizeof(a_));
-    std::memset(c_, 0, sizeof(c_));
+    std::memset(static_cast<void *>(a_), 0, sizeof(a_));
+    std::memset(static_cast<void *>(c_), 0, sizeof(c_));
     (void)padding0__;
   }
   const flatbuffers::Array<int32_t, 2> *a() const {
@@ -135,9 +135,9 @@ FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) ArrayStruct FLATBUFFERS_FINAL_CLASS {
         c_(flatbuffers::EndianScalar(_c)),
         padding0__(0),
         padding1__(0) {
-    std::memset(b_, 0, sizeof(b_));
+    std::memset(static_cast<void *>(b_), 0, sizeof(b_));
     (void)padding0__;    (void)padding1__;
-    std::memset(d_, 0, sizeof(d_));
+    std::memset(static_cast<void *>(d_), 0, sizeof(d_));
   }
   float a() const {
     return flatbuffers::EndianScalar(a_);
@@ -184,6 +184,7 @@ struct ArrayTableT : public flatbuffers::NativeTable {
   flatbuffers::unique_ptr<MyGame::Example::ArrayStruct> a;
   ArrayTableT() {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const ArrayTableT &lhs, const ArrayTableT &rhs) {
@@ -257,7 +258,7 @@ inline ArrayTableT *ArrayTable::UnPack(const flatbuffers::resolver_function_t *_
 inline void ArrayTable::UnPackTo(ArrayTableT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = a(); if (_e) _o->a = flatbuffers::unique_ptr<MyGame::Example::ArrayStruct>(new MyGame::Example::ArrayStruct(*_e)); };
+  { auto _e = a(); if (_e) { if (_o->a) *_o->a = *_e; else _o->a = flatbuffers::unique_ptr<MyGame::Example::ArrayStruct>(new MyGame::Example::ArrayStruct(*_e)); } else { _o->a.reset(); } };
 }
 
 inline flatbuffers::Offset<ArrayTable> ArrayTable::Pack(flatbuffers::FlatBufferBuilder &_fbb, const ArrayTableT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -274,6 +275,11 @@ inline flatbuffers::Offset<ArrayTable> CreateArrayTable(flatbuffers::FlatBufferB
       _a);
 }
 
+inline size_t ArrayTableT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(1, 96);
+  return _size;
+}
+
 inline const flatbuffers::TypeTable *TestEnumTypeTable() {
   static const flatbuffers::TypeCode type_codes[] = {
     { flatbuffers::ET_CHAR, 0, 0 },
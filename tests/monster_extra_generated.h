@@ -38,6 +38,7 @@ struct MonsterExtraT : public flatbuffers::NativeTable {
         f2(std::numeric_limits<float>::infinity()),
         f3(-std::numeric_limits<float>::infinity()) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const MonsterExtraT &lhs, const MonsterExtraT &rhs) {
@@ -275,8 +276,8 @@ inline void MonsterExtra::UnPackTo(MonsterExtraT *_o, const flatbuffers::resolve
   { auto _e = f1(); _o->f1 = _e; };
   { auto _e = f2(); _o->f2 = _e; };
   { auto _e = f3(); _o->f3 = _e; };
-  { auto _e = dvec(); if (_e) { _o->dvec.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->dvec[_i] = _e->Get(_i); } } };
-  { auto _e = fvec(); if (_e) { _o->fvec.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->fvec[_i] = _e->Get(_i); } } };
+  { auto _e = dvec(); if (_e) { flatbuffers::UnPackVector(_e, &_o->dvec); } else { _o->dvec.clear(); } };
+  { auto _e = fvec(); if (_e) { flatbuffers::UnPackVector(_e, &_o->fvec); } else { _o->fvec.clear(); } };
 }
 
 inline flatbuffers::Offset<MonsterExtra> MonsterExtra::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MonsterExtraT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -311,6 +312,13 @@ inline flatbuffers::Offset<MonsterExtra> CreateMonsterExtra(flatbuffers::FlatBuf
       _fvec);
 }
 
+inline size_t MonsterExtraT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(10, 112);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(dvec.size(), 8, 8);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(fvec.size(), 4, 4);
+  return _size;
+}
+
 inline const flatbuffers::TypeTable *MonsterExtraTypeTable() {
   static const flatbuffers::TypeCode type_codes[] = {
     { flatbuffers::ET_DOUBLE, 0, -1 },
@@ -223,7 +223,9 @@ struct AnyUnion {
 #endif  // FLATBUFFERS_CPP98_STL
 
   static void *UnPack(const void *obj, Any type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t SerializedSizeBound() const;
 
   MyGame::Example::MonsterT *AsMonster() {
     return type == Any_Monster ?
@@ -365,7 +367,9 @@ struct AnyUniqueAliasesUnion {
 #endif  // FLATBUFFERS_CPP98_STL
 
   static void *UnPack(const void *obj, AnyUniqueAliases type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t SerializedSizeBound() const;
 
   MyGame::Example::MonsterT *AsM() {
     return type == AnyUniqueAliases_M ?
@@ -479,7 +483,9 @@ struct AnyAmbiguousAliasesUnion {
   void Reset();
 
   static void *UnPack(const void *obj, AnyAmbiguousAliases type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t SerializedSizeBound() const;
 
   MyGame::Example::MonsterT *AsM1() {
     return type == AnyAmbiguousAliases_M1 ?
@@ -725,6 +731,7 @@ struct InParentNamespaceT : public flatbuffers::NativeTable {
   typedef InParentNamespace TableType;
   InParentNamespaceT() {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const InParentNamespaceT &, const InParentNamespaceT &) {
@@ -779,6 +786,7 @@ struct MonsterT : public flatbuffers::NativeTable {
   typedef Monster TableType;
   MonsterT() {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const MonsterT &, const MonsterT &) {
@@ -837,6 +845,7 @@ struct TestSimpleTableWithEnumT : public flatbuffers::NativeTable {
   TestSimpleTableWithEnumT()
       : color(MyGame::Example::Color_Green) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const TestSimpleTableWithEnumT &lhs, const TestSimpleTableWithEnumT &rhs) {
@@ -910,6 +919,7 @@ struct StatT : public flatbuffers::NativeTable {
       : val(0),
         count(0) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const StatT &lhs, const StatT &rhs) {
@@ -1022,6 +1032,7 @@ struct ReferrableT : public flatbuffers::NativeTable {
   ReferrableT()
       : id(0) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const ReferrableT &lhs, const ReferrableT &rhs) {
@@ -1158,6 +1169,7 @@ struct MonsterT : public flatbuffers::NativeTable {
         co_owning_reference(nullptr),
         non_owning_reference(nullptr) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const MonsterT &lhs, const MonsterT &rhs) {
@@ -1641,6 +1653,7 @@ struct Monster FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyVector(testarrayofsortedstruct()) &&
            VerifyOffset(verifier, VT_FLEX) &&
            verifier.VerifyVector(flex()) &&
+           flexbuffers::VerifyNestedFlexBuffer(flex(), verifier) &&
            VerifyOffset(verifier, VT_TEST5) &&
            verifier.VerifyVector(test5()) &&
            VerifyOffset(verifier, VT_VECTOR_OF_LONGS) &&
@@ -2107,6 +2120,7 @@ struct TypeAliasesT : public flatbuffers::NativeTable {
         f32(0.0f),
         f64(0.0) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const TypeAliasesT &lhs, const TypeAliasesT &rhs) {
@@ -2384,6 +2398,11 @@ inline flatbuffers::Offset<InParentNamespace> CreateInParentNamespace(flatbuffer
       _fbb);
 }
 
+inline size_t InParentNamespaceT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(0, 0);
+  return _size;
+}
+
 namespace Example2 {
 
 inline MonsterT *Monster::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
@@ -2409,6 +2428,11 @@ inline flatbuffers::Offset<Monster> CreateMonster(flatbuffers::FlatBufferBuilder
       _fbb);
 }
 
+inline size_t MonsterT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(0, 0);
+  return _size;
+}
+
 }  // namespace Example2
 
 namespace Example {
@@ -2439,6 +2463,11 @@ inline flatbuffers::Offset<TestSimpleTableWithEnum> CreateTestSimpleTableWithEnu
       _color);
 }
 
+inline size_t TestSimpleTableWithEnumT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(1, 2);
+  return _size;
+}
+
 inline StatT *Stat::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new StatT();
   UnPackTo(_o, _resolver);
@@ -2448,7 +2477,7 @@ inline StatT *Stat::UnPack(const flatbuffers::resolver_function_t *_resolver) co
 inline void Stat::UnPackTo(StatT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = id(); if (_e) _o->id = _e->str(); };
+  { auto _e = id(); if (_e) { _o->id.assign(_e->c_str(), _e->size()); } else { _o->id.clear(); } };
   { auto _e = val(); _o->val = _e; };
   { auto _e = count(); _o->count = _e; };
 }
@@ -2471,6 +2500,12 @@ inline flatbuffers::Offset<Stat> CreateStat(flatbuffers::FlatBufferBuilder &_fbb
       _count);
 }
 
+inline size_t StatT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(3, 28);
+  _size += flatbuffers::FlatBufferBuilder::StringSizeBound(id.length());
+  return _size;
+}
+
 inline ReferrableT *Referrable::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new ReferrableT();
   UnPackTo(_o, _resolver);
@@ -2497,6 +2532,11 @@ inline flatbuffers::Offset<Referrable> CreateReferrable(flatbuffers::FlatBufferB
       _id);
 }
 
+inline size_t ReferrableT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(1, 16);
+  return _size;
+}
+
 inline MonsterT *Monster::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new MonsterT();
   UnPackTo(_o, _resolver);
@@ -2506,20 +2546,20 @@ inline MonsterT *Monster::UnPack(const flatbuffers::resolver_function_t *_resolv
 inline void Monster::UnPackTo(MonsterT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = pos(); if (_e) _o->pos = flatbuffers::unique_ptr<MyGame::Example::Vec3>(new MyGame::Example::Vec3(*_e)); };
+  { auto _e = pos(); if (_e) { if (_o->pos) *_o->pos = *_e; else _o->pos = flatbuffers::unique_ptr<MyGame::Example::Vec3>(new MyGame::Example::Vec3(*_e)); } else { _o->pos.reset(); } };
   { auto _e = mana(); _o->mana = _e; };
   { auto _e = hp(); _o->hp = _e; };
-  { auto _e = name(); if (_e) _o->name = _e->str(); };
-  { auto _e = inventory(); if (_e) { _o->inventory.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->inventory[_i] = _e->Get(_i); } } };
+  { auto _e = name(); if (_e) { _o->name.assign(_e->c_str(), _e->size()); } else { _o->name.clear(); } };
+  { auto _e = inventory(); if (_e) { flatbuffers::UnPackVector(_e, &_o->inventory); } else { _o->inventory.clear(); } };
   { auto _e = color(); _o->color = _e; };
-  { auto _e = test_type(); _o->test.type = _e; };
-  { auto _e = test(); if (_e) _o->test.value = AnyUnion::UnPack(_e, test_type(), _resolver); };
-  { auto _e = test4(); if (_e) { _o->test4.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->test4[_i] = *_e->Get(_i); } } };
-  { auto _e = testarrayofstring(); if (_e) { _o->testarrayofstring.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testarrayofstring[_i] = _e->Get(_i)->str(); } } };
-  { auto _e = testarrayoftables(); if (_e) { _o->testarrayoftables.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testarrayoftables[_i] = flatbuffers::unique_ptr<MyGame::Example::MonsterT>(_e->Get(_i)->UnPack(_resolver)); } } };
-  { auto _e = enemy(); if (_e) _o->enemy = flatbuffers::unique_ptr<MyGame::Example::MonsterT>(_e->UnPack(_resolver)); };
-  { auto _e = testnestedflatbuffer(); if (_e) { _o->testnestedflatbuffer.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testnestedflatbuffer[_i] = _e->Get(_i); } } };
-  { auto _e = testempty(); if (_e) _o->testempty = flatbuffers::unique_ptr<MyGame::Example::StatT>(_e->UnPack(_resolver)); };
+  { auto _e = test_type(); if (_o->test.type != _e) _o->test.Reset(); _o->test.type = _e; };
+  { auto _e = test(); if (_e) { _o->test.UnPackTo(_e, _resolver); } else { _o->test.Reset(); } };
+  { auto _e = test4(); if (_e) { flatbuffers::UnPackVector(_e, &_o->test4); } else { _o->test4.clear(); } };
+  { auto _e = testarrayofstring(); if (_e) { { _o->testarrayofstring.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testarrayofstring[_i].assign(_e->Get(_i)->c_str(), _e->Get(_i)->size()); } } } else { _o->testarrayofstring.clear(); } };
+  { auto _e = testarrayoftables(); if (_e) { { _o->testarrayoftables.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if (_o->testarrayoftables[_i]) _e->Get(_i)->UnPackTo(_o->testarrayoftables[_i].get(), _resolver); else _o->testarrayoftables[_i] = flatbuffers::unique_ptr<MyGame::Example::MonsterT>(_e->Get(_i)->UnPack(_resolver)); } } } else { _o->testarrayoftables.clear(); } };
+  { auto _e = enemy(); if (_e) { if (_o->enemy) _e->UnPackTo(_o->enemy.get(), _resolver); else _o->enemy = flatbuffers::unique_ptr<MyGame::Example::MonsterT>(_e->UnPack(_resolver)); } else { _o->enemy.reset(); } };
+  { auto _e = testnestedflatbuffer(); if (_e) { flatbuffers::UnPackVector(_e, &_o->testnestedflatbuffer); } else { _o->testnestedflatbuffer.clear(); } };
+  { auto _e = testempty(); if (_e) { if (_o->testempty) _e->UnPackTo(_o->testempty.get(), _resolver); else _o->testempty = flatbuffers::unique_ptr<MyGame::Example::StatT>(_e->UnPack(_resolver)); } else { _o->testempty.reset(); } };
   { auto _e = testbool(); _o->testbool = _e; };
   { auto _e = testhashs32_fnv1(); _o->testhashs32_fnv1 = _e; };
   { auto _e = testhashu32_fnv1(); _o->testhashu32_fnv1 = _e; };
@@ -2530,36 +2570,36 @@ inline void Monster::UnPackTo(MonsterT *_o, const flatbuffers::resolver_function
 if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->testhashu32_fnv1a), static_cast<flatbuffers::hash_value_t>(_e)); else _o->testhashu32_fnv1a = nullptr; };
   { auto _e = testhashs64_fnv1a(); _o->testhashs64_fnv1a = _e; };
   { auto _e = testhashu64_fnv1a(); _o->testhashu64_fnv1a = _e; };
-  { auto _e = testarrayofbools(); if (_e) { _o->testarrayofbools.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testarrayofbools[_i] = _e->Get(_i) != 0; } } };
+  { auto _e = testarrayofbools(); if (_e) { { _o->testarrayofbools.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testarrayofbools[_i] = _e->Get(_i) != 0; } } } else { _o->testarrayofbools.clear(); } };
   { auto _e = testf(); _o->testf = _e; };
   { auto _e = testf2(); _o->testf2 = _e; };
   { auto _e = testf3(); _o->testf3 = _e; };
-  { auto _e = testarrayofstring2(); if (_e) { _o->testarrayofstring2.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testarrayofstring2[_i] = _e->Get(_i)->str(); } } };
-  { auto _e = testarrayofsortedstruct(); if (_e) { _o->testarrayofsortedstruct.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testarrayofsortedstruct[_i] = *_e->Get(_i); } } };
-  { auto _e = flex(); if (_e) { _o->flex.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->flex[_i] = _e->Get(_i); } } };
-  { auto _e = test5(); if (_e) { _o->test5.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->test5[_i] = *_e->Get(_i); } } };
-  { auto _e = vector_of_longs(); if (_e) { _o->vector_of_longs.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->vector_of_longs[_i] = _e->Get(_i); } } };
-  { auto _e = vector_of_doubles(); if (_e) { _o->vector_of_doubles.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->vector_of_doubles[_i] = _e->Get(_i); } } };
-  { auto _e = parent_namespace_test(); if (_e) _o->parent_namespace_test = flatbuffers::unique_ptr<MyGame::InParentNamespaceT>(_e->UnPack(_resolver)); };
-  { auto _e = vector_of_referrables(); if (_e) { _o->vector_of_referrables.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->vector_of_referrables[_i] = flatbuffers::unique_ptr<MyGame::Example::ReferrableT>(_e->Get(_i)->UnPack(_resolver)); } } };
+  { auto _e = testarrayofstring2(); if (_e) { { _o->testarrayofstring2.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->testarrayofstring2[_i].assign(_e->Get(_i)->c_str(), _e->Get(_i)->size()); } } } else { _o->testarrayofstring2.clear(); } };
+  { auto _e = testarrayofsortedstruct(); if (_e) { flatbuffers::UnPackVector(_e, &_o->testarrayofsortedstruct); } else { _o->testarrayofsortedstruct.clear(); } };
+  { auto _e = flex(); if (_e) { flatbuffers::UnPackVector(_e, &_o->flex); } else { _o->flex.clear(); } };
+  { auto _e = test5(); if (_e) { flatbuffers::UnPackVector(_e, &_o->test5); } else { _o->test5.clear(); } };
+  { auto _e = vector_of_longs(); if (_e) { flatbuffers::UnPackVector(_e, &_o->vector_of_longs); } else { _o->vector_of_longs.clear(); } };
+  { auto _e = vector_of_doubles(); if (_e) { flatbuffers::UnPackVector(_e, &_o->vector_of_doubles); } else { _o->vector_of_doubles.clear(); } };
+  { auto _e = parent_namespace_test(); if (_e) { if (_o->parent_namespace_test) _e->UnPackTo(_o->parent_namespace_test.get(), _resolver); else _o->parent_namespace_test = flatbuffers::unique_ptr<MyGame::InParentNamespaceT>(_e->UnPack(_resolver)); } else { _o->parent_namespace_test.reset(); } };
+  { auto _e = vector_of_referrables(); if (_e) { { _o->vector_of_referrables.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if (_o->vector_of_referrables[_i]) _e->Get(_i)->UnPackTo(_o->vector_of_referrables[_i].get(), _resolver); else _o->vector_of_referrables[_i] = flatbuffers::unique_ptr<MyGame::Example::ReferrableT>(_e->Get(_i)->UnPack(_resolver)); } } } else { _o->vector_of_referrables.clear(); } };
   { auto _e = single_weak_reference(); //scalar resolver, naked 
 if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->single_weak_reference), static_cast<flatbuffers::hash_value_t>(_e)); else _o->single_weak_reference = nullptr; };
-  { auto _e = vector_of_weak_references(); if (_e) { _o->vector_of_weak_references.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { //vector resolver, naked
-if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->vector_of_weak_references[_i]), static_cast<flatbuffers::hash_value_t>(_e->Get(_i))); else _o->vector_of_weak_references[_i] = nullptr; } } };
-  { auto _e = vector_of_strong_referrables(); if (_e) { _o->vector_of_strong_referrables.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->vector_of_strong_referrables[_i] = flatbuffers::unique_ptr<MyGame::Example::ReferrableT>(_e->Get(_i)->UnPack(_resolver)); } } };
+  { auto _e = vector_of_weak_references(); if (_e) { { _o->vector_of_weak_references.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { //vector resolver, naked
+if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->vector_of_weak_references[_i]), static_cast<flatbuffers::hash_value_t>(_e->Get(_i))); else _o->vector_of_weak_references[_i] = nullptr; } } } else { _o->vector_of_weak_references.clear(); } };
+  { auto _e = vector_of_strong_referrables(); if (_e) { { _o->vector_of_strong_referrables.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if (_o->vector_of_strong_referrables[_i]) _e->Get(_i)->UnPackTo(_o->vector_of_strong_referrables[_i].get(), _resolver); else _o->vector_of_strong_referrables[_i] = flatbuffers::unique_ptr<MyGame::Example::ReferrableT>(_e->Get(_i)->UnPack(_resolver)); } } } else { _o->vector_of_strong_referrables.clear(); } };
   { auto _e = co_owning_reference(); //scalar resolver, naked 
 if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->co_owning_reference), static_cast<flatbuffers::hash_value_t>(_e)); else _o->co_owning_reference = nullptr; };
-  { auto _e = vector_of_co_owning_references(); if (_e) { _o->vector_of_co_owning_references.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { //vector resolver, default_ptr_type
-if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->vector_of_co_owning_references[_i]), static_cast<flatbuffers::hash_value_t>(_e->Get(_i)));/* else do nothing */; } } };
+  { auto _e = vector_of_co_owning_references(); if (_e) { { _o->vector_of_co_owning_references.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { //vector resolver, default_ptr_type
+if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->vector_of_co_owning_references[_i]), static_cast<flatbuffers::hash_value_t>(_e->Get(_i)));/* else do nothing */; } } } else { _o->vector_of_co_owning_references.clear(); } };
   { auto _e = non_owning_reference(); //scalar resolver, naked 
 if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->non_owning_reference), static_cast<flatbuffers::hash_value_t>(_e)); else _o->non_owning_reference = nullptr; };
-  { auto _e = vector_of_non_owning_references(); if (_e) { _o->vector_of_non_owning_references.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { //vector resolver, naked
-if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->vector_of_non_owning_references[_i]), static_cast<flatbuffers::hash_value_t>(_e->Get(_i))); else _o->vector_of_non_owning_references[_i] = nullptr; } } };
-  { auto _e = any_unique_type(); _o->any_unique.type = _e; };
-  { auto _e = any_unique(); if (_e) _o->any_unique.value = AnyUniqueAliasesUnion::UnPack(_e, any_unique_type(), _resolver); };
-  { auto _e = any_ambiguous_type(); _o->any_ambiguous.type = _e; };
-  { auto _e = any_ambiguous(); if (_e) _o->any_ambiguous.value = AnyAmbiguousAliasesUnion::UnPack(_e, any_ambiguous_type(), _resolver); };
-  { auto _e = vector_of_enums(); if (_e) { _o->vector_of_enums.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->vector_of_enums[_i] = static_cast<MyGame::Example::Color>(_e->Get(_i)); } } };
+  { auto _e = vector_of_non_owning_references(); if (_e) { { _o->vector_of_non_owning_references.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { //vector resolver, naked
+if (_resolver) (*_resolver)(reinterpret_cast<void **>(&_o->vector_of_non_owning_references[_i]), static_cast<flatbuffers::hash_value_t>(_e->Get(_i))); else _o->vector_of_non_owning_references[_i] = nullptr; } } } else { _o->vector_of_non_owning_references.clear(); } };
+  { auto _e = any_unique_type(); if (_o->any_unique.type != _e) _o->any_unique.Reset(); _o->any_unique.type = _e; };
+  { auto _e = any_unique(); if (_e) { _o->any_unique.UnPackTo(_e, _resolver); } else { _o->any_unique.Reset(); } };
+  { auto _e = any_ambiguous_type(); if (_o->any_ambiguous.type != _e) _o->any_ambiguous.Reset(); _o->any_ambiguous.type = _e; };
+  { auto _e = any_ambiguous(); if (_e) { _o->any_ambiguous.UnPackTo(_e, _resolver); } else { _o->any_ambiguous.Reset(); } };
+  { auto _e = vector_of_enums(); if (_e) { flatbuffers::UnPackVector(_e, &_o->vector_of_enums); } else { _o->vector_of_enums.clear(); } };
 }
 
 inline flatbuffers::Offset<Monster> Monster::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MonsterT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -2668,6 +2708,51 @@ inline flatbuffers::Offset<Monster> CreateMonster(flatbuffers::FlatBufferBuilder
       _vector_of_enums);
 }
 
+inline size_t MonsterT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(48, 426);
+  _size += flatbuffers::FlatBufferBuilder::StringSizeBound(name.length());
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(inventory.size(), 1, 1);
+  _size += test.SerializedSizeBound();
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(test4.size(), 4, 2);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(testarrayofstring.size(), 4, 4);
+  for (size_t _i = 0; _i < testarrayofstring.size(); _i++) {
+    _size += flatbuffers::FlatBufferBuilder::StringSizeBound(testarrayofstring[_i].length());
+  }
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(testarrayoftables.size(), 4, 4);
+  for (size_t _i = 0; _i < testarrayoftables.size(); _i++) {
+    _size += testarrayoftables[_i].get()->SerializedSizeBound();
+  }
+  if (enemy) _size += enemy.get()->SerializedSizeBound();
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(testnestedflatbuffer.size(), 1, 1);
+  if (testempty) _size += testempty.get()->SerializedSizeBound();
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(testarrayofbools.size(), 1, 1);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(testarrayofstring2.size(), 4, 4);
+  for (size_t _i = 0; _i < testarrayofstring2.size(); _i++) {
+    _size += flatbuffers::FlatBufferBuilder::StringSizeBound(testarrayofstring2[_i].length());
+  }
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(testarrayofsortedstruct.size(), 8, 4);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(flex.size(), 1, 1);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(test5.size(), 4, 2);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vector_of_longs.size(), 8, 8);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vector_of_doubles.size(), 8, 8);
+  if (parent_namespace_test) _size += parent_namespace_test.get()->SerializedSizeBound();
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vector_of_referrables.size(), 4, 4);
+  for (size_t _i = 0; _i < vector_of_referrables.size(); _i++) {
+    _size += vector_of_referrables[_i].get()->SerializedSizeBound();
+  }
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vector_of_weak_references.size(), 8, 8);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vector_of_strong_referrables.size(), 4, 4);
+  for (size_t _i = 0; _i < vector_of_strong_referrables.size(); _i++) {
+    _size += vector_of_strong_referrables[_i].get()->SerializedSizeBound();
+  }
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vector_of_co_owning_references.size(), 8, 8);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vector_of_non_owning_references.size(), 8, 8);
+  _size += any_unique.SerializedSizeBound();
+  _size += any_ambiguous.SerializedSizeBound();
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vector_of_enums.size(), 1, 1);
+  return _size;
+}
+
 inline TypeAliasesT *TypeAliases::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new TypeAliasesT();
   UnPackTo(_o, _resolver);
@@ -2687,8 +2772,8 @@ inline void TypeAliases::UnPackTo(TypeAliasesT *_o, const flatbuffers::resolver_
   { auto _e = u64(); _o->u64 = _e; };
   { auto _e = f32(); _o->f32 = _e; };
   { auto _e = f64(); _o->f64 = _e; };
-  { auto _e = v8(); if (_e) { _o->v8.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->v8[_i] = _e->Get(_i); } } };
-  { auto _e = vf64(); if (_e) { _o->vf64.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->vf64[_i] = _e->Get(_i); } } };
+  { auto _e = v8(); if (_e) { flatbuffers::UnPackVector(_e, &_o->v8); } else { _o->v8.clear(); } };
+  { auto _e = vf64(); if (_e) { flatbuffers::UnPackVector(_e, &_o->vf64); } else { _o->vf64.clear(); } };
 }
 
 inline flatbuffers::Offset<TypeAliases> TypeAliases::Pack(flatbuffers::FlatBufferBuilder &_fbb, const TypeAliasesT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -2727,6 +2812,13 @@ inline flatbuffers::Offset<TypeAliases> CreateTypeAliases(flatbuffers::FlatBuffe
       _vf64);
 }
 
+inline size_t TypeAliasesT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(12, 100);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(v8.size(), 1, 1);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(vf64.size(), 8, 8);
+  return _size;
+}
+
 inline bool VerifyAny(flatbuffers::Verifier &verifier, const void *obj, Any type) {
   switch (type) {
     case Any_NONE: {
@@ -2778,6 +2870,30 @@ inline void *AnyUnion::UnPack(const void *obj, Any type, const flatbuffers::reso
   }
 }
 
+inline void AnyUnion::UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver) {
+  switch (type) {
+    case Any_Monster: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example::MonsterT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case Any_TestSimpleTableWithEnum: {
+      auto ptr = reinterpret_cast<const MyGame::Example::TestSimpleTableWithEnum *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example::TestSimpleTableWithEnumT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case Any_MyGame_Example2_Monster: {
+      auto ptr = reinterpret_cast<const MyGame::Example2::Monster *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example2::MonsterT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> AnyUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   switch (type) {
     case Any_Monster: {
@@ -2796,6 +2912,24 @@ inline flatbuffers::Offset<void> AnyUnion::Pack(flatbuffers::FlatBufferBuilder &
   }
 }
 
+inline size_t AnyUnion::SerializedSizeBound() const {
+  switch (type) {
+    case Any_Monster: {
+      auto ptr = reinterpret_cast<const MyGame::Example::MonsterT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    case Any_TestSimpleTableWithEnum: {
+      auto ptr = reinterpret_cast<const MyGame::Example::TestSimpleTableWithEnumT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    case Any_MyGame_Example2_Monster: {
+      auto ptr = reinterpret_cast<const MyGame::Example2::MonsterT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    default: return 0;
+  }
+}
+
 inline AnyUnion::AnyUnion(const AnyUnion &u) FLATBUFFERS_NOEXCEPT : type(u.type), value(nullptr) {
   switch (type) {
     case Any_Monster: {
@@ -2889,6 +3023,30 @@ inline void *AnyUniqueAliasesUnion::UnPack(const void *obj, AnyUniqueAliases typ
   }
 }
 
+inline void AnyUniqueAliasesUnion::UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver) {
+  switch (type) {
+    case AnyUniqueAliases_M: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example::MonsterT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case AnyUniqueAliases_TS: {
+      auto ptr = reinterpret_cast<const MyGame::Example::TestSimpleTableWithEnum *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example::TestSimpleTableWithEnumT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case AnyUniqueAliases_M2: {
+      auto ptr = reinterpret_cast<const MyGame::Example2::Monster *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example2::MonsterT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> AnyUniqueAliasesUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   switch (type) {
     case AnyUniqueAliases_M: {
@@ -2907,6 +3065,24 @@ inline flatbuffers::Offset<void> AnyUniqueAliasesUnion::Pack(flatbuffers::FlatBu
   }
 }
 
+inline size_t AnyUniqueAliasesUnion::SerializedSizeBound() const {
+  switch (type) {
+    case AnyUniqueAliases_M: {
+      auto ptr = reinterpret_cast<const MyGame::Example::MonsterT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    case AnyUniqueAliases_TS: {
+      auto ptr = reinterpret_cast<const MyGame::Example::TestSimpleTableWithEnumT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    case AnyUniqueAliases_M2: {
+      auto ptr = reinterpret_cast<const MyGame::Example2::MonsterT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    default: return 0;
+  }
+}
+
 inline AnyUniqueAliasesUnion::AnyUniqueAliasesUnion(const AnyUniqueAliasesUnion &u) FLATBUFFERS_NOEXCEPT : type(u.type), value(nullptr) {
   switch (type) {
     case AnyUniqueAliases_M: {
@@ -3000,6 +3176,30 @@ inline void *AnyAmbiguousAliasesUnion::UnPack(const void *obj, AnyAmbiguousAlias
   }
 }
 
+inline void AnyAmbiguousAliasesUnion::UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver) {
+  switch (type) {
+    case AnyAmbiguousAliases_M1: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example::MonsterT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case AnyAmbiguousAliases_M2: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example::MonsterT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case AnyAmbiguousAliases_M3: {
+      auto ptr = reinterpret_cast<const MyGame::Example::Monster *>(obj);
+      auto _o = reinterpret_cast<MyGame::Example::MonsterT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> AnyAmbiguousAliasesUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   switch (type) {
     case AnyAmbiguousAliases_M1: {
@@ -3018,6 +3218,24 @@ inline flatbuffers::Offset<void> AnyAmbiguousAliasesUnion::Pack(flatbuffers::Fla
   }
 }
 
+inline size_t AnyAmbiguousAliasesUnion::SerializedSizeBound() const {
+  switch (type) {
+    case AnyAmbiguousAliases_M1: {
+      auto ptr = reinterpret_cast<const MyGame::Example::MonsterT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    case AnyAmbiguousAliases_M2: {
+      auto ptr = reinterpret_cast<const MyGame::Example::MonsterT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    case AnyAmbiguousAliases_M3: {
+      auto ptr = reinterpret_cast<const MyGame::Example::MonsterT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    default: return 0;
+  }
+}
+
 inline AnyAmbiguousAliasesUnion::AnyAmbiguousAliasesUnion(const AnyAmbiguousAliasesUnion &u) FLATBUFFERS_NOEXCEPT : type(u.type), value(nullptr) {
   switch (type) {
     case AnyAmbiguousAliases_M1: {
@@ -0,0 +1,979 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+
+#ifndef FLATBUFFERS_GENERATED_NATIVEARENATEST_NATIVEARENATEST_H_
+#define FLATBUFFERS_GENERATED_NATIVEARENATEST_NATIVEARENATEST_H_
+
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/arena.h"
+
+namespace NativeArenaTest {
+
+struct Point;
+
+struct Leaf;
+struct LeafT;
+
+struct Node;
+struct NodeT;
+
+inline const flatbuffers::TypeTable *PointTypeTable();
+
+inline const flatbuffers::TypeTable *LeafTypeTable();
+
+inline const flatbuffers::TypeTable *NodeTypeTable();
+
+enum Kind {
+  Kind_Leaf = 0,
+  Kind_Branch = 1,
+  Kind_MIN = Kind_Leaf,
+  Kind_MAX = Kind_Branch
+};
+
+inline const Kind (&EnumValuesKind())[2] {
+  static const Kind values[] = {
+    Kind_Leaf,
+    Kind_Branch
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesKind() {
+  static const char * const names[3] = {
+    "Leaf",
+    "Branch",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameKind(Kind e) {
+  if (e < Kind_Leaf || e > Kind_Branch) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesKind()[index];
+}
+
+enum Payload {
+  Payload_NONE = 0,
+  Payload_Leaf = 1,
+  Payload_Node = 2,
+  Payload_MIN = Payload_NONE,
+  Payload_MAX = Payload_Node
+};
+
+inline const Payload (&EnumValuesPayload())[3] {
+  static const Payload values[] = {
+    Payload_NONE,
+    Payload_Leaf,
+    Payload_Node
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesPayload() {
+  static const char * const names[4] = {
+    "NONE",
+    "Leaf",
+    "Node",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNamePayload(Payload e) {
+  if (e < Payload_NONE || e > Payload_Node) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesPayload()[index];
+}
+
+template<typename T> struct PayloadTraits {
+  static const Payload enum_value = Payload_NONE;
+};
+
+template<> struct PayloadTraits<NativeArenaTest::Leaf> {
+  static const Payload enum_value = Payload_Leaf;
+};
+
+template<> struct PayloadTraits<NativeArenaTest::Node> {
+  static const Payload enum_value = Payload_Node;
+};
+
+struct PayloadUnion {
+  Payload type;
+  void *value;
+
+  PayloadUnion() : type(Payload_NONE), value(nullptr) {}
+  PayloadUnion(PayloadUnion&& u) FLATBUFFERS_NOEXCEPT :
+    type(Payload_NONE), value(nullptr)
+    { std::swap(type, u.type); std::swap(value, u.value); }
+  PayloadUnion(const PayloadUnion &) FLATBUFFERS_NOEXCEPT;
+  PayloadUnion &operator=(const PayloadUnion &u) FLATBUFFERS_NOEXCEPT
+    { PayloadUnion t(u); std::swap(type, t.type); std::swap(value, t.value); return *this; }
+  PayloadUnion &operator=(PayloadUnion &&u) FLATBUFFERS_NOEXCEPT
+    { std::swap(type, u.type); std::swap(value, u.value); return *this; }
+  ~PayloadUnion() { Reset(); }
+
+  void Reset();
+
+#ifndef FLATBUFFERS_CPP98_STL
+  template <typename T>
+  void Set(T&& val) {
+    using RT = typename std::remove_reference<T>::type;
+    Reset();
+    type = PayloadTraits<typename RT::TableType>::enum_value;
+    if (type != Payload_NONE) {
+      value = new RT(std::forward<T>(val));
+    }
+  }
+#endif  // FLATBUFFERS_CPP98_STL
+
+  static void *UnPack(const void *obj, Payload type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver);
+  flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t SerializedSizeBound() const;
+
+  NativeArenaTest::LeafT *AsLeaf() {
+    return type == Payload_Leaf ?
+      reinterpret_cast<NativeArenaTest::LeafT *>(value) : nullptr;
+  }
+  const NativeArenaTest::LeafT *AsLeaf() const {
+    return type == Payload_Leaf ?
+      reinterpret_cast<const NativeArenaTest::LeafT *>(value) : nullptr;
+  }
+  NativeArenaTest::NodeT *AsNode() {
+    return type == Payload_Node ?
+      reinterpret_cast<NativeArenaTest::NodeT *>(value) : nullptr;
+  }
+  const NativeArenaTest::NodeT *AsNode() const {
+    return type == Payload_Node ?
+      reinterpret_cast<const NativeArenaTest::NodeT *>(value) : nullptr;
+  }
+};
+
+bool VerifyPayload(flatbuffers::Verifier &verifier, const void *obj, Payload type);
+bool VerifyPayloadVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types);
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) Point FLATBUFFERS_FINAL_CLASS {
+ private:
+  float x_;
+  float y_;
+
+ public:
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return PointTypeTable();
+  }
+  Point() {
+    memset(static_cast<void *>(this), 0, sizeof(Point));
+  }
+  Point(float _x, float _y)
+      : x_(flatbuffers::EndianScalar(_x)),
+        y_(flatbuffers::EndianScalar(_y)) {
+  }
+  float x() const {
+    return flatbuffers::EndianScalar(x_);
+  }
+  void mutate_x(float _x) {
+    flatbuffers::WriteScalar(&x_, _x);
+  }
+  float y() const {
+    return flatbuffers::EndianScalar(y_);
+  }
+  void mutate_y(float _y) {
+    flatbuffers::WriteScalar(&y_, _y);
+  }
+  static void *operator new(std::size_t size) {
+    return flatbuffers::NativeArena::NewObject(size);
+  }
+  static void operator delete(void *ptr) {
+    flatbuffers::NativeArena::DeleteObject(ptr);
+  }
+};
+FLATBUFFERS_STRUCT_END(Point, 8);
+
+struct LeafT : public flatbuffers::NativeTable {
+  typedef Leaf TableType;
+  flatbuffers::native_string name;
+  std::vector<int32_t, flatbuffers::NativeAllocator<int32_t>> values;
+  static void *operator new(std::size_t size) {
+    return flatbuffers::NativeArena::NewObject(size);
+  }
+  static void operator delete(void *ptr) {
+    flatbuffers::NativeArena::DeleteObject(ptr);
+  }
+  LeafT() {
+  }
+  size_t SerializedSizeBound() const;
+};
+
+struct Leaf FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef LeafT NativeTableType;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return LeafTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_VALUES = 6
+  };
+  const flatbuffers::String *name() const {
+    return GetPointer<const flatbuffers::String *>(VT_NAME);
+  }
+  flatbuffers::String *mutable_name() {
+    return GetPointer<flatbuffers::String *>(VT_NAME);
+  }
+  const flatbuffers::Vector<int32_t> *values() const {
+    return GetPointer<const flatbuffers::Vector<int32_t> *>(VT_VALUES);
+  }
+  flatbuffers::Vector<int32_t> *mutable_values() {
+    return GetPointer<flatbuffers::Vector<int32_t> *>(VT_VALUES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyOffset(verifier, VT_VALUES) &&
+           verifier.VerifyVector(values()) &&
+           verifier.EndTable();
+  }
+  LeafT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(LeafT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  LeafT *UnPack(flatbuffers::NativeArena &_arena, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(flatbuffers::NativeArena &_arena, LeafT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<Leaf> Pack(flatbuffers::FlatBufferBuilder &_fbb, const LeafT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct LeafBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(Leaf::VT_NAME, name);
+  }
+  void add_values(flatbuffers::Offset<flatbuffers::Vector<int32_t>> values) {
+    fbb_.AddOffset(Leaf::VT_VALUES, values);
+  }
+  explicit LeafBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  LeafBuilder &operator=(const LeafBuilder &);
+  flatbuffers::Offset<Leaf> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Leaf>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Leaf> CreateLeaf(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int32_t>> values = 0) {
+  LeafBuilder builder_(_fbb);
+  builder_.add_values(values);
+  builder_.add_name(name);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Leaf> CreateLeafDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *name = nullptr,
+    const std::vector<int32_t> *values = nullptr) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  auto values__ = values ? _fbb.CreateVector<int32_t>(*values) : 0;
+  return NativeArenaTest::CreateLeaf(
+      _fbb,
+      name__,
+      values__);
+}
+
+flatbuffers::Offset<Leaf> CreateLeaf(flatbuffers::FlatBufferBuilder &_fbb, const LeafT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct NodeT : public flatbuffers::NativeTable {
+  typedef Node TableType;
+  flatbuffers::native_string name;
+  NativeArenaTest::Kind kind;
+  std::vector<flatbuffers::native_string, flatbuffers::NativeAllocator<flatbuffers::native_string>> tags;
+  std::vector<bool, flatbuffers::NativeAllocator<bool>> flags;
+  std::vector<NativeArenaTest::Kind, flatbuffers::NativeAllocator<NativeArenaTest::Kind>> kinds;
+  flatbuffers::unique_ptr<NativeArenaTest::Point> position;
+  std::vector<NativeArenaTest::Point, flatbuffers::NativeAllocator<NativeArenaTest::Point>> path;
+  std::vector<flatbuffers::unique_ptr<NativeArenaTest::LeafT>, flatbuffers::NativeAllocator<flatbuffers::unique_ptr<NativeArenaTest::LeafT>>> leaves;
+  PayloadUnion payload;
+  std::vector<flatbuffers::unique_ptr<NativeArenaTest::NodeT>, flatbuffers::NativeAllocator<flatbuffers::unique_ptr<NativeArenaTest::NodeT>>> children;
+  static void *operator new(std::size_t size) {
+    return flatbuffers::NativeArena::NewObject(size);
+  }
+  static void operator delete(void *ptr) {
+    flatbuffers::NativeArena::DeleteObject(ptr);
+  }
+  NodeT()
+      : kind(NativeArenaTest::Kind_Leaf) {
+  }
+  size_t SerializedSizeBound() const;
+};
+
+struct Node FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef NodeT NativeTableType;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return NodeTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_KIND = 6,
+    VT_TAGS = 8,
+    VT_FLAGS = 10,
+    VT_KINDS = 12,
+    VT_POSITION = 14,
+    VT_PATH = 16,
+    VT_LEAVES = 18,
+    VT_PAYLOAD_TYPE = 20,
+    VT_PAYLOAD = 22,
+    VT_CHILDREN = 24
+  };
+  const flatbuffers::String *name() const {
+    return GetPointer<const flatbuffers::String *>(VT_NAME);
+  }
+  flatbuffers::String *mutable_name() {
+    return GetPointer<flatbuffers::String *>(VT_NAME);
+  }
+  NativeArenaTest::Kind kind() const {
+    return static_cast<NativeArenaTest::Kind>(GetField<int8_t>(VT_KIND, 0));
+  }
+  bool mutate_kind(NativeArenaTest::Kind _kind) {
+    return SetField<int8_t>(VT_KIND, static_cast<int8_t>(_kind), 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *tags() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_TAGS);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *mutable_tags() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_TAGS);
+  }
+  const flatbuffers::Vector<uint8_t> *flags() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_FLAGS);
+  }
+  flatbuffers::Vector<uint8_t> *mutable_flags() {
+    return GetPointer<flatbuffers::Vector<uint8_t> *>(VT_FLAGS);
+  }
+  const flatbuffers::Vector<int8_t> *kinds() const {
+    return GetPointer<const flatbuffers::Vector<int8_t> *>(VT_KINDS);
+  }
+  flatbuffers::Vector<int8_t> *mutable_kinds() {
+    return GetPointer<flatbuffers::Vector<int8_t> *>(VT_KINDS);
+  }
+  const NativeArenaTest::Point *position() const {
+    return GetStruct<const NativeArenaTest::Point *>(VT_POSITION);
+  }
+  NativeArenaTest::Point *mutable_position() {
+    return GetStruct<NativeArenaTest::Point *>(VT_POSITION);
+  }
+  const flatbuffers::Vector<const NativeArenaTest::Point *> *path() const {
+    return GetPointer<const flatbuffers::Vector<const NativeArenaTest::Point *> *>(VT_PATH);
+  }
+  flatbuffers::Vector<const NativeArenaTest::Point *> *mutable_path() {
+    return GetPointer<flatbuffers::Vector<const NativeArenaTest::Point *> *>(VT_PATH);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Leaf>> *leaves() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Leaf>> *>(VT_LEAVES);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Leaf>> *mutable_leaves() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Leaf>> *>(VT_LEAVES);
+  }
+  NativeArenaTest::Payload payload_type() const {
+    return static_cast<NativeArenaTest::Payload>(GetField<uint8_t>(VT_PAYLOAD_TYPE, 0));
+  }
+  bool mutate_payload_type(NativeArenaTest::Payload _payload_type) {
+    return SetField<uint8_t>(VT_PAYLOAD_TYPE, static_cast<uint8_t>(_payload_type), 0);
+  }
+  const void *payload() const {
+    return GetPointer<const void *>(VT_PAYLOAD);
+  }
+  template<typename T> const T *payload_as() const;
+  const NativeArenaTest::Leaf *payload_as_Leaf() const {
+    return payload_type() == NativeArenaTest::Payload_Leaf ? static_cast<const NativeArenaTest::Leaf *>(payload()) : nullptr;
+  }
+  const NativeArenaTest::Node *payload_as_Node() const {
+    return payload_type() == NativeArenaTest::Payload_Node ? static_cast<const NativeArenaTest::Node *>(payload()) : nullptr;
+  }
+  void *mutable_payload() {
+    return GetPointer<void *>(VT_PAYLOAD);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Node>> *children() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Node>> *>(VT_CHILDREN);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Node>> *mutable_children() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Node>> *>(VT_CHILDREN);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyField<int8_t>(verifier, VT_KIND) &&
+           VerifyOffset(verifier, VT_TAGS) &&
+           verifier.VerifyVector(tags()) &&
+           verifier.VerifyVectorOfStrings(tags()) &&
+           VerifyOffset(verifier, VT_FLAGS) &&
+           verifier.VerifyVector(flags()) &&
+           VerifyOffset(verifier, VT_KINDS) &&
+           verifier.VerifyVector(kinds()) &&
+           VerifyField<NativeArenaTest::Point>(verifier, VT_POSITION) &&
+           VerifyOffset(verifier, VT_PATH) &&
+           verifier.VerifyVector(path()) &&
+           VerifyOffset(verifier, VT_LEAVES) &&
+           verifier.VerifyVector(leaves()) &&
+           verifier.VerifyVectorOfTables(leaves()) &&
+           VerifyField<uint8_t>(verifier, VT_PAYLOAD_TYPE) &&
+           VerifyOffset(verifier, VT_PAYLOAD) &&
+           VerifyPayload(verifier, payload(), payload_type()) &&
+           VerifyOffset(verifier, VT_CHILDREN) &&
+           verifier.VerifyVector(children()) &&
+           verifier.VerifyVectorOfTables(children()) &&
+           verifier.EndTable();
+  }
+  NodeT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(NodeT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  NodeT *UnPack(flatbuffers::NativeArena &_arena, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(flatbuffers::NativeArena &_arena, NodeT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<Node> Pack(flatbuffers::FlatBufferBuilder &_fbb, const NodeT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+template<> inline const NativeArenaTest::Leaf *Node::payload_as<NativeArenaTest::Leaf>() const {
+  return payload_as_Leaf();
+}
+
+template<> inline const NativeArenaTest::Node *Node::payload_as<NativeArenaTest::Node>() const {
+  return payload_as_Node();
+}
+
+struct NodeBuilder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(Node::VT_NAME, name);
+  }
+  void add_kind(NativeArenaTest::Kind kind) {
+    fbb_.AddElement<int8_t>(Node::VT_KIND, static_cast<int8_t>(kind), 0);
+  }
+  void add_tags(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> tags) {
+    fbb_.AddOffset(Node::VT_TAGS, tags);
+  }
+  void add_flags(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> flags) {
+    fbb_.AddOffset(Node::VT_FLAGS, flags);
+  }
+  void add_kinds(flatbuffers::Offset<flatbuffers::Vector<int8_t>> kinds) {
+    fbb_.AddOffset(Node::VT_KINDS, kinds);
+  }
+  void add_position(const NativeArenaTest::Point *position) {
+    fbb_.AddStruct(Node::VT_POSITION, position);
+  }
+  void add_path(flatbuffers::Offset<flatbuffers::Vector<const NativeArenaTest::Point *>> path) {
+    fbb_.AddOffset(Node::VT_PATH, path);
+  }
+  void add_leaves(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Leaf>>> leaves) {
+    fbb_.AddOffset(Node::VT_LEAVES, leaves);
+  }
+  void add_payload_type(NativeArenaTest::Payload payload_type) {
+    fbb_.AddElement<uint8_t>(Node::VT_PAYLOAD_TYPE, static_cast<uint8_t>(payload_type), 0);
+  }
+  void add_payload(flatbuffers::Offset<void> payload) {
+    fbb_.AddOffset(Node::VT_PAYLOAD, payload);
+  }
+  void add_children(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Node>>> children) {
+    fbb_.AddOffset(Node::VT_CHILDREN, children);
+  }
+  explicit NodeBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  NodeBuilder &operator=(const NodeBuilder &);
+  flatbuffers::Offset<Node> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Node>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Node> CreateNode(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    NativeArenaTest::Kind kind = NativeArenaTest::Kind_Leaf,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> tags = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> flags = 0,
+    flatbuffers::Offset<flatbuffers::Vector<int8_t>> kinds = 0,
+    const NativeArenaTest::Point *position = 0,
+    flatbuffers::Offset<flatbuffers::Vector<const NativeArenaTest::Point *>> path = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Leaf>>> leaves = 0,
+    NativeArenaTest::Payload payload_type = NativeArenaTest::Payload_NONE,
+    flatbuffers::Offset<void> payload = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<NativeArenaTest::Node>>> children = 0) {
+  NodeBuilder builder_(_fbb);
+  builder_.add_children(children);
+  builder_.add_payload(payload);
+  builder_.add_leaves(leaves);
+  builder_.add_path(path);
+  builder_.add_position(position);
+  builder_.add_kinds(kinds);
+  builder_.add_flags(flags);
+  builder_.add_tags(tags);
+  builder_.add_name(name);
+  builder_.add_payload_type(payload_type);
+  builder_.add_kind(kind);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Node> CreateNodeDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *name = nullptr,
+    NativeArenaTest::Kind kind = NativeArenaTest::Kind_Leaf,
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *tags = nullptr,
+    const std::vector<uint8_t> *flags = nullptr,
+    const std::vector<int8_t> *kinds = nullptr,
+    const NativeArenaTest::Point *position = 0,
+    const std::vector<NativeArenaTest::Point> *path = nullptr,
+    const std::vector<flatbuffers::Offset<NativeArenaTest::Leaf>> *leaves = nullptr,
+    NativeArenaTest::Payload payload_type = NativeArenaTest::Payload_NONE,
+    flatbuffers::Offset<void> payload = 0,
+    const std::vector<flatbuffers::Offset<NativeArenaTest::Node>> *children = nullptr) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  auto tags__ = tags ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*tags) : 0;
+  auto flags__ = flags ? _fbb.CreateVector<uint8_t>(*flags) : 0;
+  auto kinds__ = kinds ? _fbb.CreateVector<int8_t>(*kinds) : 0;
+  auto path__ = path ? _fbb.CreateVectorOfStructs<NativeArenaTest::Point>(*path) : 0;
+  auto leaves__ = leaves ? _fbb.CreateVector<flatbuffers::Offset<NativeArenaTest::Leaf>>(*leaves) : 0;
+  auto children__ = children ? _fbb.CreateVector<flatbuffers::Offset<NativeArenaTest::Node>>(*children) : 0;
+  return NativeArenaTest::CreateNode(
+      _fbb,
+      name__,
+      kind,
+      tags__,
+      flags__,
+      kinds__,
+      position,
+      path__,
+      leaves__,
+      payload_type,
+      payload,
+      children__);
+}
+
+flatbuffers::Offset<Node> CreateNode(flatbuffers::FlatBufferBuilder &_fbb, const NodeT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+inline LeafT *Leaf::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new LeafT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void Leaf::UnPackTo(LeafT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = name(); if (_e) { _o->name.assign(_e->c_str(), _e->size()); } else { _o->name.clear(); } };
+  { auto _e = values(); if (_e) { flatbuffers::UnPackVector(_e, &_o->values); } else { _o->values.clear(); } };
+}
+
+inline LeafT *Leaf::UnPack(flatbuffers::NativeArena &_arena, const flatbuffers::resolver_function_t *_resolver) const {
+  flatbuffers::NativeArena::Scope _scope(_arena);
+  return UnPack(_resolver);
+}
+
+inline void Leaf::UnPackTo(flatbuffers::NativeArena &_arena, LeafT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  flatbuffers::NativeArena::Scope _scope(_arena);
+  UnPackTo(_o, _resolver);
+}
+
+inline flatbuffers::Offset<Leaf> Leaf::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LeafT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateLeaf(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<Leaf> CreateLeaf(flatbuffers::FlatBufferBuilder &_fbb, const LeafT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const LeafT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _name = _o->name.empty() ? 0 : _fbb.CreateString(_o->name);
+  auto _values = _o->values.size() ? _fbb.CreateVector(_o->values) : 0;
+  return NativeArenaTest::CreateLeaf(
+      _fbb,
+      _name,
+      _values);
+}
+
+inline size_t LeafT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(2, 16);
+  _size += flatbuffers::FlatBufferBuilder::StringSizeBound(name.length());
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(values.size(), 4, 4);
+  return _size;
+}
+
+inline NodeT *Node::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = new NodeT();
+  UnPackTo(_o, _resolver);
+  return _o;
+}
+
+inline void Node::UnPackTo(NodeT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = name(); if (_e) { _o->name.assign(_e->c_str(), _e->size()); } else { _o->name.clear(); } };
+  { auto _e = kind(); _o->kind = _e; };
+  { auto _e = tags(); if (_e) { { _o->tags.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->tags[_i].assign(_e->Get(_i)->c_str(), _e->Get(_i)->size()); } } } else { _o->tags.clear(); } };
+  { auto _e = flags(); if (_e) { { _o->flags.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->flags[_i] = _e->Get(_i) != 0; } } } else { _o->flags.clear(); } };
+  { auto _e = kinds(); if (_e) { flatbuffers::UnPackVector(_e, &_o->kinds); } else { _o->kinds.clear(); } };
+  { auto _e = position(); if (_e) { if (_o->position) *_o->position = *_e; else _o->position = flatbuffers::unique_ptr<NativeArenaTest::Point>(new NativeArenaTest::Point(*_e)); } else { _o->position.reset(); } };
+  { auto _e = path(); if (_e) { flatbuffers::UnPackVector(_e, &_o->path); } else { _o->path.clear(); } };
+  { auto _e = leaves(); if (_e) { { _o->leaves.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if (_o->leaves[_i]) _e->Get(_i)->UnPackTo(_o->leaves[_i].get(), _resolver); else _o->leaves[_i] = flatbuffers::unique_ptr<NativeArenaTest::LeafT>(_e->Get(_i)->UnPack(_resolver)); } } } else { _o->leaves.clear(); } };
+  { auto _e = payload_type(); if (_o->payload.type != _e) _o->payload.Reset(); _o->payload.type = _e; };
+  { auto _e = payload(); if (_e) { _o->payload.UnPackTo(_e, _resolver); } else { _o->payload.Reset(); } };
+  { auto _e = children(); if (_e) { { _o->children.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if (_o->children[_i]) _e->Get(_i)->UnPackTo(_o->children[_i].get(), _resolver); else _o->children[_i] = flatbuffers::unique_ptr<NativeArenaTest::NodeT>(_e->Get(_i)->UnPack(_resolver)); } } } else { _o->children.clear(); } };
+}
+
+inline NodeT *Node::UnPack(flatbuffers::NativeArena &_arena, const flatbuffers::resolver_function_t *_resolver) const {
+  flatbuffers::NativeArena::Scope _scope(_arena);
+  return UnPack(_resolver);
+}
+
+inline void Node::UnPackTo(flatbuffers::NativeArena &_arena, NodeT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  flatbuffers::NativeArena::Scope _scope(_arena);
+  UnPackTo(_o, _resolver);
+}
+
+inline flatbuffers::Offset<Node> Node::Pack(flatbuffers::FlatBufferBuilder &_fbb, const NodeT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateNode(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<Node> CreateNode(flatbuffers::FlatBufferBuilder &_fbb, const NodeT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const NodeT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _name = _o->name.empty() ? 0 : _fbb.CreateString(_o->name);
+  auto _kind = _o->kind;
+  auto _tags = _o->tags.size() ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>> (_o->tags.size(), [](size_t i, _VectorArgs *__va) { return __va->__fbb->CreateString(__va->__o->tags[i]); }, &_va ) : 0;
+  auto _flags = _o->flags.size() ? _fbb.CreateVector<uint8_t>(_o->flags.size(), [](size_t i, _VectorArgs *__va) { return static_cast<uint8_t>(__va->__o->flags[i]); }, &_va) : 0;
+  auto _kinds = _o->kinds.size() ? _fbb.CreateVectorScalarCast<int8_t>(flatbuffers::data(_o->kinds), _o->kinds.size()) : 0;
+  auto _position = _o->position ? _o->position.get() : 0;
+  auto _path = _o->path.size() ? _fbb.CreateVectorOfStructs(_o->path) : 0;
+  auto _leaves = _o->leaves.size() ? _fbb.CreateVector<flatbuffers::Offset<NativeArenaTest::Leaf>> (_o->leaves.size(), [](size_t i, _VectorArgs *__va) { return CreateLeaf(*__va->__fbb, __va->__o->leaves[i].get(), __va->__rehasher); }, &_va ) : 0;
+  auto _payload_type = _o->payload.type;
+  auto _payload = _o->payload.Pack(_fbb);
+  auto _children = _o->children.size() ? _fbb.CreateVector<flatbuffers::Offset<NativeArenaTest::Node>> (_o->children.size(), [](size_t i, _VectorArgs *__va) { return CreateNode(*__va->__fbb, __va->__o->children[i].get(), __va->__rehasher); }, &_va ) : 0;
+  return NativeArenaTest::CreateNode(
+      _fbb,
+      _name,
+      _kind,
+      _tags,
+      _flags,
+      _kinds,
+      _position,
+      _path,
+      _leaves,
+      _payload_type,
+      _payload,
+      _children);
+}
+
+inline size_t NodeT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(11, 80);
+  _size += flatbuffers::FlatBufferBuilder::StringSizeBound(name.length());
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(tags.size(), 4, 4);
+  for (size_t _i = 0; _i < tags.size(); _i++) {
+    _size += flatbuffers::FlatBufferBuilder::StringSizeBound(tags[_i].length());
+  }
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(flags.size(), 1, 1);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(kinds.size(), 1, 1);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(path.size(), 8, 4);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(leaves.size(), 4, 4);
+  for (size_t _i = 0; _i < leaves.size(); _i++) {
+    _size += leaves[_i].get()->SerializedSizeBound();
+  }
+  _size += payload.SerializedSizeBound();
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(children.size(), 4, 4);
+  for (size_t _i = 0; _i < children.size(); _i++) {
+    _size += children[_i].get()->SerializedSizeBound();
+  }
+  return _size;
+}
+
+inline bool VerifyPayload(flatbuffers::Verifier &verifier, const void *obj, Payload type) {
+  switch (type) {
+    case Payload_NONE: {
+      return true;
+    }
+    case Payload_Leaf: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::Leaf *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case Payload_Node: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::Node *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    default: return false;
+  }
+}
+
+inline bool VerifyPayloadVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types) {
+  if (!values || !types) return !values && !types;
+  if (values->size() != types->size()) return false;
+  for (flatbuffers::uoffset_t i = 0; i < values->size(); ++i) {
+    if (!VerifyPayload(
+        verifier,  values->Get(i), types->GetEnum<Payload>(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline void *PayloadUnion::UnPack(const void *obj, Payload type, const flatbuffers::resolver_function_t *resolver) {
+  switch (type) {
+    case Payload_Leaf: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::Leaf *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    case Payload_Node: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::Node *>(obj);
+      return ptr->UnPack(resolver);
+    }
+    default: return nullptr;
+  }
+}
+
+inline void PayloadUnion::UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver) {
+  switch (type) {
+    case Payload_Leaf: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::Leaf *>(obj);
+      auto _o = reinterpret_cast<NativeArenaTest::LeafT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case Payload_Node: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::Node *>(obj);
+      auto _o = reinterpret_cast<NativeArenaTest::NodeT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
+inline flatbuffers::Offset<void> PayloadUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
+  switch (type) {
+    case Payload_Leaf: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::LeafT *>(value);
+      return CreateLeaf(_fbb, ptr, _rehasher).Union();
+    }
+    case Payload_Node: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::NodeT *>(value);
+      return CreateNode(_fbb, ptr, _rehasher).Union();
+    }
+    default: return 0;
+  }
+}
+
+inline size_t PayloadUnion::SerializedSizeBound() const {
+  switch (type) {
+    case Payload_Leaf: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::LeafT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    case Payload_Node: {
+      auto ptr = reinterpret_cast<const NativeArenaTest::NodeT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    default: return 0;
+  }
+}
+
+inline PayloadUnion::PayloadUnion(const PayloadUnion &u) FLATBUFFERS_NOEXCEPT : type(u.type), value(nullptr) {
+  switch (type) {
+    case Payload_Leaf: {
+      value = new NativeArenaTest::LeafT(*reinterpret_cast<NativeArenaTest::LeafT *>(u.value));
+      break;
+    }
+    case Payload_Node: {
+      FLATBUFFERS_ASSERT(false);  // NativeArenaTest::NodeT not copyable.
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+inline void PayloadUnion::Reset() {
+  switch (type) {
+    case Payload_Leaf: {
+      auto ptr = reinterpret_cast<NativeArenaTest::LeafT *>(value);
+      delete ptr;
+      break;
+    }
+    case Payload_Node: {
+      auto ptr = reinterpret_cast<NativeArenaTest::NodeT *>(value);
+      delete ptr;
+      break;
+    }
+    default: break;
+  }
+  value = nullptr;
+  type = Payload_NONE;
+}
+
+inline const flatbuffers::TypeTable *KindTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_CHAR, 0, 0 },
+    { flatbuffers::ET_CHAR, 0, 0 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    NativeArenaTest::KindTypeTable
+  };
+  static const char * const names[] = {
+    "Leaf",
+    "Branch"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_ENUM, 2, type_codes, type_refs, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *PayloadTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_SEQUENCE, 0, -1 },
+    { flatbuffers::ET_SEQUENCE, 0, 0 },
+    { flatbuffers::ET_SEQUENCE, 0, 1 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    NativeArenaTest::LeafTypeTable,
+    NativeArenaTest::NodeTypeTable
+  };
+  static const char * const names[] = {
+    "NONE",
+    "Leaf",
+    "Node"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_UNION, 3, type_codes, type_refs, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *PointTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_FLOAT, 0, -1 },
+    { flatbuffers::ET_FLOAT, 0, -1 }
+  };
+  static const int64_t values[] = { 0, 4, 8 };
+  static const char * const names[] = {
+    "x",
+    "y"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_STRUCT, 2, type_codes, nullptr, values, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *LeafTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_STRING, 0, -1 },
+    { flatbuffers::ET_INT, 1, -1 }
+  };
+  static const char * const names[] = {
+    "name",
+    "values"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *NodeTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_STRING, 0, -1 },
+    { flatbuffers::ET_CHAR, 0, 0 },
+    { flatbuffers::ET_STRING, 1, -1 },
+    { flatbuffers::ET_BOOL, 1, -1 },
+    { flatbuffers::ET_CHAR, 1, 0 },
+    { flatbuffers::ET_SEQUENCE, 0, 1 },
+    { flatbuffers::ET_SEQUENCE, 1, 1 },
+    { flatbuffers::ET_SEQUENCE, 1, 2 },
+    { flatbuffers::ET_UTYPE, 0, 3 },
+    { flatbuffers::ET_SEQUENCE, 0, 3 },
+    { flatbuffers::ET_SEQUENCE, 1, 4 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    NativeArenaTest::KindTypeTable,
+    NativeArenaTest::PointTypeTable,
+    NativeArenaTest::LeafTypeTable,
+    NativeArenaTest::PayloadTypeTable,
+    NativeArenaTest::NodeTypeTable
+  };
+  static const char * const names[] = {
+    "name",
+    "kind",
+    "tags",
+    "flags",
+    "kinds",
+    "position",
+    "path",
+    "leaves",
+    "payload_type",
+    "payload",
+    "children"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 11, type_codes, type_refs, nullptr, names
+  };
+  return &tt;
+}
+
+inline const NativeArenaTest::Node *GetNode(const void *buf) {
+  return flatbuffers::GetRoot<NativeArenaTest::Node>(buf);
+}
+
+inline const NativeArenaTest::Node *GetSizePrefixedNode(const void *buf) {
+  return flatbuffers::GetSizePrefixedRoot<NativeArenaTest::Node>(buf);
+}
+
+inline Node *GetMutableNode(void *buf) {
+  return flatbuffers::GetMutableRoot<Node>(buf);
+}
+
+inline bool VerifyNodeBuffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifyBuffer<NativeArenaTest::Node>(nullptr);
+}
+
+inline bool VerifySizePrefixedNodeBuffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifySizePrefixedBuffer<NativeArenaTest::Node>(nullptr);
+}
+
+inline void FinishNodeBuffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<NativeArenaTest::Node> root) {
+  fbb.Finish(root);
+}
+
+inline void FinishSizePrefixedNodeBuffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<NativeArenaTest::Node> root) {
+  fbb.FinishSizePrefixed(root);
+}
+
+inline flatbuffers::unique_ptr<NativeArenaTest::NodeT> UnPackNode(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return flatbuffers::unique_ptr<NativeArenaTest::NodeT>(GetNode(buf)->UnPack(res));
+}
+
+inline flatbuffers::unique_ptr<NativeArenaTest::NodeT> UnPackSizePrefixedNode(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return flatbuffers::unique_ptr<NativeArenaTest::NodeT>(GetSizePrefixedNode(buf)->UnPack(res));
+}
+
+inline NativeArenaTest::NodeT *UnPackNode(
+    const void *buf,
+    flatbuffers::NativeArena &arena,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return GetNode(buf)->UnPack(arena, res);
+}
+
+}  // namespace NativeArenaTest
+
+#endif  // FLATBUFFERS_GENERATED_NATIVEARENATEST_NATIVEARENATEST_H_
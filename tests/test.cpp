@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include <cmath>
+#include <thread>
+#include "flatbuffers/arena.h"
 #include "flatbuffers/flatbuffers.h"
 #include "flatbuffers/idl.h"
+#include "flatbuffers/json_printer.h"
 #include "flatbuffers/minireflect.h"
 #include "flatbuffers/registry.h"
 #include "flatbuffers/util.h"
@@ -39,6 +42,7 @@
 #endif
 
 #include "native_type_test_generated.h"
+#include "native_arena_test_generated.h"
 #include "test_assert.h"
 
 #include "flatbuffers/flexbuffers.h"
@@ -561,6 +565,106 @@ void ObjectFlatBuffersTest(uint8_t *flatbuf) {
   TEST_EQ(tests[1].b(), 40);
 }
 
+// Unpacking into an object that already holds a tree reuses its sub-objects,
+// strings and vectors, and resets what is absent from the new buffer.
+void UnPackToReuseTest(uint8_t *flatbuf) {
+  auto repack = [](const MonsterT &monster) {
+    flatbuffers::FlatBufferBuilder fbb;
+    fbb.Finish(CreateMonster(fbb, &monster), MonsterIdentifier());
+    return std::string(reinterpret_cast<const char *>(fbb.GetBufferPointer()),
+                       fbb.GetSize());
+  };
+  auto expected = repack(*UnPackMonster(flatbuf));
+
+  MonsterT monster;
+  GetMonster(flatbuf)->UnPackTo(&monster);
+  TEST_ASSERT(repack(monster) == expected);
+  auto pos = monster.pos.get();
+  auto fred = monster.test.value;
+  auto barney = monster.testarrayoftables[0].get();
+  auto strings = monster.testarrayofstring.data();
+  auto inventory = monster.inventory.data();
+
+  GetMonster(flatbuf)->UnPackTo(&monster);
+  TEST_ASSERT(repack(monster) == expected);
+  TEST_ASSERT(monster.pos.get() == pos);
+  TEST_ASSERT(monster.test.value == fred);
+  TEST_ASSERT(monster.testarrayoftables[0].get() == barney);
+  TEST_ASSERT(monster.testarrayofstring.data() == strings);
+  TEST_ASSERT(monster.inventory.data() == inventory);
+
+  // A monster with a different union type, and most fields absent.
+  flatbuffers::FlatBufferBuilder fbb;
+  auto name = fbb.CreateString("Sparse");
+  auto test = CreateTestSimpleTableWithEnum(fbb, Color_Green);
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_test_type(Any_TestSimpleTableWithEnum);
+  mb.add_test(test.Union());
+  FinishMonsterBuffer(fbb, mb.Finish());
+
+  GetMonster(fbb.GetBufferPointer())->UnPackTo(&monster);
+  TEST_ASSERT(repack(monster) ==
+              repack(*UnPackMonster(fbb.GetBufferPointer())));
+  TEST_EQ_STR(monster.name.c_str(), "Sparse");
+  TEST_ASSERT(monster.pos == nullptr);
+  TEST_EQ(monster.test.AsTestSimpleTableWithEnum()->color, Color_Green);
+  TEST_EQ(monster.testarrayoftables.size(), 0U);
+  TEST_EQ(monster.inventory.size(), 0U);
+}
+
+// Vectors of scalars, enums and structs are unpacked in bulk where the
+// native layout allows, and element by element otherwise.
+enum SizedEnum : uint16_t { SizedEnum_A = 1, SizedEnum_B = 0x8001 };
+enum IntEnum { IntEnum_A = 1, IntEnum_B = 0xFF };
+
+void UnPackVectorTest() {
+  flatbuffers::FlatBufferBuilder fbb;
+  SizedEnum sized[] = { SizedEnum_B, SizedEnum_A, SizedEnum_B };
+  IntEnum ints[] = { IntEnum_B, IntEnum_A };
+  Test tests[] = { Test(10, 20), Test(-30, -40) };
+  float floats[] = { 1.5f, -2.0f, 3.25f };
+  auto sized_vec = fbb.CreateVectorScalarCast<uint16_t>(sized, 3);
+  auto int_vec = fbb.CreateVectorScalarCast<uint8_t>(ints, 2);
+  auto test_vec = fbb.CreateVectorOfStructs(tests, 2);
+  auto float_vec = fbb.CreateVector(floats, 3);
+  fbb.Finish(sized_vec);
+  auto buf = fbb.GetBufferPointer();
+  auto get = [&](flatbuffers::uoffset_t offset) {
+    return buf + fbb.GetSize() - offset;
+  };
+  auto sized_buf = reinterpret_cast<const flatbuffers::Vector<uint16_t> *>(
+      get(sized_vec.o));
+  auto int_buf =
+      reinterpret_cast<const flatbuffers::Vector<uint8_t> *>(get(int_vec.o));
+  auto test_buf = reinterpret_cast<const flatbuffers::Vector<const Test *> *>(
+      get(test_vec.o));
+  auto float_buf =
+      reinterpret_cast<const flatbuffers::Vector<float> *>(get(float_vec.o));
+  TEST_EQ(sized_buf->Get(0), 0x8001);
+  TEST_EQ(int_buf->Get(0), 0xFF);
+
+  std::vector<SizedEnum> sized_out;
+  flatbuffers::UnPackVector(sized_buf, &sized_out);
+  TEST_EQ(sized_out.size(), 3);
+  TEST_EQ(sized_out[0], SizedEnum_B);
+  TEST_EQ(sized_out[1], SizedEnum_A);
+  std::vector<IntEnum> int_out(5);
+  flatbuffers::UnPackVector(int_buf, &int_out);
+  TEST_EQ(int_out.size(), 2);
+  TEST_EQ(int_out[0], IntEnum_B);
+  TEST_EQ(int_out[1], IntEnum_A);
+  std::vector<Test> test_out;
+  flatbuffers::UnPackVector(test_buf, &test_out);
+  TEST_EQ(test_out.size(), 2);
+  TEST_EQ(test_out[1].a(), -30);
+  TEST_EQ(test_out[1].b(), -40);
+  std::vector<float> float_out;
+  flatbuffers::UnPackVector(float_buf, &float_out);
+  TEST_EQ(float_out.size(), 3);
+  TEST_EQ(float_out[2], 3.25f);
+}
+
 // Prefix a FlatBuffer with a size field.
 void SizePrefixedTest() {
   // Create size prefixed buffer.
@@ -847,6 +951,228 @@ void ParseAndGenerateTextTest(bool binary) {
   TEST_EQ_STR(jsongen_utf8.c_str(), jsonfile_utf8.c_str());
 }
 
+void RegistryTest() {
+  std::string jsonfile;
+  TEST_EQ(flatbuffers::LoadFile(
+              (test_data_path + "monsterdata_test.golden").c_str(), false,
+              &jsonfile),
+          true);
+
+  // A binary schema needs no include directories.
+  flatbuffers::Registry registry;
+  registry.Register(MonsterIdentifier(),
+                    (test_data_path + "monster_test.bfbs").c_str());
+  auto buf = registry.TextToFlatBuffer(jsonfile.c_str(), MonsterIdentifier());
+  TEST_NOTNULL(buf.data());
+  AccessFlatBufferTest(buf.data(), buf.size(), false);
+
+  // The schema is loaded once, and shared by concurrent calls, which may all
+  // start out loading it.
+  registry.Invalidate(MonsterIdentifier());
+  std::vector<std::thread> threads;
+  std::vector<int> ok(4, 0);
+  for (size_t t = 0; t < ok.size(); t++) {
+    threads.push_back(std::thread([&, t]() {
+      for (int i = 0; i < 20; i++) {
+        std::string text;
+        if (!registry.FlatBufferToText(buf.data(), buf.size(), &text) ||
+            text != jsonfile) {
+          return;
+        }
+        auto rebuilt =
+            registry.TextToFlatBuffer(jsonfile.c_str(), MonsterIdentifier());
+        if (rebuilt.size() != buf.size()) return;
+      }
+      ok[t] = 1;
+    }));
+  }
+  for (auto it = threads.begin(); it != threads.end(); ++it) it->join();
+  TEST_EQ(std::count(ok.begin(), ok.end(), 1), 4);
+
+  // Types declared by one call don't exist in the next.
+  const char *extra = "table Extra { a:int; } { name: \"x\" }";
+  for (int i = 0; i < 2; i++) {
+    TEST_NOTNULL(registry.TextToFlatBuffer(extra, MonsterIdentifier()).data());
+  }
+  TEST_NOTNULL(
+      registry
+          .TextToFlatBuffer("table Extra { a:int; } root_type Extra; { a: 1 }",
+                            MonsterIdentifier())
+          .data());
+  TEST_EQ(registry.TextToFlatBuffer("{ a: 1 }", MonsterIdentifier()).data() ==
+              nullptr,
+          true);
+  TEST_NOTNULL(registry.TextToFlatBuffer(extra, MonsterIdentifier()).data());
+
+  // A schema that doesn't load only fails when used or reloaded.
+  registry.Register("NONE", "does_not_exist.fbs");
+  TEST_EQ(registry.Reload("NONE"), false);
+  TEST_EQ_STR(registry.GetLastError().c_str(),
+              "could not load schema: does_not_exist.fbs");
+  // Errors of other threads don't replace it.
+  std::thread([&]() { registry.Reload("NONE2"); }).join();
+  TEST_EQ_STR(registry.GetLastError().c_str(),
+              "could not load schema: does_not_exist.fbs");
+  TEST_EQ(registry.Reload("none"), false);
+  TEST_EQ(registry.Reload(MonsterIdentifier()), true);
+
+  // Invalidated schemas are loaded again on next use, with new options.
+  flatbuffers::IDLOptions opts;
+  opts.strict_json = true;
+  registry.SetOptions(opts);
+  std::string text;
+  TEST_EQ(registry.FlatBufferToText(buf.data(), buf.size(), &text), true);
+  TEST_EQ(text.find("\"name\": \"MyMonster\"") != std::string::npos, true);
+  registry.Invalidate(MonsterIdentifier());
+  TEST_EQ(registry.FlatBufferToText(buf.data(), buf.size(), &text), true);
+}
+
+// The printer compiled from a binary schema must match GenerateText.
+void JsonPrinterTest() {
+  std::string schemafile;
+  std::string jsonfile;
+  TEST_EQ(flatbuffers::LoadFile((test_data_path + "monster_test.fbs").c_str(),
+                                false, &schemafile),
+          true);
+  TEST_EQ(flatbuffers::LoadFile(
+              (test_data_path + "monsterdata_test.golden").c_str(), false,
+              &jsonfile),
+          true);
+  auto include_test_path =
+      flatbuffers::ConCatPathFileName(test_data_path, "include_test");
+  const char *include_directories[] = { test_data_path.c_str(),
+                                        include_test_path.c_str(), nullptr };
+  flatbuffers::Parser parser;
+  parser.opts.binary_schema_builtins = true;
+  TEST_EQ(parser.Parse(schemafile.c_str(), include_directories), true);
+  parser.Serialize();
+  std::vector<uint8_t> bfbs(
+      parser.builder_.GetBufferPointer(),
+      parser.builder_.GetBufferPointer() + parser.builder_.GetSize());
+
+  // Nested flatbuffers, flexbuffers, bit_flags and unions on top of the
+  // golden data.
+  std::vector<std::string> buffers;
+  const char *jsons[] = {
+    jsonfile.c_str(),
+    "{ name: \"a\", color: \"Red Blue\", flex: { a: [1, 2.5, \"x\"] },"
+    "  testnestedflatbuffer: { name: \"b\", hp: 5 },"
+    "  test_type: Monster, test: { name: \"c\" },"
+    "  testarrayofstring: [], testf: 0.1, testf2: 1e-30 }",
+  };
+  for (size_t i = 0; i < sizeof(jsons) / sizeof(jsons[0]); i++) {
+    TEST_EQ(parser.Parse(jsons[i], include_directories), true);
+    buffers.push_back(std::string(
+        reinterpret_cast<const char *>(parser.builder_.GetBufferPointer()),
+        parser.builder_.GetSize()));
+  }
+
+  for (int variant = 0; variant < 4; variant++) {
+    flatbuffers::IDLOptions opts;
+    if (variant == 1) {
+      opts.strict_json = true;
+      opts.indent_step = -1;
+    } else if (variant == 2) {
+      opts.output_default_scalars_in_json = true;
+      opts.output_enum_identifiers = false;
+    } else if (variant == 3) {
+      opts.protobuf_ascii_alike = true;
+      opts.indent_step = 4;
+    }
+    parser.opts = opts;
+    flatbuffers::JsonPrinter printer;
+    TEST_EQ(printer.Compile(flatbuffers::vector_data(bfbs), bfbs.size(), opts),
+            true);
+    for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+      std::string expected;
+      std::string text;
+      TEST_EQ(GenerateText(parser, it->c_str(), &expected), true);
+      TEST_EQ(printer.Print(it->c_str(), &text), true);
+      TEST_EQ_STR(text.c_str(), expected.c_str());
+    }
+  }
+
+  // Fixed length arrays in structs.
+  std::string arrays_schema;
+  std::string arrays_json;
+  TEST_EQ(flatbuffers::LoadFile((test_data_path + "arrays_test.bfbs").c_str(),
+                                true, &arrays_schema),
+          true);
+  TEST_EQ(flatbuffers::LoadFile((test_data_path + "arrays_test.golden").c_str(),
+                                false, &arrays_json),
+          true);
+  flatbuffers::Parser arrays_parser;
+  auto arrays_bfbs = reinterpret_cast<const uint8_t *>(arrays_schema.c_str());
+  TEST_EQ(arrays_parser.Deserialize(arrays_bfbs, arrays_schema.size()), true);
+  TEST_EQ(arrays_parser.Parse(arrays_json.c_str()), true);
+  flatbuffers::JsonPrinter arrays_printer;
+  TEST_EQ(arrays_printer.Compile(arrays_bfbs, arrays_schema.size()), true);
+  std::string expected;
+  std::string text;
+  TEST_EQ(GenerateText(arrays_parser, arrays_parser.builder_.GetBufferPointer(),
+                       &expected),
+          true);
+  TEST_EQ(arrays_printer.Print(arrays_parser.builder_.GetBufferPointer(),
+                               &text),
+          true);
+  TEST_EQ_STR(text.c_str(), expected.c_str());
+
+  // Vectors of unions only fail the buffers that have them.
+  std::string union_schema;
+  TEST_EQ(flatbuffers::LoadFile(
+              (test_data_path + "union_vector/union_vector.fbs").c_str(),
+              false, &union_schema),
+          true);
+  flatbuffers::IDLOptions union_opts;
+  union_opts.lang_to_generate |= flatbuffers::IDLOptions::kBinary;
+  flatbuffers::Parser union_parser(union_opts);
+  TEST_EQ(union_parser.Parse(union_schema.c_str()), true);
+  union_parser.Serialize();
+  std::vector<uint8_t> union_bfbs(
+      union_parser.builder_.GetBufferPointer(),
+      union_parser.builder_.GetBufferPointer() +
+          union_parser.builder_.GetSize());
+  flatbuffers::JsonPrinter union_printer;
+  TEST_EQ(union_printer.Compile(flatbuffers::vector_data(union_bfbs),
+                                union_bfbs.size()),
+          true);
+  TEST_EQ(union_parser.Parse("{ main_character_type: Rapunzel,"
+                             "  main_character: { hair_length: 6 } }"),
+          true);
+  expected.clear();
+  text.clear();
+  TEST_EQ(GenerateText(union_parser, union_parser.builder_.GetBufferPointer(),
+                       &expected),
+          true);
+  TEST_EQ(
+      union_printer.Print(union_parser.builder_.GetBufferPointer(), &text),
+      true);
+  TEST_EQ_STR(text.c_str(), expected.c_str());
+  TEST_EQ(union_parser.Parse("{ characters_type: [Rapunzel],"
+                             "  characters: [{ hair_length: 6 }] }"),
+          true);
+  text.clear();
+  TEST_EQ(
+      union_printer.Print(union_parser.builder_.GetBufferPointer(), &text),
+      false);
+
+  // Schemas that can't be printed from.
+  flatbuffers::JsonPrinter bad_printer;
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+    TEST_EQ(bad_printer.Compile(flatbuffers::vector_data(bfbs), 16), false);
+    TEST_EQ_STR(bad_printer.GetError().c_str(), "invalid binary schema");
+  #endif
+  // clang-format on
+  flatbuffers::Parser no_root_parser;
+  TEST_EQ(no_root_parser.Parse("table T { a:int; }"), true);
+  no_root_parser.Serialize();
+  TEST_EQ(bad_printer.Compile(no_root_parser.builder_.GetBufferPointer(),
+                              no_root_parser.builder_.GetSize()),
+          false);
+  TEST_EQ(bad_printer.IsCompiled(), false);
+}
+
 void ReflectionTest(uint8_t *flatbuf, size_t length) {
   // Load a binary schema.
   std::string bfbsfile;
@@ -1027,6 +1353,167 @@ void ReflectionTest(uint8_t *flatbuf, size_t length) {
           true);
 }
 
+// Makes the same changes as ResizeBatchTest below, one call at a time.
+void ResizeSequentially(const reflection::Schema &schema,
+                        std::vector<uint8_t> *buf) {
+  SetString(schema, "a much longer name than before",
+            GetMonster(buf->data())->name(), buf);
+  SetString(schema, "Frederick",
+            GetMonster(buf->data())->testarrayoftables()->Get(1)->name(), buf);
+  SetString(schema, "robert",
+            GetMonster(buf->data())->testarrayofstring()->Get(0), buf);
+  flatbuffers::ResizeVector<uint8_t>(
+      schema, 110, 50, GetMonster(buf->data())->inventory(), buf);
+}
+
+void ResizeBatchTest(uint8_t *flatbuf, size_t length) {
+  std::string bfbsfile;
+  TEST_EQ(flatbuffers::LoadFile((test_data_path + "monster_test.bfbs").c_str(),
+                                true, &bfbsfile),
+          true);
+  auto &schema = *reflection::GetSchema(bfbsfile.c_str());
+
+  std::vector<uint8_t> sequential(flatbuf, flatbuf + length);
+  ResizeSequentially(schema, &sequential);
+
+  // All pointers stay valid until the batch is applied.
+  std::vector<uint8_t> buf(flatbuf, flatbuf + length);
+  auto monster = GetMonster(buf.data());
+  flatbuffers::ResizeBatch batch(schema, &buf);
+  TEST_EQ(batch.empty(), true);
+  batch.SetString(monster->name(), "a much longer name than before");
+  batch.SetString(monster->testarrayoftables()->Get(1)->name(), "Frederick");
+  batch.SetString(monster->testarrayofstring()->Get(0), "robert");
+  batch.ResizeVector<uint8_t>(monster->inventory(), 110, 50);
+  TEST_EQ(batch.empty(), false);
+  batch.Apply();
+  TEST_EQ(batch.empty(), true);
+
+  // The batch must produce exactly the same buffer as separate resizes.
+  TEST_EQ(buf.size(), sequential.size());
+  TEST_EQ(memcmp(buf.data(), sequential.data(), buf.size()), 0);
+  flatbuffers::Verifier verifier(buf.data(), buf.size());
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  monster = GetMonster(buf.data());
+  TEST_EQ_STR(monster->name()->c_str(), "a much longer name than before");
+  TEST_EQ_STR(monster->testarrayoftables()->Get(0)->name()->c_str(), "Barney");
+  TEST_EQ_STR(monster->testarrayoftables()->Get(1)->name()->c_str(),
+              "Frederick");
+  TEST_EQ_STR(monster->testarrayoftables()->Get(2)->name()->c_str(), "Wilma");
+  // "bob" is shared by two elements.
+  TEST_EQ_STR(monster->testarrayofstring()->Get(0)->c_str(), "robert");
+  TEST_EQ_STR(monster->testarrayofstring()->Get(2)->c_str(), "robert");
+  TEST_EQ_STR(monster->testarrayofstring()->Get(3)->c_str(), "fred");
+  TEST_EQ(monster->inventory()->size(), 110);
+  TEST_EQ(monster->inventory()->Get(9), 9);
+  TEST_EQ(monster->inventory()->Get(109), 50);
+
+  // Shrink strings and vectors in the same batch as growing others.
+  auto size_before = buf.size();
+  batch.SetString(monster->name(), "M");
+  batch.SetString(monster->testarrayofstring()->Get(3), "");
+  batch.SetString(monster->testarrayoftables()->Get(0)->name(),
+                  "Barney Rubble");
+  batch.ResizeVector<uint8_t>(monster->inventory(), 2, 0);
+  batch.ResizeVector<flatbuffers::Offset<flatbuffers::String>>(
+      monster->testarrayofstring2(), 0, 0);
+  batch.Apply();
+  TEST_EQ(buf.size() < size_before, true);
+  flatbuffers::Verifier shrunk_verifier(buf.data(), buf.size());
+  TEST_EQ(VerifyMonsterBuffer(shrunk_verifier), true);
+  TEST_EQ(flatbuffers::Verify(schema, *schema.root_table(), buf.data(),
+                              buf.size()),
+          true);
+  monster = GetMonster(buf.data());
+  TEST_EQ_STR(monster->name()->c_str(), "M");
+  TEST_EQ_STR(monster->testarrayofstring()->Get(0)->c_str(), "robert");
+  TEST_EQ_STR(monster->testarrayofstring()->Get(1)->c_str(), "");
+  TEST_EQ_STR(monster->testarrayoftables()->Get(0)->name()->c_str(),
+              "Barney Rubble");
+  TEST_EQ_STR(monster->testarrayoftables()->Get(1)->name()->c_str(),
+              "Frederick");
+  TEST_EQ(monster->inventory()->size(), 2);
+  TEST_EQ(monster->inventory()->Get(1), 1);
+  TEST_EQ(monster->testarrayofstring2()->size(), 0);
+  TEST_EQ(monster->hp(), 80);
+  TEST_EQ(monster->pos()->z(), 3);
+
+  // New data is added for tables wherever they move to.
+  flatbuffers::FlatBufferBuilder stringfbb;
+  stringfbb.Finish(stringfbb.CreateString("Wilma Flintstone"));
+  auto &name_field = *schema.root_table()->fields()->LookupByKey("name");
+  auto &enemy_field = *schema.root_table()->fields()->LookupByKey("enemy");
+  auto wilma = reinterpret_cast<const flatbuffers::Table *>(
+      monster->testarrayoftables()->Get(2));
+  auto wilma_offset = reinterpret_cast<const uint8_t *>(wilma) - buf.data();
+  batch.SetString(monster->name(), "a long name again");
+  batch.SetString(monster->testarrayoftables()->Get(0)->name(), "B");
+  batch.SetString(monster->testarrayoftables()->Get(1)->name(), "Fred");
+  // Stored before the table, so moves it.
+  batch.SetString(monster->testarrayofstring()->Get(0), "Robert Rubble");
+  TEST_EQ(batch.AddFlatBuffer(wilma, name_field, stringfbb.GetBufferPointer(),
+                              stringfbb.GetSize()),
+          true);
+  TEST_EQ(batch.AddFlatBuffer(wilma, enemy_field, stringfbb.GetBufferPointer(),
+                              stringfbb.GetSize()),
+          false);
+  TEST_EQ(batch.empty(), false);
+  batch.Apply();
+  TEST_EQ(batch.empty(), true);
+  flatbuffers::Verifier added_verifier(buf.data(), buf.size());
+  TEST_EQ(VerifyMonsterBuffer(added_verifier), true);
+  monster = GetMonster(buf.data());
+  TEST_EQ_STR(monster->name()->c_str(), "a long name again");
+  TEST_EQ_STR(monster->testarrayoftables()->Get(0)->name()->c_str(), "B");
+  TEST_EQ_STR(monster->testarrayoftables()->Get(1)->name()->c_str(), "Fred");
+  TEST_EQ_STR(monster->testarrayoftables()->Get(2)->name()->c_str(),
+              "Wilma Flintstone");
+  TEST_EQ_STR(monster->testarrayofstring()->Get(0)->c_str(), "Robert Rubble");
+  TEST_EQ(reinterpret_cast<const uint8_t *>(monster->testarrayoftables()->Get(
+              2)) - buf.data() != wilma_offset,
+          true);
+}
+
+void TableCopierTest(uint8_t *flatbuf) {
+  std::string bfbsfile;
+  TEST_EQ(flatbuffers::LoadFile((test_data_path + "monster_test.bfbs").c_str(),
+                                true, &bfbsfile),
+          true);
+  auto &schema = *reflection::GetSchema(bfbsfile.c_str());
+  auto &root_table = *schema.root_table();
+  auto &root = *flatbuffers::GetAnyRoot(flatbuf);
+
+  for (int pooling = 0; pooling < 2; pooling++) {
+    flatbuffers::FlatBufferBuilder expected;
+    expected.Finish(
+        flatbuffers::CopyTable(expected, schema, root_table, root, pooling != 0),
+        MonsterIdentifier());
+    // The second copy reuses the plans made for the first.
+    flatbuffers::TableCopier copier(schema, pooling != 0);
+    for (int i = 0; i < 2; i++) {
+      flatbuffers::FlatBufferBuilder fbb;
+      fbb.Finish(copier.CopyTable(fbb, root_table, root), MonsterIdentifier());
+      TEST_EQ(fbb.GetSize(), expected.GetSize());
+      TEST_EQ(memcmp(fbb.GetBufferPointer(), expected.GetBufferPointer(),
+                     fbb.GetSize()),
+              0);
+      AccessFlatBufferTest(fbb.GetBufferPointer(), fbb.GetSize(),
+                           pooling != 0);
+    }
+
+    // Re-root a subtree.
+    flatbuffers::FlatBufferBuilder fbb;
+    auto sub = GetMonster(flatbuf)->testarrayoftables()->Get(2);
+    fbb.Finish(copier.CopyTable(
+                   fbb, root_table,
+                   *reinterpret_cast<const flatbuffers::Table *>(sub)),
+               MonsterIdentifier());
+    flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+    TEST_EQ(VerifyMonsterBuffer(verifier), true);
+    TEST_EQ_STR(GetMonster(fbb.GetBufferPointer())->name()->c_str(), "Wilma");
+  }
+}
+
 void MiniReflectFlatBuffersTest(uint8_t *flatbuf) {
   auto s = flatbuffers::FlatBufferToString(flatbuf, Monster::MiniReflectTypeTable());
   TEST_EQ_STR(
@@ -1779,6 +2266,169 @@ void IntegerBoundaryTest() {
           18446744073709551615ULL);
 }
 
+void JsonStreamTest() {
+  flatbuffers::Parser parser;
+  TEST_EQ(parser.Parse("table T { a:int; s:string; } root_type T;"), true);
+  std::string stream =
+      "{ a: 1, s: \"one\" }\n"
+      "\n"
+      "  \t\r\n"
+      "{ a: 2 }\r\n"
+      "{ a: 3, s: \"three\" }";  // No newline after the last line.
+  // Hand out at most 5 bytes at a time so lines span several reads.
+  size_t read_pos = 0;
+  auto reader = [&](char *buf, size_t size) {
+    size = (std::min)((std::min)(size, static_cast<size_t>(5)),
+                      stream.size() - read_pos);
+    memcpy(buf, stream.c_str() + read_pos, size);
+    read_pos += size;
+    return size;
+  };
+  std::vector<std::vector<uint8_t>> buffers;
+  auto sink = [&](const uint8_t *buf, size_t size) {
+    buffers.push_back(std::vector<uint8_t>(buf, buf + size));
+    return true;
+  };
+  TEST_EQ(parser.ParseJsonStream(reader, sink), true);
+  TEST_EQ(buffers.size(), 3);
+  const int as[] = { 1, 2, 3 };
+  const char *ss[] = { "one", nullptr, "three" };
+  for (size_t i = 0; i < buffers.size(); i++) {
+    auto &buf = buffers[i];
+    TEST_EQ(flatbuffers::ReadScalar<flatbuffers::uoffset_t>(buf.data()) +
+                sizeof(flatbuffers::uoffset_t),
+            buf.size());
+    auto root = flatbuffers::GetSizePrefixedRoot<flatbuffers::Table>(
+        buf.data());
+    TEST_EQ(root->GetField<int32_t>(flatbuffers::FieldIndexToOffset(0), 0),
+            as[i]);
+    auto s = root->GetPointer<const flatbuffers::String *>(
+        flatbuffers::FieldIndexToOffset(1));
+    TEST_EQ_STR(s ? s->c_str() : "", ss[i] ? ss[i] : "");
+  }
+
+  // Errors name the line they are on.
+  stream = "{ a: 1 }\n\n{ a: 2, b: 3 }\n{ a: 4 }\n";
+  read_pos = 0;
+  buffers.clear();
+  TEST_EQ(parser.ParseJsonStream(reader, sink, "stream.json"), false);
+  TEST_EQ(buffers.size(), 1);
+  TEST_EQ(parser.error_.find(":3: ") != std::string::npos, true);
+  TEST_EQ(parser.error_.find("unknown field: b") != std::string::npos, true);
+
+  // A byte order mark is skipped on the first line only.
+  stream = "\xEF\xBB\xBF{ a: 5 }\n{ a: 6 }\n";
+  read_pos = 0;
+  buffers.clear();
+  TEST_EQ(parser.ParseJsonStream(reader, sink), true);
+  TEST_EQ(buffers.size(), 2);
+  stream = "{ a: 5 }\n\xEF\xBB\xBF{ a: 6 }\n";
+  read_pos = 0;
+  buffers.clear();
+  TEST_EQ(parser.ParseJsonStream(reader, sink), false);
+  TEST_EQ(buffers.size(), 1);
+
+  // The sink can stop the stream.
+  read_pos = 0;
+  buffers.clear();
+  auto stop = [&](const uint8_t *, size_t) { return false; };
+  TEST_EQ(parser.ParseJsonStream(reader, stop), false);
+  TEST_EQ(buffers.size(), 0);
+}
+
+void SymbolTableIndexTest() {
+  flatbuffers::SymbolTable<flatbuffers::Value> table;
+  for (int i = 0; i < 1000; i++) {
+    table.Add("symbol" + flatbuffers::NumToString(i), new flatbuffers::Value());
+  }
+  table.BuildIndex();
+  for (int i = 0; i < 1000; i++) {
+    auto name = "symbol" + flatbuffers::NumToString(i);
+    TEST_EQ(table.Lookup(name), table.vec[static_cast<size_t>(i)]);
+    TEST_EQ(table.Lookup(name.c_str(), name.length()),
+            table.vec[static_cast<size_t>(i)]);
+  }
+  TEST_ASSERT(table.Lookup("symbol") == nullptr);
+  TEST_ASSERT(table.Lookup("symbol1000") == nullptr);
+  TEST_ASSERT(table.Lookup("symbol12", 6) == nullptr);
+  TEST_ASSERT(table.Lookup("") == nullptr);
+  // Adding a symbol drops the index.
+  table.Add("late", new flatbuffers::Value());
+  TEST_EQ(table.Lookup("late"), table.vec.back());
+  TEST_EQ(table.Lookup("symbol12", 7), table.vec[1]);
+
+  // The parser indexes the fields of tables and values of enums.
+  std::string schema = "enum E:ulong (bit_flags) {";
+  for (int i = 0; i < 64; i++) {
+    schema += " e" + flatbuffers::NumToString(i) + ",";
+  }
+  schema += " }\ntable T {";
+  for (int i = 0; i < 300; i++) {
+    schema += " f" + flatbuffers::NumToString(i) + ":short;";
+  }
+  schema += " e:E; }\nroot_type T;";
+  flatbuffers::Parser parser;
+  TEST_EQ(parser.Parse(schema.c_str()), true);
+  TEST_EQ(parser.Parse("{ f0: 1, f299: 2, f150: 3, e: \"e0 e63 e31\" }"),
+          true);
+  auto root = flatbuffers::GetRoot<flatbuffers::Table>(
+      parser.builder_.GetBufferPointer());
+  TEST_EQ(root->GetField<int16_t>(flatbuffers::FieldIndexToOffset(0), 0), 1);
+  TEST_EQ(root->GetField<int16_t>(flatbuffers::FieldIndexToOffset(299), 0), 2);
+  TEST_EQ(root->GetField<int16_t>(flatbuffers::FieldIndexToOffset(150), 0), 3);
+  TEST_EQ(root->GetField<uint64_t>(flatbuffers::FieldIndexToOffset(300), 0),
+          0x8000000080000001ULL);
+  TEST_EQ(parser.Parse("{ f300: 1 }"), false);
+  TEST_EQ(parser.Parse("{ e: \"e0 e64\" }"), false);
+  TEST_EQ(parser.error_.find("unknown enum value: e64") != std::string::npos,
+          true);
+}
+
+// Values equal to their field's default aren't stored, also when the schema
+// was deserialized rather than parsed.
+void ScalarDefaultsTest() {
+  const char *schema =
+      "enum E:short { A, B }\n"
+      "table T { a:byte = -3; b:ulong = 18446744073709551615; c:float = 0.1;\n"
+      "          d:double = -2.5; e:bool = true; f:E = B; }\n"
+      "root_type T;";
+  const char *defaults =
+      "{ a: -3, b: 18446744073709551615, c: 0.1, d: -2.5, e: true, f: B }";
+  flatbuffers::Parser parsed;
+  TEST_EQ(parsed.Parse(schema), true);
+  parsed.Serialize();
+  flatbuffers::Parser deserialized;
+  TEST_EQ(deserialized.Deserialize(parsed.builder_.GetBufferPointer(),
+                                   parsed.builder_.GetSize()),
+          true);
+  flatbuffers::Parser *parsers[] = { &parsed, &deserialized };
+  for (size_t i = 0; i < 2; i++) {
+    auto &parser = *parsers[i];
+    TEST_EQ(parser.Parse(defaults), true);
+    auto root = flatbuffers::GetRoot<flatbuffers::Table>(
+        parser.builder_.GetBufferPointer());
+    for (flatbuffers::voffset_t field = 0; field < 6; field++) {
+      TEST_EQ(root->CheckField(flatbuffers::FieldIndexToOffset(field)),
+              false);
+    }
+    TEST_EQ(parser.Parse("{ a: -2, b: 1, c: 0.2, d: 2.5, e: false, f: A }"),
+            true);
+    root = flatbuffers::GetRoot<flatbuffers::Table>(
+        parser.builder_.GetBufferPointer());
+    TEST_EQ(root->GetField<int8_t>(flatbuffers::FieldIndexToOffset(0), 0), -2);
+    TEST_EQ(root->GetField<uint64_t>(flatbuffers::FieldIndexToOffset(1), 0),
+            1U);
+    TEST_EQ(root->GetField<float>(flatbuffers::FieldIndexToOffset(2), 0),
+            0.2f);
+    TEST_EQ(root->GetField<double>(flatbuffers::FieldIndexToOffset(3), 0),
+            2.5);
+    TEST_EQ(root->GetField<uint8_t>(flatbuffers::FieldIndexToOffset(4), 1),
+            0);
+    TEST_EQ(root->GetField<int16_t>(flatbuffers::FieldIndexToOffset(5), 1),
+            0);
+  }
+}
+
 void ValidFloatTest() {
   // check rounding to infinity
   TEST_EQ(TestValue<float>("{ Y:+3.4029e+38 }", "float"), +infinityf);
@@ -2007,6 +2657,46 @@ void NumericUtilsTest() {
   NumericUtilsTestFloat<float>("-1.7977e+308", "+1.7977e+308");
 }
 
+template<typename T> void AppendNumToStringTestValue(T t) {
+  std::string s = "x";
+  flatbuffers::AppendNumToString(t, &s);
+  TEST_EQ_STR(s.c_str(), ("x" + flatbuffers::NumToString(t)).c_str());
+}
+
+// AppendNumToString must print exactly what NumToString does.
+void AppendNumToStringTest() {
+  const double doubles[] = { 0.0, -0.0, 1.0, -1.5, 0.1, 3.14159265358979,
+                             5e-13, -5e-13, 1.5e-12, 2.5e-12, 1e-300, 4.9e-324,
+                             1.8e7, 1e19, 1e300 };
+  for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+    AppendNumToStringTestValue(doubles[i]);
+    AppendNumToStringTestValue(static_cast<float>(doubles[i]));
+  }
+  AppendNumToStringTestValue(flatbuffers::numeric_limits<double>::infinity());
+  AppendNumToStringTestValue(flatbuffers::numeric_limits<int64_t>::lowest());
+  AppendNumToStringTestValue(flatbuffers::numeric_limits<uint64_t>::max());
+  AppendNumToStringTestValue(static_cast<int8_t>(-128));
+  AppendNumToStringTestValue(static_cast<uint8_t>(255));
+  lcg_reset();
+  for (int i = 0; i < 10000; i++) {
+    uint64_t bits = (static_cast<uint64_t>(lcg_rand()) << 32) | lcg_rand();
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    AppendNumToStringTestValue(d);
+    float f;
+    auto bits32 = static_cast<uint32_t>(bits);
+    memcpy(&f, &bits32, sizeof(f));
+    AppendNumToStringTestValue(f);
+    // Values with a few decimals, where rounding ties happen.
+    auto decimal = static_cast<double>(static_cast<int32_t>(lcg_rand())) /
+                   (1 << (lcg_rand() % 30));
+    AppendNumToStringTestValue(decimal);
+    AppendNumToStringTestValue(static_cast<float>(decimal));
+    AppendNumToStringTestValue(static_cast<int64_t>(bits));
+    AppendNumToStringTestValue(static_cast<int16_t>(bits));
+  }
+}
+
 void IsAsciiUtilsTest() {
   char c = -128;
   for (int cnt = 0; cnt < 256; cnt++) {
@@ -2633,6 +3323,205 @@ void FlexBuffersTest() {
   TEST_EQ_STR(jsontest, jsonback.c_str());
 }
 
+void FlexBuffersSortedKeysTest() {
+  // Maps with keys in order, out of order, and out of order only in a
+  // nested map, must all come out sorted.
+  const char *orders[] = { "abcdef", "fedcba", "acbdfe" };
+  std::string expected;
+  flexbuffers::Builder slb(512, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+  for (int o = 0; o < 3; o++) {
+    slb.Clear();
+    slb.Map([&]() {
+      for (auto c = orders[o]; *c; c++) {
+        std::string key(1, *c);
+        if (*c == 'c') {
+          slb.Map(key.c_str(), [&]() {
+            for (auto d = orders[2 - o]; *d; d++) {
+              slb.String(std::string(1, *d).c_str(), "shared");
+            }
+          });
+        } else if (*c == 'e') {
+          slb.Vector(key.c_str(), [&]() {
+            slb.Key("z");
+            slb.Key("y");
+          });
+        } else {
+          slb.String(key.c_str(), "shared");
+        }
+      }
+    });
+    slb.Finish();
+    auto map = flexbuffers::GetRoot(slb.GetBuffer()).AsMap();
+    auto keys = map.Keys();
+    for (size_t i = 1; i < keys.size(); i++) {
+      TEST_ASSERT(strcmp(keys[i - 1].AsKey(), keys[i].AsKey()) < 0);
+    }
+    TEST_EQ_STR(map["c"].AsMap()["d"].AsString().c_str(), "shared");
+    TEST_EQ_STR(map["f"].AsString().c_str(), "shared");
+    // Shared strings point to the same data.
+    TEST_EQ(map["a"].AsString().c_str(), map["f"].AsString().c_str());
+    auto text = flexbuffers::GetRoot(slb.GetBuffer()).ToString();
+    if (o) {
+      TEST_EQ_STR(text.c_str(), expected.c_str());
+    } else {
+      expected = text;
+    }
+  }
+}
+
+void FlexBuffersMapIndexTest() {
+  std::vector<uint8_t> buffers[2];
+  for (int indexed = 0; indexed < 2; indexed++) {
+    flexbuffers::Builder slb(
+        512, indexed ? static_cast<flexbuffers::BuilderFlag>(
+                           flexbuffers::BUILDER_FLAG_SHARE_KEYS |
+                           flexbuffers::BUILDER_FLAG_INDEX_MAPS)
+                     : flexbuffers::BUILDER_FLAG_SHARE_KEYS);
+    slb.Map([&]() {
+      for (int i = 0; i < 300; i++) {
+        slb.Int(("key" + flatbuffers::NumToString(i)).c_str(), i);
+      }
+      slb.Double("pi", 3.14159);
+      slb.Map("small", [&]() {
+        slb.Int("a", 1);
+        slb.Int("b", 2);
+      });
+    });
+    slb.Finish();
+    buffers[indexed] = slb.GetBuffer();
+  }
+
+  auto plain = flexbuffers::GetRoot(buffers[0]).AsMap();
+  auto map = flexbuffers::GetRoot(buffers[1]).AsMap();
+  TEST_EQ(plain.HasKeyIndex(), false);
+  TEST_EQ(map.HasKeyIndex(), true);
+  TEST_EQ(map.KeyIndex().size(), 1024);
+  // Small maps don't get an index.
+  TEST_EQ(map["small"].AsMap().HasKeyIndex(), false);
+  TEST_EQ(map["small"].AsMap()["b"].AsInt32(), 2);
+  // Readers that don't use the index see the same map.
+  TEST_EQ(map.Keys().size(), plain.Keys().size());
+  TEST_EQ_STR(flexbuffers::GetRoot(buffers[1]).ToString().c_str(),
+              flexbuffers::GetRoot(buffers[0]).ToString().c_str());
+
+  for (int i = 0; i < 300; i++) {
+    auto key = "key" + flatbuffers::NumToString(i);
+    TEST_EQ(map[key].AsInt32(), i);
+    TEST_EQ(map.Find(key.c_str(), flexbuffers::HashKey(key.c_str())).AsInt32(),
+            i);
+    // Without an index, the hash is ignored.
+    TEST_EQ(plain.Find(key.c_str(), 0).AsInt32(), i);
+  }
+  TEST_EQ(map["pi"].AsDouble(), 3.14159);
+  TEST_EQ(map["key300"].IsNull(), true);
+  TEST_EQ(map[""].IsNull(), true);
+  TEST_EQ(map.Find("key1", 12345).IsNull(), true);
+  TEST_EQ(plain["key300"].IsNull(), true);
+}
+
+void FlexBuffersVerifierTest() {
+  flexbuffers::Builder slb(
+      512, static_cast<flexbuffers::BuilderFlag>(
+               flexbuffers::BUILDER_FLAG_SHARE_ALL |
+               flexbuffers::BUILDER_FLAG_INDEX_MAPS));
+  slb.Map([&]() {
+    slb.Vector("vec", [&]() {
+      slb += -100;
+      slb += "Fred";
+      slb.IndirectFloat(4.0f);
+      uint8_t blob[] = { 77 };
+      slb.Blob(blob, 1);
+      slb += false;
+    });
+    int ints[] = { 1, 2, 3 };
+    slb.Vector("bar", ints, 3);
+    slb.FixedTypedVector("bar3", ints, 3);
+    bool bools[] = { true, false, true, false };
+    slb.Vector("bools", bools, 4);
+    slb.IndirectInt("big", 1LL << 40);
+    slb.Map("indexed", [&]() {
+      for (int i = 0; i < 20; i++) {
+        slb.String(("key" + flatbuffers::NumToString(i)).c_str(), "Fred");
+      }
+    });
+  });
+  slb.Finish();
+  auto buf = slb.GetBuffer();
+  TEST_EQ(flexbuffers::VerifyBuffer(buf), true);
+  TEST_EQ(flexbuffers::GetRoot(buf).AsMap()["indexed"].AsMap().HasKeyIndex(),
+          true);
+
+  // Whatever a corrupt buffer verifies as, it must be safe to read.
+  size_t rejected = 0;
+  for (size_t i = 0; i < buf.size(); i++) {
+    const uint8_t values[] = { 0, 1, 0x7F, 0xFF };
+    for (size_t v = 0; v < sizeof(values); v++) {
+      auto corrupt = buf;
+      corrupt[i] = values[v];
+      if (flexbuffers::VerifyBuffer(corrupt)) {
+        flexbuffers::GetRoot(corrupt).ToString();
+      } else {
+        rejected++;
+      }
+    }
+  }
+  TEST_ASSERT(rejected > 0);
+  for (size_t len = 0; len < buf.size(); len++) {
+    if (flexbuffers::VerifyBuffer(flatbuffers::vector_data(buf), len)) {
+      flexbuffers::GetRoot(flatbuffers::vector_data(buf), len).ToString();
+    }
+  }
+
+  // A vector containing itself.
+  const uint8_t cycle[] = {
+    0, 2 /*size*/, 0 /*int*/, 1 /*offset to itself*/, 4 /*int type*/,
+    40 /*vector type*/, 4 /*root offset*/, 40 /*root type*/, 1 /*width*/
+  };
+  TEST_EQ(flexbuffers::VerifyBuffer(cycle, sizeof(cycle)), false);
+
+  // A vector referring 100 times to the same vector of 1 int: each reference
+  // counts towards the limit on elements, unless reuse is tracked.
+  std::vector<uint8_t> shared = { 1 /*size*/, 7 /*int*/, 4 /*int type*/ };
+  const size_t num_refs = 100;
+  shared.push_back(static_cast<uint8_t>(num_refs));
+  for (size_t i = 0; i < num_refs; i++) {
+    shared.push_back(static_cast<uint8_t>(shared.size() - 1));
+  }
+  shared.insert(shared.end(), num_refs, 40 /*vector type*/);
+  shared.push_back(static_cast<uint8_t>(shared.size() - 4));
+  shared.push_back(40);
+  shared.push_back(1);
+  TEST_EQ(flexbuffers::VerifyBuffer(shared), false);
+  flexbuffers::Verifier verifier(flatbuffers::vector_data(shared), shared.size(),
+                                 64, 200);
+  TEST_EQ(verifier.VerifyBuffer(), false);
+  verifier.SetTrackReuse(true);
+  TEST_EQ(verifier.VerifyBuffer(), true);
+  TEST_EQ(flexbuffers::GetRoot(shared).AsVector()[num_refs - 1]
+              .AsVector()[0].AsInt32(),
+          7);
+
+  // FlexBuffers in FlatBuffers fields are verified along with their table.
+  flatbuffers::FlatBufferBuilder fbb;
+  auto name = fbb.CreateString("flex");
+  auto flex = fbb.CreateVector(buf);
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_flex(flex);
+  FinishMonsterBuffer(fbb, mb.Finish());
+  flatbuffers::Verifier fb_verifier(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(fb_verifier), true);
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+    auto monster = GetMutableMonster(fbb.GetBufferPointer());
+    monster->mutable_flex()->Mutate(buf.size() - 1, 3);  // Root byte width.
+    flatbuffers::Verifier corrupt_verifier(fbb.GetBufferPointer(),
+                                           fbb.GetSize());
+    TEST_EQ(VerifyMonsterBuffer(corrupt_verifier), false);
+  #endif
+  // clang-format on
+}
+
 void TypeAliasesTest() {
   flatbuffers::FlatBufferBuilder builder;
 
@@ -2787,7 +3676,7 @@ void CreateSharedStringTest() {
   TEST_EQ(a[5]->str(), (std::string(chars_c, sizeof(chars_c))));
   TEST_EQ(a[6]->str(), (std::string(chars_b, sizeof(chars_b))));
 
-  // Make sure String::operator< works, too, since it is related to StringOffsetCompare.
+  // Make sure String::operator< works, too.
   TEST_EQ((*a[0]) < (*a[1]), true);
   TEST_EQ((*a[1]) < (*a[0]), false);
   TEST_EQ((*a[1]) < (*a[2]), false);
@@ -2798,6 +3687,396 @@ void CreateSharedStringTest() {
   TEST_EQ((*a[6]) < (*a[5]), true);
 }
 
+// Allocator that keeps track of how many bytes are currently allocated.
+class CountingAllocator : public flatbuffers::DefaultAllocator {
+ public:
+  CountingAllocator() : allocations(0), bytes_in_use(0) {}
+
+  uint8_t *allocate(size_t size) FLATBUFFERS_OVERRIDE {
+    allocations++;
+    bytes_in_use += size;
+    return DefaultAllocator::allocate(size);
+  }
+
+  void deallocate(uint8_t *p, size_t size) FLATBUFFERS_OVERRIDE {
+    bytes_in_use -= size;
+    DefaultAllocator::deallocate(p, size);
+  }
+
+  size_t allocations;
+  size_t bytes_in_use;
+};
+
+void SharedStringPoolTest() {
+  CountingAllocator allocator;
+  {
+    flatbuffers::FlatBufferBuilder builder;
+    builder.SetIndexAllocator(&allocator);
+    std::vector<flatbuffers::Offset<flatbuffers::String>> first;
+    for (int i = 0; i < 1000; i++) {
+      first.push_back(builder.CreateSharedString(
+          flatbuffers::NumToString(i % 100)));
+    }
+    for (int i = 100; i < 1000; i++) TEST_EQ(first[i].o, first[i % 100].o);
+    TEST_EQ(allocator.allocations, 3U);  // 64 -> 128 -> 256 slots.
+    auto in_use = allocator.bytes_in_use;
+    TEST_EQ(in_use > 0, true);
+
+    // The pool keeps its storage across Clear() and Reset().
+    builder.Clear();
+    auto a = builder.CreateSharedString("a");
+    builder.Reset();
+    auto b = builder.CreateSharedString("b");
+    auto b2 = builder.CreateSharedString("b");
+    TEST_EQ(a.o, b.o);
+    TEST_EQ(b.o, b2.o);
+    TEST_EQ(allocator.allocations, 3U);
+    TEST_EQ(allocator.bytes_in_use, in_use);
+
+    // Moving to the default allocator hands the storage back.
+    builder.SetIndexAllocator(nullptr);
+    TEST_EQ(allocator.bytes_in_use, 0U);
+    builder.SetIndexAllocator(&allocator);
+    TEST_EQ(allocator.bytes_in_use, in_use);
+    TEST_EQ(builder.CreateSharedString("b").o, b.o);
+  }
+  TEST_EQ(allocator.bytes_in_use, 0U);
+}
+
+void SerializedSizeBoundTest(uint8_t *flatbuf) {
+  auto monster = UnPackMonster(flatbuf);
+  // Make sure the bound accounts for out-of-line data at every level.
+  for (int i = 0; i < 100; i++) {
+    monster->testarrayofstring.push_back(std::string(i, 'x'));
+    monster->testarrayoftables.emplace_back(new MonsterT());
+    monster->testarrayoftables.back()->name = flatbuffers::NumToString(i);
+  }
+  auto bound = monster->SerializedSizeBound();
+
+  CountingAllocator allocator;
+  flatbuffers::FlatBufferBuilder fbb(1024, &allocator);
+  fbb.Reserve(bound);
+  TEST_EQ(allocator.allocations, 1U);
+  fbb.Finish(CreateMonster(fbb, monster.get()), MonsterIdentifier());
+  // Packed without growing the buffer.
+  TEST_EQ(allocator.allocations, 1U);
+  TEST_EQ(fbb.GetSize() <= bound + 32, true);
+
+  flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  auto root = GetMonster(fbb.GetBufferPointer());
+  auto strings = root->testarrayofstring();
+  TEST_EQ(strings->size(), monster->testarrayofstring.size());
+  TEST_EQ(strings->Get(strings->size() - 1)->size(), 99U);
+}
+
+void ExternalVectorTest() {
+  flatbuffers::FlatBufferBuilder nested_fbb;
+  nested_fbb.Finish(CreateMonster(nested_fbb, 0, 0, 0,
+                                  nested_fbb.CreateString("nested")));
+  std::vector<uint8_t> inventory(100000);
+  for (size_t i = 0; i < inventory.size(); i++) {
+    inventory[i] = static_cast<uint8_t>(i);
+  }
+
+  flatbuffers::FlatBufferBuilder fbb;
+  auto name = fbb.CreateString("external");
+  auto inv = fbb.CreateExternalVector(flatbuffers::data(inventory),
+                                      inventory.size());
+  auto nested = fbb.CreateExternalVector(
+      nested_fbb.GetBufferPointer(), nested_fbb.GetSize(),
+      nested_fbb.GetBufferMinAlignment());
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_inventory(inv);
+  mb.add_testnestedflatbuffer(nested);
+  FinishMonsterBuffer(fbb, mb.Finish());
+
+  std::vector<flatbuffers::BufferSegment> segments;
+  fbb.GetBufferSegments(&segments);
+  // The external data is referenced, not copied.
+  TEST_EQ(segments.size(), 5U);
+  TEST_EQ(segments[1].data, nested_fbb.GetBufferPointer());
+  TEST_EQ(segments[3].data, flatbuffers::data(inventory));
+  std::string buf;
+  for (auto it = segments.begin(); it != segments.end(); ++it) {
+    buf.append(reinterpret_cast<const char *>(it->data), it->size);
+  }
+  TEST_EQ(buf.size(), fbb.GetSize());
+
+  flatbuffers::Verifier verifier(
+      reinterpret_cast<const uint8_t *>(buf.data()), buf.size());
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  auto monster = GetMonster(buf.data());
+  TEST_EQ_STR(monster->name()->c_str(), "external");
+  TEST_EQ(monster->inventory()->size(), inventory.size());
+  TEST_EQ(memcmp(monster->inventory()->data(), flatbuffers::data(inventory),
+                 inventory.size()),
+          0);
+  TEST_EQ_STR(monster->testnestedflatbuffer_nested_root()->name()->c_str(),
+              "nested");
+}
+
+void VerifyVectorOfStringsTest() {
+  // Enough strings to be verified in several batches plus some leftovers,
+  // with the last string the furthest one into the buffer.
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<flatbuffers::String>> strings;
+  for (int i = 0; i < 37; i++) {
+    strings.insert(strings.begin(),
+                   fbb.CreateString(std::string(i % 7, 'a' + (i % 26))));
+  }
+  auto name = fbb.CreateString("strings");
+  auto vec = fbb.CreateVector(strings);
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayofstring(vec);
+  FinishMonsterBuffer(fbb, mb.Finish());
+
+  for (int check_alignment = 0; check_alignment < 2; check_alignment++) {
+    flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize(), 64,
+                                   1000000, check_alignment != 0);
+    TEST_EQ(VerifyMonsterBuffer(verifier), true);
+    TEST_EQ(verifier.GetComputedSize(), fbb.GetSize());
+  }
+  TEST_EQ(GetMonster(fbb.GetBufferPointer())->testarrayofstring()->size(), 37U);
+}
+
+void ParallelVerifierTest() {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<Monster>> monsters;
+  for (int i = 0; i < 1000; i++) {
+    auto name = fbb.CreateString(flatbuffers::NumToString(i));
+    auto inventory = fbb.CreateVector(std::vector<uint8_t>(i % 10, 1));
+    monsters.push_back(CreateMonster(fbb, 0, 0, 0, name, inventory));
+  }
+  auto name = fbb.CreateString("parallel");
+  auto tables = fbb.CreateVector(monsters);
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayoftables(tables);
+  FinishMonsterBuffer(fbb, mb.Finish());
+
+  // Runs tasks on a few threads, each taking every num_threads'th task.
+  size_t num_calls = 0;
+  size_t num_tasks = 0;
+  auto parallel_for = [&](size_t tasks,
+                          const std::function<void(size_t)> &task) {
+    num_calls++;
+    num_tasks += tasks;
+    const size_t num_threads = 4;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; t++) {
+      threads.push_back(std::thread([=, &task]() {
+        for (auto i = t; i < tasks; i += num_threads) task(i);
+      }));
+    }
+    for (auto it = threads.begin(); it != threads.end(); ++it) it->join();
+  };
+
+  flatbuffers::Verifier serial(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(serial), true);
+  flatbuffers::Verifier parallel(fbb.GetBufferPointer(), fbb.GetSize());
+  parallel.SetParallelFor(parallel_for, 64);
+  TEST_EQ(VerifyMonsterBuffer(parallel), true);
+  TEST_EQ(num_calls, 1U);
+  TEST_EQ(num_tasks, 1000U / 64);
+  TEST_EQ(parallel.GetComputedSize(), serial.GetComputedSize());
+
+  // Vectors too small to be split are verified serially.
+  flatbuffers::Verifier small(fbb.GetBufferPointer(), fbb.GetSize());
+  small.SetParallelFor(parallel_for, 600);
+  TEST_EQ(VerifyMonsterBuffer(small), true);
+  TEST_EQ(num_calls, 1U);
+}
+
+void LazyVerifierTest() {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<Monster>> monsters;
+  for (int i = 0; i < 3; i++) {
+    auto name = fbb.CreateString(flatbuffers::NumToString(i));
+    monsters.push_back(CreateMonster(fbb, 0, 0, 0, name));
+  }
+  auto enemy = CreateMonster(fbb, 0, 0, 0, fbb.CreateString("enemy"));
+  auto name = fbb.CreateString("lazy");
+  auto tables = fbb.CreateVector(monsters);
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayoftables(tables);
+  mb.add_enemy(enemy);
+  FinishMonsterBuffer(fbb, mb.Finish());
+
+  // Corrupt the vtable offset of the last table in the vector, which a lazy
+  // verifier won't notice as long as that table isn't accessed.
+  auto buf = fbb.GetBufferPointer();
+  auto corrupt = GetMonster(buf)->testarrayoftables()->Get(2);
+  flatbuffers::WriteScalar(const_cast<Monster *>(corrupt),
+                           flatbuffers::soffset_t(0x7FFFFFFF));
+
+  // Allow for 4 tables only: each table is verified once, however often it is
+  // accessed.
+  flatbuffers::Verifier verifier(buf, fbb.GetSize(), 64, 4);
+  verifier.SetLazy(true);
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  auto monster = GetMonster(buf);
+  TEST_EQ_STR(monster->name()->c_str(), "lazy");
+  for (int pass = 0; pass < 2; pass++) {
+    auto verified_enemy = verifier.Verified(monster->enemy());
+    TEST_NOTNULL(verified_enemy);
+    TEST_EQ_STR(verified_enemy->name()->c_str(), "enemy");
+    for (flatbuffers::uoffset_t i = 0; i < 2; i++) {
+      auto table = verifier.Verified(monster->testarrayoftables()->Get(i));
+      TEST_NOTNULL(table);
+      TEST_EQ_STR(table->name()->c_str(), flatbuffers::NumToString(i).c_str());
+    }
+    TEST_EQ(verifier.Verified(monster->testempty()) == nullptr, true);
+  }
+
+  // Tables outside the buffer, or misaligned, are rejected without touching
+  // the bitmap of verified tables.
+  std::vector<uint8_t> padded(buf, buf + fbb.GetSize());
+  padded.resize(padded.size() + 1024, 0);
+  flatbuffers::Verifier padded_verifier(padded.data(), fbb.GetSize());
+  padded_verifier.SetLazy(true);
+  TEST_EQ(VerifyMonsterBuffer(padded_verifier), true);
+  auto outside =
+      reinterpret_cast<const Monster *>(padded.data() + padded.size() - 8);
+  TEST_EQ(padded_verifier.Verified(outside) == nullptr, true);
+  auto padded_enemy = GetMonster(padded.data())->enemy();
+  TEST_NOTNULL(padded_verifier.Verified(padded_enemy));
+  auto misaligned = reinterpret_cast<const Monster *>(
+      reinterpret_cast<const uint8_t *>(padded_enemy) + 1);
+  TEST_EQ(padded_verifier.Verified(misaligned) == nullptr, true);
+
+  // clang-format off
+  #ifndef FLATBUFFERS_DEBUG_VERIFICATION_FAILURE
+    // Offsets of tables in vectors are still checked when verifying lazily.
+    // This fails a check, which would assert.
+    auto vec = GetMonster(padded.data())->testarrayoftables();
+    flatbuffers::WriteScalar(
+        const_cast<uint8_t *>(vec->Data()) + sizeof(flatbuffers::uoffset_t),
+        static_cast<flatbuffers::uoffset_t>(0x10000000));
+    flatbuffers::Verifier bad_offset_verifier(padded.data(), fbb.GetSize());
+    bad_offset_verifier.SetLazy(true);
+    TEST_EQ(VerifyMonsterBuffer(bad_offset_verifier), false);
+  #endif
+  // clang-format on
+}
+
+// Builds tables with many distinct layouts, optionally toggling the vtable
+// hash index halfway through.
+flatbuffers::DetachedBuffer CreateManyLayoutsBuffer(bool index_vtables,
+                                                    bool toggle) {
+  flatbuffers::FlatBufferBuilder builder;
+  builder.IndexVtables(index_vtables);
+  std::vector<flatbuffers::Offset<void>> tables;
+  for (int i = 0; i < 600; i++) {
+    if (toggle && i == 300) builder.IndexVtables(!index_vtables);
+    // Layouts repeat every 200 tables, so 2/3 of the vtables get deduped.
+    auto layout = i % 200;
+    auto start = builder.StartTable();
+    for (flatbuffers::voffset_t field = 0; field < 8; field++) {
+      if (layout & (1 << field)) {
+        builder.AddElement<uint8_t>(flatbuffers::FieldIndexToOffset(field),
+                                    static_cast<uint8_t>(i), 0);
+      }
+    }
+    builder.AddElement<int32_t>(flatbuffers::FieldIndexToOffset(8), i, 0);
+    tables.push_back(builder.EndTable(start));
+  }
+  builder.Finish(builder.CreateVector(tables));
+  return builder.Release();
+}
+
+void IndexedVtablesTest() {
+  auto scanned = CreateManyLayoutsBuffer(false, false);
+  auto indexed = CreateManyLayoutsBuffer(true, false);
+  auto toggled_on = CreateManyLayoutsBuffer(false, true);
+  auto toggled_off = CreateManyLayoutsBuffer(true, true);
+  // The hash index must find exactly the vtables the linear scan finds.
+  TEST_EQ(indexed.size(), scanned.size());
+  TEST_EQ(memcmp(indexed.data(), scanned.data(), scanned.size()), 0);
+  TEST_EQ(toggled_on.size(), scanned.size());
+  TEST_EQ(memcmp(toggled_on.data(), scanned.data(), scanned.size()), 0);
+  TEST_EQ(toggled_off.size(), scanned.size());
+  TEST_EQ(memcmp(toggled_off.data(), scanned.data(), scanned.size()), 0);
+
+  auto tables = flatbuffers::GetRoot<
+      flatbuffers::Vector<flatbuffers::Offset<flatbuffers::Table>>>(
+      indexed.data());
+  TEST_EQ(tables->size(), 600U);
+  std::set<const uint8_t *> vtables;
+  for (flatbuffers::uoffset_t i = 0; i < tables->size(); i++) {
+    TEST_EQ(tables->Get(i)->GetField<int32_t>(
+                flatbuffers::FieldIndexToOffset(8), 0),
+            static_cast<int32_t>(i));
+    vtables.insert(tables->Get(i)->GetVTable());
+  }
+  // Vtables are shared between tables with equal layouts.
+  TEST_EQ(vtables.size() >= 200 && vtables.size() < 600, true);
+}
+
+void ArenaAllocatorTest() {
+  flatbuffers::ArenaAllocator arena;
+  TEST_EQ(arena.GetSizeHint(), 1024U);
+  const uint8_t *first = nullptr;
+  size_t cached = 0;
+  for (int i = 0; i < 3; i++) {
+    flatbuffers::FlatBufferBuilder builder(arena.GetSizeHint(), &arena);
+    builder.Finish(builder.CreateVector(std::vector<int32_t>(1000, i)));
+    auto buf = builder.Release();
+    TEST_EQ(flatbuffers::GetRoot<flatbuffers::Vector<int32_t>>(buf.data())
+                ->Get(999),
+            i);
+    // The buffer grew the first time, after which the size hint lets every
+    // builder reuse the same slab without growing.
+    TEST_EQ(arena.GetSizeHint(), 8192U);
+    if (i == 1) {
+      first = buf.data();
+      cached = arena.GetCachedBytes();
+    }
+    if (i > 1) {
+      TEST_EQ(buf.data(), first);
+      TEST_EQ(arena.GetCachedBytes(), cached);
+    }
+  }
+  cached += 8192;
+  TEST_EQ(arena.GetCachedBytes(), cached);
+
+  // Buffers may be released on another thread.
+  flatbuffers::DetachedBuffer buf;
+  {
+    flatbuffers::FlatBufferBuilder builder(arena.GetSizeHint(), &arena);
+    builder.Finish(builder.CreateString("remote"));
+    buf = builder.Release();
+  }
+  TEST_EQ(arena.GetCachedBytes(), cached - 8192);
+  std::thread([&buf]() { buf = flatbuffers::DetachedBuffer(); }).join();
+  TEST_EQ(arena.GetCachedBytes(), cached - 8192);
+  // The owning thread picks the slab up again on its next allocation.
+  flatbuffers::FlatBufferBuilder builder(arena.GetSizeHint(), &arena);
+  builder.Finish(builder.CreateString("local"));
+  TEST_EQ(arena.GetCachedBytes(), cached - 8192);
+
+  arena.Trim();
+  TEST_EQ(arena.GetCachedBytes(), 0U);
+
+  // The thread local arena outlives its thread, and is picked up by the next
+  // thread asking for one.
+  std::thread([&buf]() {
+    auto &local = flatbuffers::ArenaAllocator::ThreadLocal();
+    flatbuffers::FlatBufferBuilder fbb(local.GetSizeHint(), &local);
+    fbb.Finish(fbb.CreateString("thread"));
+    buf = fbb.Release();
+  }).join();
+  TEST_EQ_STR(flatbuffers::GetRoot<flatbuffers::String>(buf.data())->c_str(),
+              "thread");
+  auto &local = flatbuffers::ArenaAllocator::ThreadLocal();
+  TEST_EQ(local.GetCachedBytes(), 0U);
+  buf = flatbuffers::DetachedBuffer();
+  TEST_EQ(local.GetCachedBytes(), 1024U);
+}
+
 void FixedLengthArrayTest() {
   // VS10 does not support typed enums, exclude from tests
 #if !defined(_MSC_VER) || _MSC_VER >= 1700
@@ -2893,6 +4172,81 @@ void NativeTypeTest() {
   }
 }
 
+// Packs an object tree, and checks it matches the buffer it was unpacked from.
+static bool NativeArenaRepacks(const NativeArenaTest::NodeT &node,
+                               const flatbuffers::FlatBufferBuilder &expected) {
+  flatbuffers::FlatBufferBuilder fbb;
+  fbb.Finish(NativeArenaTest::Node::Pack(fbb, &node));
+  return fbb.GetSize() == expected.GetSize() &&
+         !memcmp(fbb.GetBufferPointer(), expected.GetBufferPointer(),
+                 fbb.GetSize());
+}
+
+void NativeArenaObjectTest() {
+  using namespace NativeArenaTest;
+
+  // Build a tree on the heap, as usual.
+  NodeT src;
+  src.name = "root";
+  src.kind = Kind_Branch;
+  src.tags.push_back("a");
+  src.tags.push_back("a string too long for the small string optimization");
+  src.flags.push_back(true);
+  src.flags.push_back(false);
+  src.kinds.push_back(Kind_Leaf);
+  src.position.reset(new Point(1, 2));
+  src.path.push_back(Point(3, 4));
+  for (int i = 0; i < 2; i++) {
+    src.leaves.emplace_back(new LeafT());
+    src.leaves.back()->name = "leaf";
+    src.leaves.back()->values.assign(3, i);
+    src.children.emplace_back(new NodeT());
+    src.children.back()->name = "child";
+  }
+  src.payload.Set(LeafT());
+  src.children.back()->payload.Set(NodeT());
+  TEST_ASSERT(src.name.get_allocator().arena() == nullptr);
+
+  flatbuffers::FlatBufferBuilder fbb;
+  fbb.Finish(Node::Pack(fbb, &src));
+  auto buf = fbb.GetBufferPointer();
+
+  // Unpack the same tree into an arena.
+  flatbuffers::NativeArena arena(64);
+  auto root = UnPackNode(buf, arena);
+  TEST_ASSERT(NativeArenaRepacks(*root, fbb));
+  TEST_ASSERT(root->name.get_allocator().arena() == &arena);
+  TEST_ASSERT(root->tags[1].get_allocator().arena() == &arena);
+  TEST_ASSERT(root->leaves[1]->values.get_allocator().arena() == &arena);
+  auto grandchild = root->children[1]->payload.AsNode();
+  TEST_ASSERT(grandchild->name.get_allocator().arena() == &arena);
+  auto used = arena.GetBytesUsed();
+  TEST_ASSERT(used > sizeof(NodeT));
+
+  // Outside of a scope, objects are allocated from the heap again.
+  TEST_ASSERT(flatbuffers::NativeArena::Current() == nullptr);
+  flatbuffers::unique_ptr<NodeT> heap(GetNode(buf)->UnPack());
+  TEST_ASSERT(heap->name.get_allocator().arena() == nullptr);
+  TEST_EQ(arena.GetBytesUsed(), used);
+
+  // Freeing the tree in one go, and unpacking another one reuses the memory.
+  arena.Reset();
+  TEST_EQ(arena.GetBytesUsed(), 0);
+  root = GetNode(buf)->UnPack(arena);
+  TEST_EQ(arena.GetBytesUsed(), used);
+  TEST_ASSERT(NativeArenaRepacks(*root, fbb));
+
+  // Objects in the arena may still be deleted, which runs their destructors.
+  NodeT *node;
+  {
+    flatbuffers::NativeArena::Scope scope(arena);
+    node = new NodeT();
+  }
+  GetNode(buf)->UnPackTo(arena, node);
+  TEST_ASSERT(NativeArenaRepacks(*node, fbb));
+  delete node;
+}
+
 void FixedLengthArrayJsonTest(bool binary) {  
   // VS10 does not support typed enums, exclude from tests
 #if !defined(_MSC_VER) || _MSC_VER >= 1700
@@ -2979,6 +4333,13 @@ int FlatBufferTests() {
   MutateFlatBuffersTest(flatbuf.data(), flatbuf.size());
 
   ObjectFlatBuffersTest(flatbuf.data());
+  UnPackToReuseTest(flatbuf.data());
+  UnPackVectorTest();
+  SerializedSizeBoundTest(flatbuf.data());
+  ExternalVectorTest();
+  VerifyVectorOfStringsTest();
+  ParallelVerifierTest();
+  LazyVerifierTest();
 
   MiniReflectFlatBuffersTest(flatbuf.data());
 
@@ -2991,9 +4352,13 @@ int FlatBufferTests() {
     #endif
     ParseAndGenerateTextTest(false);
     ParseAndGenerateTextTest(true);
+    RegistryTest();
+    JsonPrinterTest();
     FixedLengthArrayJsonTest(false);
     FixedLengthArrayJsonTest(true);
     ReflectionTest(flatbuf.data(), flatbuf.size());
+    ResizeBatchTest(flatbuf.data(), flatbuf.size());
+    TableCopierTest(flatbuf.data());
     ParseProtoTest();
     UnionVectorTest();
     LoadVerifyBinaryTest();
@@ -3012,6 +4377,9 @@ int FlatBufferTests() {
   EnumOutOfRangeTest();
   IntegerOutOfRangeTest();
   IntegerBoundaryTest();
+  ScalarDefaultsTest();
+  SymbolTableIndexTest();
+  JsonStreamTest();
   UnicodeTest();
   UnicodeTestAllowNonUTF8();
   UnicodeTestGenerateTextFailsOnNonUTF8();
@@ -3026,18 +4394,26 @@ int FlatBufferTests() {
   TypeAliasesTest();
   EndianSwapTest();
   CreateSharedStringTest();
+  SharedStringPoolTest();
+  IndexedVtablesTest();
+  ArenaAllocatorTest();
   JsonDefaultTest();
   JsonEnumsTest();
   FlexBuffersTest();
+  FlexBuffersSortedKeysTest();
+  FlexBuffersMapIndexTest();
+  FlexBuffersVerifierTest();
   UninitializedVectorTest();
   EqualOperatorTest();
   NumericUtilsTest();
+  AppendNumToStringTest();
   IsAsciiUtilsTest();
   ValidFloatTest();
   InvalidFloatTest();
   TestMonsterExtraFloats();
   FixedLengthArrayTest();
   NativeTypeTest();
+  NativeArenaObjectTest();
   return 0;
 }
 
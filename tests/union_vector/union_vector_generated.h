@@ -96,7 +96,9 @@ struct CharacterUnion {
   void Reset();
 
   static void *UnPack(const void *obj, Character type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
+  size_t SerializedSizeBound() const;
 
   AttackerT *AsMuLan() {
     return type == Character_MuLan ?
@@ -264,6 +266,7 @@ struct AttackerT : public flatbuffers::NativeTable {
   AttackerT()
       : sword_attack_damage(0) {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const AttackerT &lhs, const AttackerT &rhs) {
@@ -334,6 +337,7 @@ struct MovieT : public flatbuffers::NativeTable {
   std::vector<CharacterUnion> characters;
   MovieT() {
   }
+  size_t SerializedSizeBound() const;
 };
 
 inline bool operator==(const MovieT &lhs, const MovieT &rhs) {
@@ -502,6 +506,11 @@ inline flatbuffers::Offset<Attacker> CreateAttacker(flatbuffers::FlatBufferBuild
       _sword_attack_damage);
 }
 
+inline size_t AttackerT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(1, 8);
+  return _size;
+}
+
 inline MovieT *Movie::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
   auto _o = new MovieT();
   UnPackTo(_o, _resolver);
@@ -511,10 +520,10 @@ inline MovieT *Movie::UnPack(const flatbuffers::resolver_function_t *_resolver)
 inline void Movie::UnPackTo(MovieT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = main_character_type(); _o->main_character.type = _e; };
-  { auto _e = main_character(); if (_e) _o->main_character.value = CharacterUnion::UnPack(_e, main_character_type(), _resolver); };
-  { auto _e = characters_type(); if (_e) { _o->characters.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->characters[_i].type = static_cast<Character>(_e->Get(_i)); } } };
-  { auto _e = characters(); if (_e) { _o->characters.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->characters[_i].value = CharacterUnion::UnPack(_e->Get(_i), characters_type()->GetEnum<Character>(_i), _resolver); } } };
+  { auto _e = main_character_type(); if (_o->main_character.type != _e) _o->main_character.Reset(); _o->main_character.type = _e; };
+  { auto _e = main_character(); if (_e) { _o->main_character.UnPackTo(_e, _resolver); } else { _o->main_character.Reset(); } };
+  { auto _e = characters_type(); if (_e) { { _o->characters.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if (_o->characters[_i].type != static_cast<Character>(_e->Get(_i))) _o->characters[_i].Reset(); _o->characters[_i].type = static_cast<Character>(_e->Get(_i)); } } } else { _o->characters.clear(); } };
+  { auto _e = characters(); if (_e) { { _o->characters.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->characters[_i].UnPackTo(_e->Get(_i), _resolver); } } } else { _o->characters.clear(); } };
 }
 
 inline flatbuffers::Offset<Movie> Movie::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MovieT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -537,6 +546,17 @@ inline flatbuffers::Offset<Movie> CreateMovie(flatbuffers::FlatBufferBuilder &_f
       _characters);
 }
 
+inline size_t MovieT::SerializedSizeBound() const {
+  auto _size = flatbuffers::FlatBufferBuilder::TableSizeBound(4, 26);
+  _size += main_character.SerializedSizeBound();
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(characters.size(), 1, 1);
+  _size += flatbuffers::FlatBufferBuilder::VectorSizeBound(characters.size(), 4, 4);
+  for (size_t _i = 0; _i < characters.size(); _i++) {
+    _size += characters[_i].SerializedSizeBound();
+  }
+  return _size;
+}
+
 inline bool VerifyCharacter(flatbuffers::Verifier &verifier, const void *obj, Character type) {
   switch (type) {
     case Character_NONE: {
@@ -609,6 +629,48 @@ inline void *CharacterUnion::UnPack(const void *obj, Character type, const flatb
   }
 }
 
+inline void CharacterUnion::UnPackTo(const void *obj, const flatbuffers::resolver_function_t *resolver) {
+  switch (type) {
+    case Character_MuLan: {
+      auto ptr = reinterpret_cast<const Attacker *>(obj);
+      auto _o = reinterpret_cast<AttackerT *>(value);
+      if (_o) ptr->UnPackTo(_o, resolver); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case Character_Rapunzel: {
+      auto ptr = reinterpret_cast<const Rapunzel *>(obj);
+      auto _o = reinterpret_cast<Rapunzel *>(value);
+      if (_o) *_o = *ptr; else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case Character_Belle: {
+      auto ptr = reinterpret_cast<const BookReader *>(obj);
+      auto _o = reinterpret_cast<BookReader *>(value);
+      if (_o) *_o = *ptr; else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case Character_BookFan: {
+      auto ptr = reinterpret_cast<const BookReader *>(obj);
+      auto _o = reinterpret_cast<BookReader *>(value);
+      if (_o) *_o = *ptr; else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case Character_Other: {
+      auto ptr = reinterpret_cast<const flatbuffers::String *>(obj);
+      auto _o = reinterpret_cast<std::string *>(value);
+      if (_o) _o->assign(ptr->c_str(), ptr->size()); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    case Character_Unused: {
+      auto ptr = reinterpret_cast<const flatbuffers::String *>(obj);
+      auto _o = reinterpret_cast<std::string *>(value);
+      if (_o) _o->assign(ptr->c_str(), ptr->size()); else value = UnPack(obj, type, resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> CharacterUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   switch (type) {
     case Character_MuLan: {
@@ -639,6 +701,33 @@ inline flatbuffers::Offset<void> CharacterUnion::Pack(flatbuffers::FlatBufferBui
   }
 }
 
+inline size_t CharacterUnion::SerializedSizeBound() const {
+  switch (type) {
+    case Character_MuLan: {
+      auto ptr = reinterpret_cast<const AttackerT *>(value);
+      return ptr->SerializedSizeBound();
+    }
+    case Character_Rapunzel: {
+      return 8;
+    }
+    case Character_Belle: {
+      return 8;
+    }
+    case Character_BookFan: {
+      return 8;
+    }
+    case Character_Other: {
+      auto ptr = reinterpret_cast<const std::string *>(value);
+      return flatbuffers::FlatBufferBuilder::StringSizeBound(ptr->size());
+    }
+    case Character_Unused: {
+      auto ptr = reinterpret_cast<const std::string *>(value);
+      return flatbuffers::FlatBufferBuilder::StringSizeBound(ptr->size());
+    }
+    default: return 0;
+  }
+}
+
 inline CharacterUnion::CharacterUnion(const CharacterUnion &u) FLATBUFFERS_NOEXCEPT : type(u.type), value(nullptr) {
   switch (type) {
     case Character_MuLan: {
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2020 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Tests of the Verifier built with FLATBUFFERS_VERIFIER_DIAGNOSTICS, which
+// changes its layout, so they live in a test binary of their own. flattests
+// covers the Verifier without it.
+
+#ifndef FLATBUFFERS_VERIFIER_DIAGNOSTICS
+#  error "Build with FLATBUFFERS_VERIFIER_DIAGNOSTICS defined."
+#endif
+
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/minireflect.h"
+#include "flatbuffers/util.h"
+
+// clang-format off
+#ifdef FLATBUFFERS_CPP98_STL
+  #include "flatbuffers/stl_emulation.h"
+  namespace std {
+    using flatbuffers::unique_ptr;
+  }
+#endif
+// clang-format on
+
+#include "monster_test_generated.h"
+#include "test_assert.h"
+
+using namespace MyGame::Example;
+
+void VerifierDiagnosticsTest() {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<Monster>> monsters;
+  for (int i = 0; i < 3; i++) {
+    auto name = fbb.CreateString(flatbuffers::NumToString(i));
+    monsters.push_back(CreateMonster(fbb, 0, 0, 0, name));
+  }
+  auto enemy = CreateMonster(fbb, 0, 0, 0, fbb.CreateString("enemy"));
+  auto inner_name = fbb.CreateString("inner");
+  MonsterBuilder inner(fbb);
+  inner.add_name(inner_name);
+  inner.add_enemy(enemy);
+  auto test = inner.Finish().Union();
+  auto name = fbb.CreateString("diagnostics");
+  auto tables = fbb.CreateVector(monsters);
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayoftables(tables);
+  mb.add_test_type(Any_Monster);
+  mb.add_test(test);
+  FinishMonsterBuffer(fbb, mb.Finish());
+  auto buf = fbb.GetBufferPointer();
+  auto monster = GetMonster(buf);
+
+  flatbuffers::Verifier ok(buf, fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(ok), true);
+  TEST_EQ(ok.GetErrorRule() == nullptr, true);
+  TEST_EQ(ok.GetErrorPath().empty(), true);
+
+  // Point an offset to a table `delta` bytes further, which for odd values
+  // is caught by the alignment check (other failures would assert in this
+  // test).
+  auto shift = [&](const uint8_t *offset, uint32_t delta) {
+    auto p = const_cast<uint8_t *>(offset);
+    flatbuffers::WriteScalar(p, flatbuffers::ReadScalar<uint32_t>(p) + delta);
+    return static_cast<size_t>(p + flatbuffers::ReadScalar<uint32_t>(p) -
+                               buf);
+  };
+  auto inner_table =
+      reinterpret_cast<const flatbuffers::Table *>(monster->test_as_Monster());
+  auto enemy_offset = inner_table->GetAddressOf(Monster::VT_ENEMY);
+  auto offset = shift(enemy_offset, 1);
+  flatbuffers::Verifier in_union(buf, fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(in_union), false);
+  TEST_EQ_STR(in_union.GetErrorRule(), "misaligned");
+  TEST_EQ(in_union.GetErrorOffset(), offset);
+  TEST_EQ(in_union.GetErrorPath().size(), 3U);
+  TEST_EQ_STR(flatbuffers::VerifierErrorToString(in_union, buf,
+                                                 MonsterTypeTable()).c_str(),
+              ("test.enemy: misaligned at offset " +
+               flatbuffers::NumToString(offset)).c_str());
+  shift(enemy_offset, static_cast<uint32_t>(-1));
+
+  offset = shift(monster->testarrayoftables()->Data() +
+                     sizeof(flatbuffers::uoffset_t), 1);
+  flatbuffers::Verifier in_vector(buf, fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(in_vector), false);
+  TEST_EQ_STR(flatbuffers::VerifierErrorToString(in_vector, buf,
+                                                 MonsterTypeTable()).c_str(),
+              ("testarrayoftables[1]: misaligned at offset " +
+               flatbuffers::NumToString(offset)).c_str());
+
+  // Lazily verified tables have their path start at themselves.
+  flatbuffers::Verifier lazy(buf, fbb.GetSize());
+  lazy.SetLazy(true);
+  TEST_EQ(VerifyMonsterBuffer(lazy), true);
+  TEST_NOTNULL(lazy.Verified(monster->testarrayoftables()->Get(0)));
+  TEST_EQ(lazy.Verified(monster->testarrayoftables()->Get(1)) == nullptr,
+          true);
+  TEST_EQ_STR(flatbuffers::VerifierErrorToString(lazy, buf,
+                                                 MonsterTypeTable()).c_str(),
+              ("misaligned at offset " +
+               flatbuffers::NumToString(offset)).c_str());
+}
+
+int main(int /*argc*/, const char * /*argv*/ []) {
+  InitTestEngine();
+
+  VerifierDiagnosticsTest();
+
+  if (!testing_fails) {
+    TEST_OUTPUT_LINE("ALL TESTS PASSED");
+  } else {
+    TEST_OUTPUT_LINE("%d FAILED TESTS", testing_fails);
+  }
+  return CloseTestEngine();
+}